@@ -0,0 +1,96 @@
+#include <benchmark/benchmark.h>
+#include "DefaultEWrapper.h"
+#include "EDecoder.h"
+#include <string>
+#include <vector>
+
+namespace {
+
+// A wire message is a run of NUL-terminated fields (the 4-byte length prefix
+// is stripped by EReader before the decoder sees it).
+std::string encode_fields(const std::vector<std::string>& fields) {
+    std::string msg;
+    for (const auto& field : fields) {
+        msg.append(field);
+        msg.push_back('\0');
+    }
+    return msg;
+}
+
+std::vector<std::string> tick_price_stream() {
+    std::vector<std::string> stream;
+    const char* prices[] = {"150.01", "150.02", "300.5", "180.75", "0.0001", "4512.25"};
+    const char* sizes[] = {"100", "200", "50", "1250", "3", "1"};
+    for (int i = 0; i < 6; ++i) {
+        // msgId, version, tickerId, tickType (4 = LAST), price, size, attrMask
+        stream.push_back(encode_fields({"1", "6", std::to_string(2000 + i), "4", prices[i], sizes[i], "0"}));
+    }
+    return stream;
+}
+
+std::vector<std::string> order_status_stream() {
+    std::vector<std::string> stream;
+    const char* statuses[] = {"PreSubmitted", "Submitted", "Filled"};
+    for (int i = 0; i < 3; ++i) {
+        // msgId, orderId, status, filled, remaining, avgFillPrice, permId, parentId,
+        // lastFillPrice, clientId, whyHeld, mktCapPrice
+        stream.push_back(encode_fields({"3", std::to_string(17 + i), statuses[i], "50", "50",
+                                        "150.255", "1873458321", "0", "150.26", "1", "", "0"}));
+    }
+    return stream;
+}
+
+void run_decoder(benchmark::State& state, const std::vector<std::string>& stream) {
+    DefaultEWrapper wrapper;
+    EDecoder decoder(MAX_CLIENT_VER, &wrapper);
+    size_t next = 0;
+    size_t bytes = 0;
+    for (auto _ : state) {
+        const std::string& msg = stream[next];
+        const char* begin = msg.data();
+        benchmark::DoNotOptimize(decoder.parseAndProcessMsg(begin, msg.data() + msg.size()));
+        bytes += msg.size();
+        if (++next == stream.size()) next = 0;
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(static_cast<int64_t>(bytes));
+}
+
+// One buffer of NUL-terminated fields, decoded front to back with the same
+// static helpers the message handlers use.
+template <typename T>
+void run_fields(benchmark::State& state, const std::vector<std::string>& fields) {
+    const std::string buffer = encode_fields(fields);
+    const char* end = buffer.data() + buffer.size();
+    for (auto _ : state) {
+        const char* ptr = buffer.data();
+        T value{};
+        while (EDecoder::DecodeField(value, ptr, end)) {
+            benchmark::DoNotOptimize(value);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(fields.size()));
+}
+
+}
+
+static void BM_DecodeTickPrice(benchmark::State& state) {
+    run_decoder(state, tick_price_stream());
+}
+BENCHMARK(BM_DecodeTickPrice);
+
+static void BM_DecodeOrderStatus(benchmark::State& state) {
+    run_decoder(state, order_status_stream());
+}
+BENCHMARK(BM_DecodeOrderStatus);
+
+static void BM_DecodeFieldPrice(benchmark::State& state) {
+    run_fields<double>(state, {"150.01", "4512.25", "0.0001", "-1", "187.3325", "1.7976931348623157E308",
+                               "99.5", "12"});
+}
+BENCHMARK(BM_DecodeFieldPrice);
+
+static void BM_DecodeFieldInt(benchmark::State& state) {
+    run_fields<int>(state, {"1", "6", "2001", "4", "2147483647", "0", "1873458321", "-1"});
+}
+BENCHMARK(BM_DecodeFieldInt);
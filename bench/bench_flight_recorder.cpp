@@ -0,0 +1,34 @@
+#include <benchmark/benchmark.h>
+#include "FlightRecorder.hpp"
+#include <filesystem>
+
+using namespace TradingEngine;
+
+namespace {
+
+void enable_recorder() {
+    static const bool enabled =
+        FlightRecorder::enable((std::filesystem::temp_directory_path() / "engine_bench_flight").string(), 4096);
+    (void)enabled;
+}
+
+}
+
+// The cost every dequeued event pays while the recorder is on.
+static void BM_FlightRecorderRecord(benchmark::State& state) {
+    enable_recorder();
+    uint64_t i = 0;
+    for (auto _ : state) {
+        FlightRecorder::record(FlightKind::EVENT, 0, 1, i, i);
+        ++i;
+    }
+}
+BENCHMARK(BM_FlightRecorderRecord);
+
+static void BM_FlightRecorderRecordText(benchmark::State& state) {
+    enable_recorder();
+    for (auto _ : state) {
+        FlightRecorder::record_text(FlightKind::COMMAND, "CREATE_ORDER");
+    }
+}
+BENCHMARK(BM_FlightRecorderRecordText);
@@ -0,0 +1,61 @@
+#include <benchmark/benchmark.h>
+#include "OrderManager.hpp"
+#include <memory>
+#include <vector>
+
+using namespace TradingEngine;
+
+namespace {
+
+Order make_order(const std::string& symbol) {
+    Order order;
+    order.symbol = symbol;
+    order.side = Side::BUY;
+    order.order_type = OrderType::LIMIT;
+    order.quantity = Quantity::from_int(100);
+    order.price = Price::from_double(150.25);
+    return order;
+}
+
+}
+
+static void BM_AddNewOrder(benchmark::State& state) {
+    auto om = std::make_unique<OrderManager>();
+    Order order = make_order("AAPL");
+    int64_t added = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(om->add_new_order(order));
+        // Keep the order map at a realistic intraday size instead of growing forever.
+        if (++added % 100000 == 0) {
+            state.PauseTiming();
+            om = std::make_unique<OrderManager>();
+            state.ResumeTiming();
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_AddNewOrder);
+
+static void BM_UpdateOrderStatus(benchmark::State& state) {
+    const int64_t order_count = state.range(0);
+    OrderManager om;
+    std::vector<std::string> symbols = {"AAPL", "MSFT", "GOOG", "TSLA", "SPY"};
+    std::vector<uint64_t> ids;
+    for (int64_t i = 0; i < order_count; ++i) {
+        Order order = make_order(symbols[i % symbols.size()]);
+        ids.push_back(om.add_new_order(order));
+    }
+
+    ExecutionReport report;
+    report.new_status = OrderStatus::PARTIALLY_FILLED;
+    report.fill_quantity = Quantity::from_int(1);
+    report.fill_price = Price::from_double(150.30);
+    size_t next = 0;
+    for (auto _ : state) {
+        report.order_id = ids[next];
+        om.update_order_status(report);
+        if (++next == ids.size()) next = 0;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_UpdateOrderStatus)->Arg(100)->Arg(10000);
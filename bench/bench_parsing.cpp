@@ -0,0 +1,39 @@
+#include <benchmark/benchmark.h>
+#include "MockMarketDataHandler.hpp"
+#include "IBKRConverters.hpp"
+#include <string>
+#include <vector>
+
+using namespace TradingEngine;
+
+static void BM_ParseTickCsvLine(benchmark::State& state) {
+    const std::vector<std::string> lines = {
+        "AAPL,150.01,100", "MSFT,300.50,50", "GOOG,180.75,75", "TSLA,250.125,1200"
+    };
+    size_t next = 0;
+    for (auto _ : state) {
+        Tick tick;
+        benchmark::DoNotOptimize(MockMarketDataHandler::parse_tick_line(lines[next], tick));
+        benchmark::DoNotOptimize(tick);
+        if (++next == lines.size()) next = 0;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ParseTickCsvLine);
+
+static void BM_ConvertToIbkrOrder(benchmark::State& state) {
+    TradingEngine::Order order;
+    order.symbol = "AAPL";
+    order.side = Side::BUY;
+    order.order_type = OrderType::LIMIT;
+    order.quantity = Quantity::from_int(250);
+    order.price = Price::from_double(150.25);
+    for (auto _ : state) {
+        ::Order ibkr_order = convert_to_ibkr_order(order);
+        ::Contract contract = convert_to_ibkr_contract(order);
+        benchmark::DoNotOptimize(ibkr_order);
+        benchmark::DoNotOptimize(contract);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ConvertToIbkrOrder);
@@ -0,0 +1,156 @@
+#include <benchmark/benchmark.h>
+#include "ThreadSafeQueue.hpp"
+#include "LaneQueue.hpp"
+#include "Event.hpp"
+#include <atomic>
+#include <thread>
+
+using namespace TradingEngine;
+
+namespace {
+
+Event make_tick_event() {
+    Tick tick;
+    tick.symbol = "AAPL";
+    tick.price = Price::from_double(150.25);
+    tick.size = Quantity::from_int(100);
+    tick.timestamp = std::chrono::system_clock::now();
+    Event event;
+    event.type = EventType::TICK;
+    event.data = tick;
+    return event;
+}
+
+}
+
+// Uncontended round trip: the floor for any queue hop in the engine.
+static void BM_QueuePushPop(benchmark::State& state) {
+    ThreadSafeQueue<Event> queue;
+    Event event = make_tick_event();
+    for (auto _ : state) {
+        queue.push(event);
+        Event out;
+        queue.try_pop(out);
+        benchmark::DoNotOptimize(out);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_QueuePushPop);
+
+// Same round trip through the bounded lane queue the engine uses.
+static void BM_LaneQueuePushPop(benchmark::State& state) {
+    LaneQueue<Event, kEventLaneCount> queue;
+    Event event = make_tick_event();
+    for (auto _ : state) {
+        queue.push(static_cast<size_t>(EventLane::MARKET_DATA), event);
+        Event out;
+        queue.try_pop(out);
+        benchmark::DoNotOptimize(out);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_LaneQueuePushPop);
+
+// N producer threads push into one queue while a dedicated consumer drains it,
+// mirroring the gateway/command threads feeding the engine loop.
+static void BM_QueueContendedPush(benchmark::State& state) {
+    static ThreadSafeQueue<Event>* queue = nullptr;
+    static std::thread consumer;
+    static std::atomic<bool> stop{false};
+
+    if (state.thread_index() == 0) {
+        queue = new ThreadSafeQueue<Event>();
+        stop = false;
+        consumer = std::thread([] {
+            Event out;
+            while (!stop.load(std::memory_order_relaxed)) {
+                queue->wait_and_pop_for(out, std::chrono::milliseconds(1));
+            }
+            while (queue->try_pop(out)) {}
+        });
+    }
+
+    Event event = make_tick_event();
+    for (auto _ : state) {
+        queue->push(event);
+    }
+    state.SetItemsProcessed(state.iterations());
+
+    if (state.thread_index() == 0) {
+        stop = true;
+        consumer.join();
+        delete queue;
+        queue = nullptr;
+    }
+}
+BENCHMARK(BM_QueueContendedPush)->ThreadRange(1, 8)->UseRealTime();
+
+// Producer -> consumer handoff latency under load, measured by the consumer.
+static void BM_QueueHandoff(benchmark::State& state) {
+    ThreadSafeQueue<Event> queue;
+    std::atomic<bool> stop{false};
+    std::thread producer([&] {
+        Event event = make_tick_event();
+        while (!stop.load(std::memory_order_relaxed)) {
+            if (queue.size() < 1024) {
+                queue.push(event);
+            }
+        }
+    });
+    for (auto _ : state) {
+        Event out;
+        queue.wait_and_pop(out);
+        benchmark::DoNotOptimize(out);
+    }
+    stop = true;
+    producer.join();
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_QueueHandoff)->UseRealTime();
+
+// How long an order waits when it arrives behind a burst of Arg ticks: the
+// FIFO consumer pops the whole burst first, the lane queue pops the order next.
+static void BM_OrderBehindTickBurstFifo(benchmark::State& state) {
+    ThreadSafeQueue<Event> queue;
+    Event tick = make_tick_event();
+    Event order;
+    order.type = EventType::ORDER_REQUEST;
+    order.data = Order{};
+    for (auto _ : state) {
+        state.PauseTiming();
+        for (int64_t i = 0; i < state.range(0); ++i) {
+            queue.push(tick);
+        }
+        queue.push(order);
+        state.ResumeTiming();
+        Event out;
+        do {
+            queue.try_pop(out);
+        } while (out.type != EventType::ORDER_REQUEST);
+        benchmark::DoNotOptimize(out);
+    }
+}
+BENCHMARK(BM_OrderBehindTickBurstFifo)->Arg(1000)->Arg(5000);
+
+static void BM_OrderBehindTickBurstLanes(benchmark::State& state) {
+    LaneQueue<Event, kEventLaneCount> queue;
+    queue.configure({LaneConfig{}, LaneConfig{8192, OverflowPolicy::BLOCK}, LaneConfig{}});
+    Event tick = make_tick_event();
+    Event order;
+    order.type = EventType::ORDER_REQUEST;
+    order.data = Order{};
+    for (auto _ : state) {
+        state.PauseTiming();
+        while (queue.size(static_cast<size_t>(EventLane::MARKET_DATA)) < static_cast<size_t>(state.range(0))) {
+            queue.push(static_cast<size_t>(EventLane::MARKET_DATA), tick);
+        }
+        queue.push(static_cast<size_t>(EventLane::CONTROL), order);
+        state.ResumeTiming();
+        Event out;
+        do {
+            queue.try_pop(out);
+        } while (out.type != EventType::ORDER_REQUEST);
+        benchmark::DoNotOptimize(out);
+    }
+}
+BENCHMARK(BM_OrderBehindTickBurstLanes)->Arg(1000)->Arg(5000);
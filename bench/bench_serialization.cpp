@@ -0,0 +1,53 @@
+#include <benchmark/benchmark.h>
+#include "ScriptingInterface.hpp"
+#include "Tick.hpp"
+
+using namespace TradingEngine;
+
+// The JSON encoding done by publish_tick for every tick, excluding the socket send.
+static void BM_SerializeTick(benchmark::State& state) {
+    Tick tick;
+    tick.symbol = "AAPL";
+    tick.price = Price::from_double(150.25);
+    tick.size = Quantity::from_int(100);
+    tick.timestamp = std::chrono::system_clock::now();
+    size_t bytes = 0;
+    for (auto _ : state) {
+        std::string payload = ScriptingInterface::serialize_tick(tick);
+        bytes += payload.size();
+        benchmark::DoNotOptimize(payload);
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(static_cast<int64_t>(bytes));
+}
+BENCHMARK(BM_SerializeTick);
+
+// What publish_tick now costs for a symbol nobody subscribes to: the cached
+// subscription check that replaces the encoding above.
+static void BM_UnsubscribedTickCheck(benchmark::State& state) {
+    TopicSubscriptions subscriptions;
+    subscriptions.apply(std::string("\x01TICK.MSFT", 10));
+    SymbolId aapl = SymbolTable::instance().intern("AAPL");
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(subscriptions.has_subscriber(TopicFamily::TICK, aapl, "AAPL"));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_UnsubscribedTickCheck);
+
+// The last-value cache write publish_tick makes for every tick, subscribed or not.
+static void BM_RecordLastTick(benchmark::State& state) {
+    LastValueCache cache;
+    Tick tick;
+    tick.symbol = "AAPL";
+    tick.symbol_id = SymbolTable::instance().intern("AAPL");
+    tick.price = Price::from_double(150.25);
+    tick.size = Quantity::from_int(100);
+    tick.timestamp = std::chrono::system_clock::now();
+    for (auto _ : state) {
+        cache.record_tick(tick);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_RecordLastTick);
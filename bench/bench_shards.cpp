@@ -0,0 +1,56 @@
+#include <benchmark/benchmark.h>
+#include "EngineCore.hpp"
+#include "LogHandler.hpp"
+#include "OrderManager.hpp"
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace TradingEngine;
+
+namespace {
+
+constexpr int kReplayTicks = 100000;
+constexpr int kReplaySymbols = 256;
+
+std::vector<std::string> replay_symbols() {
+    std::vector<std::string> symbols;
+    for (int i = 0; i < kReplaySymbols; ++i) {
+        symbols.push_back("SYM" + std::to_string(i));
+        SymbolTable::instance().intern(symbols.back());
+    }
+    return symbols;
+}
+
+}
+
+// Replays ticks across many symbols through the whole event loop (routing,
+// handling, publish) and waits for every worker to drain. Nothing subscribes
+// to the data channel, so the ticks are not serialized; BM_SerializeTick
+// measures that separately. Arg = worker shards; 1 is the single-threaded loop.
+static void BM_ShardedReplay(benchmark::State& state) {
+    static const std::vector<std::string> symbols = replay_symbols();
+    spdlog::set_level(spdlog::level::warn);
+    for (auto _ : state) {
+        OrderManager order_manager;
+        EngineCore engine(order_manager, "inproc://bench-shards-pub", "inproc://bench-shards-sub");
+        engine.set_worker_count(static_cast<size_t>(state.range(0)));
+        std::thread loop([&engine] { engine.run(); });
+        for (int i = 0; i < kReplayTicks; ++i) {
+            Tick tick;
+            tick.symbol = symbols[i % kReplaySymbols];
+            tick.price = Price::from_double(100.0 + (i % 100) * 0.01);
+            tick.size = Quantity::from_int(100);
+            tick.timestamp = std::chrono::system_clock::now();
+            Event event;
+            event.type = EventType::TICK;
+            event.data = std::move(tick);
+            engine.post_event(std::move(event));
+        }
+        engine.stop();
+        loop.join();
+    }
+    state.SetItemsProcessed(state.iterations() * kReplayTicks);
+    spdlog::set_level(spdlog::level::info);
+}
+BENCHMARK(BM_ShardedReplay)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->Unit(benchmark::kMillisecond)->UseRealTime();
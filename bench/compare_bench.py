@@ -0,0 +1,119 @@
+#!/usr/bin/env python3
+"""Run engine_bench and compare its JSON output against a stored baseline.
+
+  compare_bench.py run [--bench build/engine_bench] [--out bench_results.json] [--baseline bench/baseline.json]
+  compare_bench.py compare BASELINE CURRENT [--threshold 0.10]
+  compare_bench.py save CURRENT [--baseline bench/baseline.json]
+
+`run` executes the benchmark binary with JSON output and, if a baseline
+exists, compares against it. `compare` exits non-zero when any benchmark got
+slower than the threshold, so it can gate CI.
+"""
+
+import argparse
+import json
+import os
+import shutil
+import subprocess
+import sys
+
+DEFAULT_BASELINE = os.path.join(os.path.dirname(os.path.abspath(__file__)), "baseline.json")
+
+
+def load_results(path):
+    with open(path) as f:
+        data = json.load(f)
+    results = {}
+    for bench in data.get("benchmarks", []):
+        # With repetitions, prefer the median aggregate; otherwise take the single run.
+        if bench.get("run_type") == "aggregate":
+            if bench.get("aggregate_name") != "median":
+                continue
+            name = bench["run_name"]
+        else:
+            name = bench["name"]
+            if name in results:
+                continue
+        results[name] = {
+            "time": bench["real_time"] if "real_time" in name else bench["cpu_time"],
+            "unit": bench.get("time_unit", "ns"),
+        }
+    return results
+
+
+def compare(baseline_path, current_path, threshold):
+    baseline = load_results(baseline_path)
+    current = load_results(current_path)
+    regressions = []
+    width = max((len(n) for n in current), default=10)
+    print(f"{'benchmark':<{width}}  {'baseline':>12}  {'current':>12}  {'change':>8}")
+    for name in sorted(current):
+        cur = current[name]
+        base = baseline.get(name)
+        if base is None:
+            print(f"{name:<{width}}  {'-':>12}  {cur['time']:>10.1f}{cur['unit']:>2}  {'new':>8}")
+            continue
+        change = (cur["time"] - base["time"]) / base["time"] if base["time"] else 0.0
+        flag = ""
+        if change > threshold:
+            flag = "  REGRESSION"
+            regressions.append(name)
+        elif change < -threshold:
+            flag = "  improved"
+        print(f"{name:<{width}}  {base['time']:>10.1f}{base['unit']:>2}  {cur['time']:>10.1f}{cur['unit']:>2}  {change:>+7.1%}{flag}")
+    for name in sorted(set(baseline) - set(current)):
+        print(f"{name:<{width}}  (missing from current run)")
+    if regressions:
+        print(f"\n{len(regressions)} regression(s) above {threshold:.0%}: {', '.join(regressions)}")
+        return 1
+    print(f"\nNo regressions above {threshold:.0%}.")
+    return 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    sub = parser.add_subparsers(dest="mode", required=True)
+
+    run_p = sub.add_parser("run", help="run engine_bench and compare against the baseline")
+    run_p.add_argument("--bench", default="build/engine_bench")
+    run_p.add_argument("--out", default="bench_results.json")
+    run_p.add_argument("--baseline", default=DEFAULT_BASELINE)
+    run_p.add_argument("--threshold", type=float, default=0.10)
+    run_p.add_argument("--repetitions", type=int, default=5)
+    run_p.add_argument("--filter", default="")
+
+    cmp_p = sub.add_parser("compare", help="compare two benchmark JSON files")
+    cmp_p.add_argument("baseline")
+    cmp_p.add_argument("current")
+    cmp_p.add_argument("--threshold", type=float, default=0.10)
+
+    save_p = sub.add_parser("save", help="store a run as the new baseline")
+    save_p.add_argument("current")
+    save_p.add_argument("--baseline", default=DEFAULT_BASELINE)
+
+    args = parser.parse_args()
+
+    if args.mode == "run":
+        cmd = [args.bench,
+               f"--benchmark_out={args.out}",
+               "--benchmark_out_format=json",
+               f"--benchmark_repetitions={args.repetitions}",
+               "--benchmark_report_aggregates_only=true"]
+        if args.filter:
+            cmd.append(f"--benchmark_filter={args.filter}")
+        subprocess.run(cmd, check=True)
+        if not os.path.exists(args.baseline):
+            print(f"\nNo baseline at {args.baseline}; store this run with: {sys.argv[0]} save {args.out}")
+            return 0
+        return compare(args.baseline, args.out, args.threshold)
+    if args.mode == "compare":
+        return compare(args.baseline, args.current, args.threshold)
+    if args.mode == "save":
+        shutil.copyfile(args.current, args.baseline)
+        print(f"Saved {args.current} as baseline {args.baseline}")
+        return 0
+    return 2
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,318 @@
+// End-to-end tick-to-trade harness.
+//
+// Runs the engine in mock mode in-process, replays synthetic ticks into it at a
+// fixed offered rate, and runs a loopback strategy client over the real ZMQ
+// data/command channels that answers every Nth tick with a CREATE_ORDER. A
+// simulated execution sink stands in for the gateway and timestamps each order
+// as it reaches the execution layer. The strategy echoes the tick timestamp as
+// the order's correlation_id, so every round trip is measured as
+//   tick injection (post_event) -> order arriving at the execution handler.
+//
+// Usage:
+//   tick_to_trade [--rates 1000,5000,20000] [--duration 5] [--answer-every 10]
+//                 [--symbols AAPL,MSFT,GOOG] [--pub tcp://127.0.0.1:15555]
+//                 [--sub tcp://127.0.0.1:15556] [--workers 1]
+
+#include "EngineCore.hpp"
+#include "OrderManager.hpp"
+#include "I_ExecutionHandler.hpp"
+#include "LogHandler.hpp"
+#include "Stats.hpp"
+#include <nlohmann/json.hpp>
+#include <zmq.hpp>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace TradingEngine;
+
+namespace {
+
+struct HarnessOptions {
+    std::vector<int> rates = {1000, 5000, 20000};
+    int duration_s = 5;
+    int answer_every = 10;
+    std::vector<std::string> symbols = {"AAPL", "MSFT", "GOOG", "TSLA", "SPY"};
+    std::string pub_endpoint = "tcp://127.0.0.1:15555";
+    std::string sub_endpoint = "tcp://127.0.0.1:15556";
+    int workers = 1;
+};
+
+std::vector<std::string> split(const std::string& s, char delim) {
+    std::vector<std::string> out;
+    std::stringstream ss(s);
+    std::string item;
+    while (std::getline(ss, item, delim)) {
+        if (!item.empty()) out.push_back(item);
+    }
+    return out;
+}
+
+int64_t system_now_ticks() {
+    return std::chrono::system_clock::now().time_since_epoch().count();
+}
+
+int64_t system_ticks_to_ns(int64_t ticks) {
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(system_clock::duration(ticks)).count();
+}
+
+// Stands in for the broker gateway. Runs on the engine thread (the shard
+// workers with --workers > 1).
+class SimulatedExecutionSink : public I_ExecutionHandler {
+public:
+    void place_order(Order& order) override {
+        int64_t now = system_now_ticks();
+        m_received.fetch_add(1, std::memory_order_relaxed);
+        if (order.correlation_id.empty()) {
+            return;
+        }
+        int64_t injected = std::strtoll(order.correlation_id.c_str(), nullptr, 10);
+        if (injected <= 0 || now < injected) {
+            return;
+        }
+        LatencyHistogram* hist = m_active.load(std::memory_order_acquire);
+        if (hist) {
+            hist->record(static_cast<uint64_t>(system_ticks_to_ns(now - injected)));
+        }
+    }
+
+    // Starts a fresh measurement window and returns the previous one.
+    std::unique_ptr<LatencyHistogram> swap_window() {
+        auto next = std::make_unique<LatencyHistogram>();
+        m_active.store(next.get(), std::memory_order_release);
+        // Let any in-flight record() on the old window finish.
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        std::swap(next, m_window);
+        return next;
+    }
+
+    uint64_t received() const { return m_received.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<LatencyHistogram*> m_active{nullptr};
+    std::unique_ptr<LatencyHistogram> m_window;
+    std::atomic<uint64_t> m_received{0};
+};
+
+// Loopback strategy: subscribes to all ticks and answers every Nth with a
+// market order whose correlation_id is the tick's timestamp.
+class LoopbackStrategy {
+public:
+    explicit LoopbackStrategy(const HarnessOptions& options)
+        : m_options(options),
+          m_context(1),
+          m_data(m_context, ZMQ_SUB),
+          m_commands(m_context, ZMQ_PUB) {}
+
+    void start() {
+        m_data.connect(m_options.pub_endpoint);
+        m_data.set(zmq::sockopt::subscribe, "TICK.");
+        m_commands.connect(m_options.sub_endpoint);
+        m_running = true;
+        m_thread = std::thread(&LoopbackStrategy::run, this);
+    }
+
+    void stop() {
+        m_running = false;
+        if (m_thread.joinable()) m_thread.join();
+    }
+
+    uint64_t ticks_seen() const { return m_ticks_seen.load(std::memory_order_relaxed); }
+    uint64_t orders_sent() const { return m_orders_sent.load(std::memory_order_relaxed); }
+
+private:
+    void run() {
+        zmq::pollitem_t items[] = {{static_cast<void*>(m_data), 0, ZMQ_POLLIN, 0}};
+        uint64_t n = 0;
+        while (m_running) {
+            zmq::poll(items, 1, std::chrono::milliseconds(50));
+            if (!(items[0].revents & ZMQ_POLLIN)) continue;
+
+            zmq::message_t topic_msg;
+            zmq::message_t payload_msg;
+            if (!m_data.recv(topic_msg, zmq::recv_flags::dontwait)) continue;
+            if (!m_data.recv(payload_msg, zmq::recv_flags::none)) continue;
+            m_ticks_seen.fetch_add(1, std::memory_order_relaxed);
+
+            if (n++ % static_cast<uint64_t>(m_options.answer_every) != 0) continue;
+
+            auto tick = nlohmann::json::parse(payload_msg.to_string(), nullptr, false);
+            if (tick.is_discarded()) continue;
+
+            nlohmann::json order;
+            order["correlation_id"] = tick.value("timestamp", "");
+            order["payload"]["symbol"] = tick["data"].value("symbol", "");
+            order["payload"]["side"] = "BUY";
+            order["payload"]["order_type"] = "MARKET";
+            order["payload"]["quantity"] = 1;
+            std::string body = order.dump();
+            static const std::string topic = "CREATE_ORDER";
+            m_commands.send(zmq::buffer(topic), zmq::send_flags::sndmore);
+            m_commands.send(zmq::buffer(body), zmq::send_flags::none);
+            m_orders_sent.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    const HarnessOptions& m_options;
+    zmq::context_t m_context;
+    zmq::socket_t m_data;
+    zmq::socket_t m_commands;
+    std::thread m_thread;
+    std::atomic<bool> m_running{false};
+    std::atomic<uint64_t> m_ticks_seen{0};
+    std::atomic<uint64_t> m_orders_sent{0};
+};
+
+void inject_tick(EngineCore& engine, const std::string& symbol, double price) {
+    Event event;
+    event.trace.stamp(LatencyStage::INGEST);
+    Tick tick;
+    tick.symbol = symbol;
+    tick.price = Price::from_double(price);
+    tick.size = Quantity::from_int(100);
+    tick.timestamp = std::chrono::system_clock::now();
+    event.type = EventType::TICK;
+    event.data = tick;
+    engine.post_event(std::move(event));
+}
+
+// Injects ticks on a fixed schedule. Returns the number injected.
+uint64_t replay(EngineCore& engine, const HarnessOptions& options, int rate, std::chrono::seconds duration) {
+    using clock = std::chrono::steady_clock;
+    const auto period = std::chrono::nanoseconds(1000000000LL / rate);
+    const auto start = clock::now();
+    const auto end = start + duration;
+    auto next = start;
+    uint64_t injected = 0;
+    double price = 100.0;
+    while (next < end) {
+        while (clock::now() < next) {
+            if (next - clock::now() > std::chrono::microseconds(200)) {
+                std::this_thread::sleep_for(std::chrono::microseconds(50));
+            }
+        }
+        const auto& symbol = options.symbols[injected % options.symbols.size()];
+        price += (injected % 2 ? 0.01 : -0.01);
+        inject_tick(engine, symbol, price);
+        ++injected;
+        next += period;
+    }
+    return injected;
+}
+
+bool parse_args(int argc, char* argv[], HarnessOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto next = [&]() -> std::string { return i + 1 < argc ? argv[++i] : ""; };
+        if (arg == "--rates") {
+            options.rates.clear();
+            for (const auto& r : split(next(), ',')) options.rates.push_back(std::stoi(r));
+        } else if (arg == "--duration") {
+            options.duration_s = std::stoi(next());
+        } else if (arg == "--answer-every") {
+            options.answer_every = std::max(1, std::stoi(next()));
+        } else if (arg == "--symbols") {
+            options.symbols = split(next(), ',');
+        } else if (arg == "--pub") {
+            options.pub_endpoint = next();
+        } else if (arg == "--sub") {
+            options.sub_endpoint = next();
+        } else if (arg == "--workers") {
+            options.workers = std::max(1, std::stoi(next()));
+        } else {
+            std::fprintf(stderr, "Unknown argument: %s\n", arg.c_str());
+            return false;
+        }
+    }
+    return !options.rates.empty() && !options.symbols.empty();
+}
+
+std::string bind_endpoint(const std::string& endpoint) {
+    // The engine binds, the client connects: tcp://127.0.0.1:N -> tcp://*:N
+    auto pos = endpoint.rfind(':');
+    if (endpoint.rfind("tcp://", 0) == 0 && pos != std::string::npos) {
+        return "tcp://*" + endpoint.substr(pos);
+    }
+    return endpoint;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    HarnessOptions options;
+    if (!parse_args(argc, argv, options)) {
+        std::fprintf(stderr, "usage: %s [--rates r1,r2,...] [--duration s] [--answer-every n] "
+                             "[--symbols A,B] [--pub endpoint] [--sub endpoint] [--workers n]\n", argv[0]);
+        return 1;
+    }
+
+    spdlog::set_level(spdlog::level::warn);
+    LatencyStats::set_enabled(true);
+
+    OrderManager order_manager;
+    EngineCore engine(order_manager, bind_endpoint(options.pub_endpoint), bind_endpoint(options.sub_endpoint));
+    engine.set_mode("mock");
+    engine.set_worker_count(static_cast<size_t>(options.workers));
+    SimulatedExecutionSink sink;
+    engine.set_execution_handler(&sink);
+    engine.set_stats_publish_interval(std::chrono::milliseconds(1000));
+    engine.startup();
+    std::thread engine_thread([&engine] { engine.run(); });
+
+    LoopbackStrategy strategy(options);
+    strategy.start();
+
+    // Handshake instead of sleeping past ZMQ's slow-joiner window: keep
+    // injecting until an answered order makes it all the way to the sink.
+    sink.swap_window();
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (sink.received() == 0 && std::chrono::steady_clock::now() < deadline) {
+        inject_tick(engine, options.symbols.front(), 100.0);
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    if (sink.received() == 0) {
+        std::fprintf(stderr, "Strategy loop never completed a round trip; check the endpoints.\n");
+        strategy.stop();
+        engine.stop();
+        engine_thread.join();
+        return 1;
+    }
+
+    std::printf("%10s %10s %10s %10s %10s %10s %10s %10s %10s %10s\n",
+                "offered/s", "achieved/s", "ticks", "orders", "received",
+                "p50_us", "p90_us", "p99_us", "p99.9_us", "max_us");
+    for (int rate : options.rates) {
+        uint64_t sent_before = strategy.orders_sent();
+        uint64_t received_before = sink.received();
+        sink.swap_window();
+
+        auto start = std::chrono::steady_clock::now();
+        uint64_t injected = replay(engine, options, rate, std::chrono::seconds(options.duration_s));
+        double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        // Drain whatever is still in flight before closing the window.
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+
+        auto window = sink.swap_window();
+        auto snap = window->snapshot();
+        auto us = [](uint64_t ns) { return static_cast<double>(ns) / 1000.0; };
+        std::printf("%10d %10.0f %10llu %10llu %10llu %10.1f %10.1f %10.1f %10.1f %10.1f\n",
+                    rate, injected / elapsed,
+                    static_cast<unsigned long long>(injected),
+                    static_cast<unsigned long long>(strategy.orders_sent() - sent_before),
+                    static_cast<unsigned long long>(sink.received() - received_before),
+                    us(snap.percentile(50.0)), us(snap.percentile(90.0)), us(snap.percentile(99.0)),
+                    us(snap.percentile(99.9)), us(snap.max));
+        std::fflush(stdout);
+    }
+
+    strategy.stop();
+    engine.stop();
+    engine_thread.join();
+    return 0;
+}
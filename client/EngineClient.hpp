@@ -0,0 +1,376 @@
+#pragma once
+
+#include "MessageView.hpp"
+#include <zmq.hpp>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <map>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace TradingEngine::Client {
+
+struct EngineClientConfig {
+    std::string data_endpoint = "tcp://localhost:5555";
+    std::string command_endpoint = "tcp://localhost:5556";
+    // Names this client's PONG topic and is the default SUBSCRIBE subscriber.
+    std::string client_id = "client";
+    std::chrono::milliseconds connect_timeout{5000};
+};
+
+// When one message arrived, was decoded and its callback returned, in
+// steady_clock ns. topic is only valid during the hook.
+struct MessageTiming {
+    std::string_view topic;
+    int64_t received_ns = 0;
+    int64_t decoded_ns = 0;
+    int64_t handled_ns = 0;
+};
+
+// A strategy's connection to the engine: the SUB side of the data channel and
+// the PUB side of the control channel, with typed callbacks for ticks, history
+// and execution reports.
+//
+// Messages are decoded in place: the views handed to a callback point into the
+// received ZMQ message and are only valid until the callback returns. Copy
+// whatever must outlive it. The client is not thread-safe; call everything
+// (except stop()) from the thread that runs poll() or run().
+class EngineClient {
+public:
+    using TickHandler = std::function<void(const TickView&)>;
+    using BarHandler = std::function<void(const BarView&)>;
+    // All bars of one REQUEST_HISTORY, delivered together once the engine
+    // publishes HISTORY_END.
+    using HistoryHandler = std::function<void(std::string_view symbol, const std::vector<BarView>&)>;
+    using ExecutionHandler = std::function<void(const ExecutionView&)>;
+    // Every other topic (STATS, ALERT, CONNECTION, TIMER.*, SESSION.*), raw.
+    using MessageHandler = std::function<void(std::string_view topic, std::string_view payload)>;
+    using TimingHook = std::function<void(const MessageTiming&)>;
+    using SendHook = std::function<void(std::string_view topic, int64_t sent_ns)>;
+
+    explicit EngineClient(EngineClientConfig config = EngineClientConfig())
+        : m_config(std::move(config)),
+          m_context(1),
+          m_data(m_context, ZMQ_SUB),
+          m_commands(m_context, ZMQ_PUB) {
+        m_data.set(zmq::sockopt::linger, 0);
+        m_commands.set(zmq::sockopt::linger, 0);
+    }
+
+    EngineClient(const EngineClient&) = delete;
+    EngineClient& operator=(const EngineClient&) = delete;
+
+    // Connects both channels and waits until the engine has answered a PING
+    // on the data channel, so commands sent afterwards are not lost to ZMQ's
+    // slow-joiner window and the PUB side is known to be delivering. Returns
+    // false if no PONG arrives within connect_timeout.
+    bool connect() {
+        const std::string pong_topic = "PONG." + m_config.client_id;
+        m_data.connect(m_config.data_endpoint);
+        m_data.set(zmq::sockopt::subscribe, pong_topic);
+        m_commands.connect(m_config.command_endpoint);
+
+        const uint64_t nonce = std::random_device{}();
+        JsonWriter ping;
+        ping.begin_object().field("client_id", m_config.client_id).field("nonce", nonce).end_object();
+
+        const auto deadline = std::chrono::steady_clock::now() + m_config.connect_timeout;
+        auto next_ping = std::chrono::steady_clock::now();
+        while (std::chrono::steady_clock::now() < deadline) {
+            if (std::chrono::steady_clock::now() >= next_ping) {
+                send_command("PING", ping.str());
+                next_ping += std::chrono::milliseconds(100);
+            }
+            zmq::pollitem_t item{static_cast<void*>(m_data), 0, ZMQ_POLLIN, 0};
+            zmq::poll(&item, 1, std::chrono::milliseconds(10));
+            if (!(item.revents & ZMQ_POLLIN)) {
+                continue;
+            }
+            zmq::message_t topic;
+            zmq::message_t payload;
+            if (!receive(topic, payload)) {
+                continue;
+            }
+            if (topic.to_string_view() == pong_topic &&
+                JsonView(payload.to_string_view()).unsigned_integer("nonce") == nonce) {
+                m_connected = true;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool connected() const { return m_connected; }
+    const EngineClientConfig& config() const { return m_config; }
+
+    void on_tick(TickHandler handler) { m_on_tick = std::move(handler); }
+    // Each HISTORY bar as it arrives; use on_history to get them as one batch.
+    void on_bar(BarHandler handler) { m_on_bar = std::move(handler); }
+    void on_history(HistoryHandler handler) { m_on_history = std::move(handler); }
+    void on_execution(ExecutionHandler handler) { m_on_execution = std::move(handler); }
+    void on_message(MessageHandler handler) { m_on_message = std::move(handler); }
+    void on_timing(TimingHook hook) { m_on_timing = std::move(hook); }
+    void on_send(SendHook hook) { m_on_send = std::move(hook); }
+
+    // Data channel subscriptions.
+
+    // ZMQ filters by prefix, so subscribing to "TICK.AA" would also deliver AAPL.
+    void subscribe(const std::string& topic) { m_data.set(zmq::sockopt::subscribe, topic); }
+    void unsubscribe(const std::string& topic) { m_data.set(zmq::sockopt::unsubscribe, topic); }
+
+    // Subscribes to the symbol's ticks and asks the engine to stream them.
+    // If the engine has seen a tick for the symbol, it is sent straight away
+    // with snapshot set, ahead of the live ticks.
+    void subscribe_ticks(const std::string& symbol) {
+        const std::string topic = "TICK." + symbol;
+        subscribe(topic);
+        JsonWriter writer;
+        writer.begin_object().field("topic", topic).field("subscriber", m_config.client_id).end_object();
+        send_command("SUBSCRIBE", writer.str());
+    }
+
+    void unsubscribe_ticks(const std::string& symbol) {
+        const std::string topic = "TICK." + symbol;
+        JsonWriter writer;
+        writer.begin_object().field("topic", topic).field("subscriber", m_config.client_id).end_object();
+        send_command("UNSUBSCRIBE", writer.str());
+        unsubscribe(topic);
+    }
+
+    // The strategy's working orders arrive first, one snapshot report each.
+    void subscribe_executions(const std::string& strategy_id) { subscribe("EXECUTION." + strategy_id + "."); }
+
+    // Commands.
+
+    void request_history(const std::string& symbol, const std::string& duration = "1 W",
+                         const std::string& bar_size = "1 day", const std::string& end_date = "") {
+        subscribe("HISTORY." + symbol);
+        subscribe("HISTORY_END." + symbol);
+        JsonWriter writer;
+        writer.begin_object()
+            .field("symbol", symbol)
+            .field("duration", duration)
+            .field("bar_size", bar_size)
+            .field("end_date", end_date)
+            .end_object();
+        send_command("REQUEST_HISTORY", writer.str());
+    }
+
+    void send_order(const OrderRequest& order) { send_command("CREATE_ORDER", encode_order(order)); }
+
+    // One message for the lot, so the orders reach the engine back to back.
+    void send_orders(const std::vector<OrderRequest>& orders) {
+        if (!orders.empty()) {
+            send_command("CREATE_ORDER_BATCH", encode_order_batch(orders));
+        }
+    }
+
+    void cancel_order(uint64_t order_id, const std::string& strategy_id = "") {
+        JsonWriter writer;
+        writer.begin_object().field("order_id", order_id);
+        if (!strategy_id.empty()) {
+            writer.field("strategy_id", strategy_id);
+        }
+        send_command("CANCEL_ORDER", writer.end_object().str());
+    }
+
+    // Empty arguments widen the scope; both empty cancels every open order.
+    void cancel_all(const std::string& symbol = "", const std::string& strategy_id = "") {
+        JsonWriter writer;
+        writer.begin_object();
+        if (!symbol.empty()) {
+            writer.field("symbol", symbol);
+        }
+        if (!strategy_id.empty()) {
+            writer.field("strategy_id", strategy_id);
+        }
+        send_command("CANCEL_ALL", writer.end_object().str());
+    }
+
+    // A zero quantity or limit price leaves that field unchanged.
+    void modify_order(uint64_t order_id, double quantity, double limit_price, const std::string& strategy_id = "") {
+        JsonWriter writer;
+        writer.begin_object().field("order_id", order_id);
+        if (!strategy_id.empty()) {
+            writer.field("strategy_id", strategy_id);
+        }
+        if (quantity > 0.0) {
+            writer.field("quantity", quantity);
+        }
+        if (limit_price > 0.0) {
+            writer.field("limit_price", limit_price);
+        }
+        send_command("MODIFY_ORDER", writer.end_object().str());
+    }
+
+    // Arms a timer that fires on TIMER.<strategy_id>; subscribe to it first.
+    void set_timer(const std::string& strategy_id, const std::string& name, int64_t delay_ms,
+                   int64_t interval_ms = 0) {
+        JsonWriter writer;
+        writer.begin_object()
+            .field("strategy_id", strategy_id)
+            .field("name", name)
+            .field("delay_ms", delay_ms)
+            .field("interval_ms", interval_ms)
+            .end_object();
+        send_command("TIMER", writer.str());
+    }
+
+    void cancel_timer(const std::string& strategy_id, const std::string& name) {
+        JsonWriter writer;
+        writer.begin_object().field("strategy_id", strategy_id).field("name", name).field("cancel", true).end_object();
+        send_command("TIMER", writer.str());
+    }
+
+    void send_command(std::string_view topic, std::string_view payload) {
+        m_commands.send(zmq::buffer(topic), zmq::send_flags::sndmore);
+        m_commands.send(zmq::buffer(payload), zmq::send_flags::none);
+        if (m_on_send) {
+            m_on_send(topic, now_ns());
+        }
+    }
+
+    // Dispatches every message that arrives within timeout (waiting at most
+    // that long for the first one). Returns the number dispatched.
+    size_t poll(std::chrono::milliseconds timeout = std::chrono::milliseconds(0)) {
+        zmq::pollitem_t item{static_cast<void*>(m_data), 0, ZMQ_POLLIN, 0};
+        zmq::poll(&item, 1, timeout);
+        if (!(item.revents & ZMQ_POLLIN)) {
+            return 0;
+        }
+        size_t count = 0;
+        zmq::message_t topic;
+        zmq::message_t payload;
+        while (receive(topic, payload, zmq::recv_flags::dontwait)) {
+            dispatch(topic, payload);
+            ++count;
+        }
+        return count;
+    }
+
+    // Polls until stop() is called (from a callback or another thread).
+    void run() {
+        m_running = true;
+        while (m_running.load(std::memory_order_relaxed)) {
+            poll(std::chrono::milliseconds(100));
+        }
+    }
+
+    void stop() { m_running = false; }
+
+private:
+    static int64_t now_ns() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+    }
+
+    static bool starts_with(std::string_view text, std::string_view prefix) {
+        return text.substr(0, prefix.size()) == prefix;
+    }
+
+    bool receive(zmq::message_t& topic, zmq::message_t& payload, zmq::recv_flags flags = zmq::recv_flags::none) {
+        if (!m_data.recv(topic, flags)) {
+            return false;
+        }
+        // The payload part follows its topic atomically.
+        if (!topic.more()) {
+            payload = zmq::message_t();
+            return true;
+        }
+        return m_data.recv(payload, zmq::recv_flags::none).has_value();
+    }
+
+    void dispatch(zmq::message_t& topic_msg, zmq::message_t& payload_msg) {
+        MessageTiming timing;
+        timing.received_ns = now_ns();
+        const std::string_view topic = topic_msg.to_string_view();
+        const std::string_view payload = payload_msg.to_string_view();
+        timing.topic = topic;
+
+        if (starts_with(topic, "TICK.") && m_on_tick) {
+            TickView tick;
+            bool ok = TickView::decode(payload, tick);
+            timing.decoded_ns = now_ns();
+            if (ok) {
+                m_on_tick(tick);
+            }
+        } else if (starts_with(topic, "EXECUTION.") && m_on_execution) {
+            ExecutionView execution;
+            bool ok = ExecutionView::decode(payload, execution);
+            timing.decoded_ns = now_ns();
+            if (ok) {
+                m_on_execution(execution);
+            }
+        } else if (starts_with(topic, "HISTORY.")) {
+            BarView bar;
+            bool ok = BarView::decode(payload, bar);
+            timing.decoded_ns = now_ns();
+            if (ok && m_on_bar) {
+                m_on_bar(bar);
+            }
+            if (ok && !bar.snapshot && m_on_history) {
+                // Keep the message itself so the batch can still point into it.
+                m_pending_history[std::string(bar.symbol)].push_back(std::move(payload_msg));
+            }
+        } else if (starts_with(topic, "HISTORY_END.")) {
+            timing.decoded_ns = now_ns();
+            flush_history(topic.substr(sizeof("HISTORY_END.") - 1));
+        } else if (starts_with(topic, "PONG.")) {
+            // Late answers to connect()'s PINGs.
+            return;
+        } else {
+            timing.decoded_ns = timing.received_ns;
+            if (m_on_message) {
+                m_on_message(topic, payload);
+            }
+        }
+        if (m_on_timing) {
+            timing.handled_ns = now_ns();
+            m_on_timing(timing);
+        }
+    }
+
+    void flush_history(std::string_view symbol) {
+        auto it = m_pending_history.find(std::string(symbol));
+        std::vector<zmq::message_t> messages;
+        if (it != m_pending_history.end()) {
+            messages = std::move(it->second);
+            m_pending_history.erase(it);
+        }
+        if (!m_on_history) {
+            return;
+        }
+        std::vector<BarView> bars;
+        bars.reserve(messages.size());
+        for (const auto& message : messages) {
+            BarView bar;
+            if (BarView::decode(message.to_string_view(), bar)) {
+                bars.push_back(bar);
+            }
+        }
+        m_on_history(symbol, bars);
+    }
+
+    EngineClientConfig m_config;
+    zmq::context_t m_context;
+    zmq::socket_t m_data;
+    zmq::socket_t m_commands;
+    bool m_connected = false;
+    std::atomic<bool> m_running{false};
+
+    TickHandler m_on_tick;
+    BarHandler m_on_bar;
+    HistoryHandler m_on_history;
+    ExecutionHandler m_on_execution;
+    MessageHandler m_on_message;
+    TimingHook m_on_timing;
+    SendHook m_on_send;
+
+    std::map<std::string, std::vector<zmq::message_t>> m_pending_history;
+};
+
+}
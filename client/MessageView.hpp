@@ -0,0 +1,379 @@
+#pragma once
+
+#include <charconv>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace TradingEngine::Client {
+
+// Read-only view of one JSON object as the engine publishes it. Lookups scan
+// the text in place: nothing is allocated or copied, and every string_view
+// returned points into the buffer the view was made from. Strings come back
+// exactly as sent, so escape sequences are not decoded (the engine's symbols,
+// ids and statuses never contain any).
+class JsonView {
+public:
+    JsonView() = default;
+    explicit JsonView(std::string_view text) : m_text(text) {}
+
+    bool valid() const { return !m_text.empty() && m_text.front() == '{'; }
+    std::string_view text() const { return m_text; }
+
+    // The raw text of a top-level member's value, or "" if there is none.
+    std::string_view raw(std::string_view key) const {
+        if (!valid()) {
+            return {};
+        }
+        size_t pos = 1;
+        while (true) {
+            pos = skip_space(pos);
+            if (pos >= m_text.size() || m_text[pos] != '"') {
+                return {};
+            }
+            size_t key_end = skip_string(pos);
+            std::string_view name = m_text.substr(pos + 1, key_end - pos - 2);
+            pos = skip_space(key_end);
+            if (pos >= m_text.size() || m_text[pos] != ':') {
+                return {};
+            }
+            pos = skip_space(pos + 1);
+            size_t value_end = skip_value(pos);
+            if (value_end == std::string_view::npos) {
+                return {};
+            }
+            if (name == key) {
+                return m_text.substr(pos, value_end - pos);
+            }
+            pos = skip_space(value_end);
+            if (pos >= m_text.size() || m_text[pos] != ',') {
+                return {};
+            }
+            ++pos;
+        }
+    }
+
+    bool has(std::string_view key) const { return !raw(key).empty(); }
+
+    JsonView object(std::string_view key) const { return JsonView(raw(key)); }
+
+    std::string_view string(std::string_view key) const {
+        std::string_view value = raw(key);
+        if (value.size() < 2 || value.front() != '"') {
+            return {};
+        }
+        return value.substr(1, value.size() - 2);
+    }
+
+    // Numbers may also arrive quoted (the engine sends timestamps as strings).
+    double number(std::string_view key, double fallback = 0.0) const {
+        std::string_view value = unquote(raw(key));
+        double out = fallback;
+        if (value.empty() || std::from_chars(value.data(), value.data() + value.size(), out).ec != std::errc()) {
+            return fallback;
+        }
+        return out;
+    }
+
+    int64_t integer(std::string_view key, int64_t fallback = 0) const {
+        std::string_view value = unquote(raw(key));
+        int64_t out = fallback;
+        if (value.empty() || std::from_chars(value.data(), value.data() + value.size(), out).ec != std::errc()) {
+            return fallback;
+        }
+        return out;
+    }
+
+    uint64_t unsigned_integer(std::string_view key, uint64_t fallback = 0) const {
+        std::string_view value = unquote(raw(key));
+        uint64_t out = fallback;
+        if (value.empty() || std::from_chars(value.data(), value.data() + value.size(), out).ec != std::errc()) {
+            return fallback;
+        }
+        return out;
+    }
+
+private:
+    static std::string_view unquote(std::string_view value) {
+        if (value.size() >= 2 && value.front() == '"') {
+            return value.substr(1, value.size() - 2);
+        }
+        return value;
+    }
+
+    size_t skip_space(size_t pos) const {
+        while (pos < m_text.size() &&
+               (m_text[pos] == ' ' || m_text[pos] == '\n' || m_text[pos] == '\r' || m_text[pos] == '\t')) {
+            ++pos;
+        }
+        return pos;
+    }
+
+    // pos is at the opening quote; returns the index just past the closing one.
+    size_t skip_string(size_t pos) const {
+        for (++pos; pos < m_text.size(); ++pos) {
+            if (m_text[pos] == '\\') {
+                ++pos;
+            } else if (m_text[pos] == '"') {
+                return pos + 1;
+            }
+        }
+        return m_text.size();
+    }
+
+    // Returns the index just past the value starting at pos, or npos if malformed.
+    size_t skip_value(size_t pos) const {
+        if (pos >= m_text.size()) {
+            return std::string_view::npos;
+        }
+        char c = m_text[pos];
+        if (c == '"') {
+            return skip_string(pos);
+        }
+        if (c == '{' || c == '[') {
+            int depth = 0;
+            for (; pos < m_text.size(); ++pos) {
+                char d = m_text[pos];
+                if (d == '"') {
+                    pos = skip_string(pos) - 1;
+                } else if (d == '{' || d == '[') {
+                    ++depth;
+                } else if ((d == '}' || d == ']') && --depth == 0) {
+                    return pos + 1;
+                }
+            }
+            return std::string_view::npos;
+        }
+        size_t end = pos;
+        while (end < m_text.size() && m_text[end] != ',' && m_text[end] != '}' && m_text[end] != ']' &&
+               m_text[end] != ' ' && m_text[end] != '\n') {
+            ++end;
+        }
+        return end == pos ? std::string_view::npos : end;
+    }
+
+    std::string_view m_text;
+};
+
+// Typed views of the engine's messages. The string_views point into the
+// received message, so a view is only valid inside the callback it is passed to.
+
+// TICK.<SYMBOL>
+struct TickView {
+    std::string_view symbol;
+    double price = 0.0;
+    double size = 0.0;
+    int64_t timestamp = 0;  // engine system_clock ticks at ingest
+    bool snapshot = false;  // the cached last tick, sent because someone subscribed
+
+    static bool decode(std::string_view payload, TickView& out) {
+        JsonView json(payload);
+        JsonView data = json.object("data");
+        out.symbol = data.string("symbol");
+        if (out.symbol.empty()) {
+            return false;
+        }
+        out.price = data.number("price");
+        out.size = data.number("size");
+        out.timestamp = json.integer("timestamp");
+        out.snapshot = json.has("snapshot");
+        return true;
+    }
+};
+
+// HISTORY.<SYMBOL>
+struct BarView {
+    std::string_view symbol;
+    std::string_view time;
+    double open = 0.0;
+    double high = 0.0;
+    double low = 0.0;
+    double close = 0.0;
+    double volume = 0.0;
+    bool snapshot = false;  // the symbol's latest bar, not part of a history response
+
+    static bool decode(std::string_view payload, BarView& out) {
+        JsonView json(payload);
+        out.symbol = json.string("symbol");
+        if (out.symbol.empty()) {
+            return false;
+        }
+        out.time = json.string("time");
+        out.open = json.number("open");
+        out.high = json.number("high");
+        out.low = json.number("low");
+        out.close = json.number("close");
+        out.volume = json.number("volume");
+        out.snapshot = json.has("snapshot");
+        return true;
+    }
+};
+
+// EXECUTION.<STRATEGY>.<ORDER_ID>. exec_id and fill_price are only set for a fill.
+struct ExecutionView {
+    uint64_t order_id = 0;
+    std::string_view correlation_id;
+    std::string_view strategy_id;
+    std::string_view symbol;
+    std::string_view side;
+    std::string_view status;
+    double quantity = 0.0;
+    double filled_quantity = 0.0;
+    double avg_fill_price = 0.0;
+    std::string_view exec_id;
+    double fill_quantity = 0.0;
+    double fill_price = 0.0;
+    double strategy_position = 0.0;
+    double strategy_realized_pnl = 0.0;
+    int64_t timestamp = 0;
+    // The current state of a working order, sent because someone subscribed.
+    bool snapshot = false;
+
+    bool is_fill() const { return !exec_id.empty(); }
+
+    static bool decode(std::string_view payload, ExecutionView& out) {
+        JsonView json(payload);
+        JsonView data = json.object("data");
+        if (!data.has("order_id")) {
+            return false;
+        }
+        out.order_id = data.unsigned_integer("order_id");
+        out.correlation_id = data.string("correlation_id");
+        out.strategy_id = data.string("strategy_id");
+        out.symbol = data.string("symbol");
+        out.side = data.string("side");
+        out.status = data.string("status");
+        out.quantity = data.number("quantity");
+        out.filled_quantity = data.number("filled_quantity");
+        out.avg_fill_price = data.number("avg_fill_price");
+        out.exec_id = data.string("exec_id");
+        out.fill_quantity = data.number("fill_quantity");
+        out.fill_price = data.number("fill_price");
+        out.strategy_position = data.number("strategy_position");
+        out.strategy_realized_pnl = data.number("strategy_realized_pnl");
+        out.timestamp = json.integer("timestamp");
+        out.snapshot = json.has("snapshot");
+        return true;
+    }
+};
+
+// Commands are small and rare next to market data, so they are simply written
+// as text.
+struct OrderRequest {
+    std::string symbol;
+    std::string side = "BUY";           // BUY or SELL
+    std::string order_type = "MARKET";  // MARKET or LIMIT
+    double quantity = 0.0;
+    double limit_price = 0.0;           // LIMIT only
+    std::string strategy_id;            // may not contain '.'
+    std::string correlation_id;         // echoed back on its execution reports
+};
+
+class JsonWriter {
+public:
+    JsonWriter& begin_object() { separate(); m_out += '{'; m_first = true; return *this; }
+    JsonWriter& end_object() { m_out += '}'; m_first = false; return *this; }
+    JsonWriter& begin_array(std::string_view key) { this->key(key); m_out += '['; m_first = true; return *this; }
+    JsonWriter& end_array() { m_out += ']'; m_first = false; return *this; }
+
+    JsonWriter& field(std::string_view key, std::string_view value) {
+        this->key(key);
+        m_out += '"';
+        for (char c : value) {
+            if (c == '"' || c == '\\') {
+                m_out += '\\';
+                m_out += c;
+            } else if (static_cast<unsigned char>(c) < 0x20) {
+                static const char hex[] = "0123456789abcdef";
+                m_out += "\\u00";
+                m_out += hex[(c >> 4) & 0xF];
+                m_out += hex[c & 0xF];
+            } else {
+                m_out += c;
+            }
+        }
+        m_out += '"';
+        return *this;
+    }
+    JsonWriter& field(std::string_view key, const char* value) { return field(key, std::string_view(value)); }
+    JsonWriter& field(std::string_view key, double value) {
+        this->key(key);
+        char buffer[32];
+        auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+        m_out.append(buffer, result.ptr);
+        return *this;
+    }
+    JsonWriter& field(std::string_view key, int64_t value) {
+        this->key(key);
+        m_out += std::to_string(value);
+        return *this;
+    }
+    JsonWriter& field(std::string_view key, uint64_t value) {
+        this->key(key);
+        m_out += std::to_string(value);
+        return *this;
+    }
+    JsonWriter& field(std::string_view key, bool value) {
+        this->key(key);
+        m_out += value ? "true" : "false";
+        return *this;
+    }
+
+    const std::string& str() const { return m_out; }
+
+private:
+    void separate() {
+        if (!m_first && !m_out.empty() && m_out.back() != '[' && m_out.back() != '{') {
+            m_out += ',';
+        }
+    }
+    void key(std::string_view key) {
+        separate();
+        m_first = false;
+        m_out += '"';
+        m_out.append(key.data(), key.size());
+        m_out += "\":";
+    }
+
+    std::string m_out;
+    bool m_first = true;
+};
+
+inline void write_order(JsonWriter& writer, const OrderRequest& order) {
+    writer.begin_object()
+        .field("symbol", order.symbol)
+        .field("side", order.side)
+        .field("order_type", order.order_type)
+        .field("quantity", order.quantity);
+    if (order.order_type == "LIMIT") {
+        writer.field("limit_price", order.limit_price);
+    }
+    if (!order.strategy_id.empty()) {
+        writer.field("strategy_id", order.strategy_id);
+    }
+    if (!order.correlation_id.empty()) {
+        writer.field("correlation_id", order.correlation_id);
+    }
+    writer.end_object();
+}
+
+// CREATE_ORDER payload.
+inline std::string encode_order(const OrderRequest& order) {
+    JsonWriter writer;
+    write_order(writer, order);
+    return writer.str();
+}
+
+// CREATE_ORDER_BATCH payload: {"orders": [...]}.
+inline std::string encode_order_batch(const std::vector<OrderRequest>& orders) {
+    JsonWriter writer;
+    writer.begin_object().begin_array("orders");
+    for (const auto& order : orders) {
+        write_order(writer, order);
+    }
+    writer.end_array().end_object();
+    return writer.str();
+}
+
+}
@@ -0,0 +1,92 @@
+// A minimal strategy on the client library: buys 10 shares of a symbol
+// whenever it trades below its 20-bar moving average, flat otherwise.
+//
+// Usage: client_example [SYMBOL]
+
+#include "EngineClient.hpp"
+#include <csignal>
+#include <deque>
+#include <iostream>
+#include <numeric>
+
+using namespace TradingEngine::Client;
+
+namespace {
+
+EngineClient* g_client = nullptr;
+
+void handle_signal(int) {
+    if (g_client) {
+        g_client->stop();
+    }
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    const std::string symbol = argc > 1 ? argv[1] : "AAPL";
+    const std::string strategy = "example_ma";
+
+    EngineClientConfig config;
+    config.client_id = strategy;
+    EngineClient client(config);
+    g_client = &client;
+    std::signal(SIGINT, handle_signal);
+
+    if (!client.connect()) {
+        std::cerr << "No answer from the engine at " << config.command_endpoint << std::endl;
+        return 1;
+    }
+
+    std::deque<double> closes;
+    double position = 0.0;
+    bool order_pending = false;
+
+    client.on_history([&](std::string_view, const std::vector<BarView>& bars) {
+        for (const auto& bar : bars) {
+            closes.push_back(bar.close);
+        }
+        while (closes.size() > 20) {
+            closes.pop_front();
+        }
+        std::cout << "Loaded " << bars.size() << " bars of history" << std::endl;
+    });
+
+    client.on_tick([&](const TickView& tick) {
+        if (closes.empty() || order_pending) {
+            return;
+        }
+        double average = std::accumulate(closes.begin(), closes.end(), 0.0) / closes.size();
+        bool want_long = tick.price < average;
+        if (want_long == (position > 0.0)) {
+            return;
+        }
+        OrderRequest order;
+        order.symbol = std::string(tick.symbol);
+        order.side = want_long ? "BUY" : "SELL";
+        order.quantity = want_long ? 10.0 : position;
+        order.strategy_id = strategy;
+        client.send_order(order);
+        order_pending = true;
+    });
+
+    client.on_execution([&](const ExecutionView& report) {
+        position = report.strategy_position;
+        if (report.status == "FILLED" || report.status == "CANCELED" || report.status == "REJECTED") {
+            order_pending = false;
+        }
+        std::cout << "Order " << report.order_id << " " << report.status << ", position " << position << std::endl;
+    });
+
+    client.on_message([](std::string_view topic, std::string_view payload) {
+        std::cout << topic << " " << payload << std::endl;
+    });
+
+    client.subscribe_executions(strategy);
+    client.subscribe("ALERT");
+    client.request_history(symbol, "1 M", "1 day");
+    client.subscribe_ticks(symbol);
+    client.run();
+    client.unsubscribe_ticks(symbol);
+    return 0;
+}
@@ -1,4 +1,5 @@
 #pragma once
+#include "FixedPoint.hpp"
 #include <string>
 
 namespace TradingEngine {
@@ -6,11 +7,13 @@ namespace TradingEngine {
 struct Bar {
     std::string symbol;
     std::string time;
-    double open;
-    double high;
-    double low;
-    double close;
-    long long volume;
+    Price open;
+    Price high;
+    Price low;
+    Price close;
+    Quantity volume;
+    // Marks the end of a history response; only symbol is set.
+    bool end_of_history = false;
 };
 
 }
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace TradingEngine {
+
+// Deferred-formatting log for hot-path call sites. A call records only the
+// site id, a timestamp and up to kMaxArgs raw arguments into a per-thread
+// lock-free ring; a background thread appends the records and the site table
+// (format strings) to a binary file that tools/binlog_decode formats offline.
+//
+// When the binary log is not open, TE_BINLOG falls back to a normal spdlog call.
+
+enum class BinaryArgKind : uint8_t { NONE, I64, U64, F64, STR };
+
+struct BinaryLogRecord {
+    static constexpr size_t kMaxArgs = 6;
+    static constexpr size_t kInlineStringSize = 8;
+
+    uint64_t timestamp_ns;
+    uint16_t site_id;
+    uint8_t arg_count;
+    uint8_t reserved[5];
+    union Arg {
+        int64_t i64;
+        uint64_t u64;
+        double f64;
+        char str[kInlineStringSize];  // truncated, not NUL-terminated when full
+    } args[kMaxArgs];
+};
+static_assert(sizeof(BinaryLogRecord) == 64, "BinaryLogRecord should fill one cache line");
+
+// File layout: kBinaryLogMagic, then a stream of tagged entries.
+//   'S' site:   u16 id, u8 level, u8 arg_count, u8 kinds[kMaxArgs], u16 len, format bytes,
+//               u16 len, file bytes, u32 line
+//   'R' record: BinaryLogRecord
+//   'D' drops:  u64 records dropped because a ring was full
+constexpr char kBinaryLogMagic[8] = {'T', 'E', 'B', 'L', 'O', 'G', '0', '1'};
+
+struct BinaryLogSite {
+    std::atomic<uint16_t> id{0};
+};
+
+class BinaryLog {
+public:
+    BinaryLog(const BinaryLog&) = delete;
+    BinaryLog& operator=(const BinaryLog&) = delete;
+
+    static bool open(const std::string& path, size_t ring_capacity = 16384);
+    static void close();
+
+    static bool enabled() { return s_enabled.load(std::memory_order_relaxed); }
+
+    template<typename... Args>
+    static void write(BinaryLogSite& site, spdlog::level::level_enum level, const char* format,
+                      const char* file, int line, const Args&... args) {
+        static_assert(sizeof...(Args) <= BinaryLogRecord::kMaxArgs, "too many arguments for TE_BINLOG");
+        uint16_t id = site.id.load(std::memory_order_acquire);
+        if (id == 0) {
+            const std::array<BinaryArgKind, BinaryLogRecord::kMaxArgs> kinds = {kind_of<Args>()...};
+            id = register_site(site, level, format, file, line, sizeof...(Args), kinds.data());
+        }
+        BinaryLogRecord* record = claim();
+        if (!record) {
+            return;
+        }
+        record->timestamp_ns = now_ns();
+        record->site_id = id;
+        record->arg_count = static_cast<uint8_t>(sizeof...(Args));
+        size_t i = 0;
+        (encode(record->args[i++], args), ...);
+        (void)i;
+        publish();
+    }
+
+private:
+    BinaryLog() = default;
+
+    template<typename T>
+    static constexpr BinaryArgKind kind_of() {
+        using U = std::decay_t<T>;
+        if constexpr (std::is_floating_point_v<U>) {
+            return BinaryArgKind::F64;
+        } else if constexpr (std::is_integral_v<U> && std::is_signed_v<U>) {
+            return BinaryArgKind::I64;
+        } else if constexpr (std::is_integral_v<U> || std::is_enum_v<U>) {
+            return BinaryArgKind::U64;
+        } else {
+            static_assert(std::is_convertible_v<const U&, std::string_view>, "unsupported TE_BINLOG argument type");
+            return BinaryArgKind::STR;
+        }
+    }
+
+    template<typename T>
+    static void encode(BinaryLogRecord::Arg& slot, const T& value) {
+        constexpr BinaryArgKind kind = kind_of<T>();
+        if constexpr (kind == BinaryArgKind::F64) {
+            slot.f64 = static_cast<double>(value);
+        } else if constexpr (kind == BinaryArgKind::I64) {
+            slot.i64 = static_cast<int64_t>(value);
+        } else if constexpr (kind == BinaryArgKind::U64) {
+            slot.u64 = static_cast<uint64_t>(value);
+        } else {
+            std::string_view sv(value);
+            std::memset(slot.str, 0, sizeof(slot.str));
+            std::memcpy(slot.str, sv.data(), std::min(sv.size(), sizeof(slot.str)));
+        }
+    }
+
+    static uint64_t now_ns();
+    static uint16_t register_site(BinaryLogSite& site, spdlog::level::level_enum level, const char* format,
+                                  const char* file, int line, size_t arg_count, const BinaryArgKind* kinds);
+    static BinaryLogRecord* claim();
+    static void publish();
+
+    inline static std::atomic<bool> s_enabled{false};
+};
+
+}
+
+#define TE_BINLOG(level, format, ...)                                                              \
+    do {                                                                                           \
+        if (::TradingEngine::BinaryLog::enabled()) {                                               \
+            static ::TradingEngine::BinaryLogSite te_binlog_site_;                                 \
+            ::TradingEngine::BinaryLog::write(te_binlog_site_, level, format, __FILE__, __LINE__,  \
+                                              ##__VA_ARGS__);                                      \
+        } else {                                                                                   \
+            spdlog::log(level, format, ##__VA_ARGS__);                                             \
+        }                                                                                          \
+    } while (0)
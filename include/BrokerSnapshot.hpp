@@ -0,0 +1,45 @@
+#pragma once
+
+#include "types.hpp"
+#include "FixedPoint.hpp"
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace TradingEngine {
+
+struct BrokerOrder {
+    uint64_t order_id = 0;
+    std::string symbol;
+    Quantity quantity;
+    Quantity filled_quantity;
+};
+
+struct BrokerExecution {
+    std::string exec_id;
+    uint64_t order_id = 0;
+    std::string symbol;
+    Side side = Side::BUY;
+    Quantity quantity;
+    Price price;
+};
+
+// What the broker reports after a reconnect: working orders, today's
+// executions for this client and account positions. OrderManager treats it
+// as the source of truth for anything the engine missed while disconnected.
+struct BrokerSnapshot {
+    std::vector<BrokerOrder> open_orders;
+    std::vector<BrokerExecution> executions;
+    std::unordered_map<std::string, Quantity> positions;
+    // When the open orders were asked for. An order missing from them is only
+    // known to be gone if the broker had acknowledged it before this; a newer
+    // one may simply not have been listed yet.
+    std::chrono::system_clock::time_point requested_at;
+    // Orders whose placeOrder was dropped while disconnected, so the broker
+    // never saw them.
+    std::vector<uint64_t> unsent_orders;
+};
+
+}
@@ -1,67 +1,194 @@
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
+#include <unordered_map>
 #include <nlohmann/json.hpp>
 #include <stdexcept> // Added for std::runtime_error
-#include "LogHandler.hpp" 
+#include "LogHandler.hpp"
+
+// config.json compiled into plain typed fields and validated once per load.
+// A published EngineConfig is never modified, so readers need no lock.
+struct EngineConfig {
+    struct EventQueueLane {
+        int capacity = 0;    // 0 = not set
+        std::string policy;  // "" = not set
+    };
+
+    struct StrategyPlugin {
+        std::string id;
+        std::string library;
+        std::vector<std::string> symbols;
+        nlohmann::json params = nlohmann::json::object();
+    };
+
+    uint64_t version = 0;  // 1 for the first load, +1 per successful reload
+
+    // engine_settings
+    std::string engine_mode = "mock";
+    std::string log_file_path = "logs/engine.log";
+    std::string log_mode = "sync";
+    int log_queue_size = 8192;
+    std::string binary_log_path;
+    std::string contract_cache_path;
+    int contract_cache_max_age_hours = 24;
+    std::string gateway_reader_mode = "direct";
+    int worker_shards = 1;
+    int lane_starvation_limit = 64;
+
+    // risk_management (reloadable)
+    int max_order_size = 100;
+    double max_position_value = 10000.0;
+
+    // market data (subscriptions are reloadable)
+    std::vector<std::string> market_data_subscriptions;
+    int market_data_line_limit = 100;
+
+    // outbound_pacing
+    double outbound_messages_per_second = 45.0;
+    double outbound_burst = 20.0;
+    int history_request_spacing_ms = 250;
+
+    // reconnect
+    int reconnect_initial_delay_ms = 250;
+    int reconnect_max_delay_ms = 30000;
+    int connect_timeout_ms = 10000;
+
+    // journal
+    std::string journal_directory;
+    bool journal_fsync = true;
+    int journal_snapshot_every_records = 10000;
+
+    // flight_recorder ("" directory = off)
+    std::string flight_recorder_directory;
+    int flight_recorder_records_per_thread = 4096;
+
+    std::map<std::string, EventQueueLane> event_queue;  // by lane name
+    // strategy_plugins: in-process strategies, loaded at startup
+    std::vector<StrategyPlugin> strategy_plugins;
+    std::unordered_map<std::string, double> tick_sizes;
+    nlohmann::json sessions;
+
+    // scripting (required)
+    std::string scripting_publish_endpoint;
+    std::string scripting_subscribe_endpoint;
+
+    // telemetry
+    bool latency_stats = false;
+    int stats_publish_interval_ms = 1000;
+};
 
 class ConfigHandler {
 public:
+    // Runs on the watcher thread after a new config is published. Both
+    // references stay valid for the life of the process.
+    using ReloadListener = std::function<void(const EngineConfig& previous, const EngineConfig& current)>;
+
     ConfigHandler(const ConfigHandler&) = delete;
     ConfigHandler& operator=(const ConfigHandler&) = delete;
 
     static bool initialize(const std::string& config_path = "config/config.json");
 
+    // The published config: a single atomic load, safe from any thread. Before
+    // initialize() this is the built-in defaults.
+    static const EngineConfig& current();
+    // Re-reads and recompiles the file. An invalid file is logged and the
+    // current config stays in force; returns whether a new one was published.
+    static bool reload();
+    static void on_reload(ReloadListener listener);
+    // Reloads whenever the file is written or replaced (inotify on its directory,
+    // so editors that save by rename are seen too).
+    static bool start_watching();
+    static void stop_watching();
+
     static std::string get_engine_mode();
     static std::string get_log_file_path();
+    static std::string get_log_mode();
+    static int get_log_queue_size();
+    static std::string get_binary_log_path();
+    static std::string get_contract_cache_path();
+    static int get_contract_cache_max_age_hours();
     static int get_max_order_size();
     static double get_max_position_value();
     static std::vector<std::string> get_market_data_subscriptions();
-    
+    static int get_market_data_line_limit();
+    static double get_outbound_messages_per_second();
+    static double get_outbound_burst();
+    static int get_history_request_spacing_ms();
+    static int get_reconnect_initial_delay_ms();
+    static int get_reconnect_max_delay_ms();
+    static int get_connect_timeout_ms();
+    static std::string get_gateway_reader_mode();
+    static int get_worker_shards();
+    static int get_lane_starvation_limit();
+    // event_queue.<lane>: bounded capacity and overflow policy per event lane.
+    static int get_event_queue_capacity(const std::string& lane, int default_capacity);
+    static std::string get_event_queue_policy(const std::string& lane, const std::string& default_policy);
+    static std::string get_journal_directory();
+    static bool get_journal_fsync();
+    static int get_journal_snapshot_every_records();
+    static std::string get_flight_recorder_directory();
+    static int get_flight_recorder_records_per_thread();
+    static std::unordered_map<std::string, double> get_tick_sizes();
+    // Raw "sessions" object: per-exchange hours, DST rule, holidays, auctions.
+    static nlohmann::json get_sessions();
+    static std::vector<EngineConfig::StrategyPlugin> get_strategy_plugins();
+
     // New methods for Scripting Interface
     static std::string get_scripting_publish_endpoint();
     static std::string get_scripting_subscribe_endpoint();
 
+    static bool get_latency_stats_enabled();
+    static int get_stats_publish_interval_ms();
+
 private:
     ConfigHandler() = default;
+    ~ConfigHandler();
 
     static ConfigHandler& get_instance();
 
-    template<typename T>
-    T get_value(const std::string& key, const T& default_value) const {
-        try {
-            std::string pointer_path = "/" + key;
-            std::replace(pointer_path.begin(), pointer_path.end(), '.', '/');
-            nlohmann::json::json_pointer ptr(pointer_path);
+    // Parses and validates the file; false (with the reasons logged) if unusable.
+    bool load_file(EngineConfig& config) const;
+    static bool compile(const nlohmann::json& json, EngineConfig& config);
+    void publish(std::unique_ptr<EngineConfig> config);
+    void watch(int inotify_fd);
 
-            return m_config_json.at(ptr).get<T>();
-        } catch (const nlohmann::json::out_of_range& e) {
+    template<typename T>
+    static bool read_value(const nlohmann::json& json, const std::string& key, T& out, bool required = false) {
+        std::string pointer_path = "/" + key;
+        std::replace(pointer_path.begin(), pointer_path.end(), '.', '/');
+        nlohmann::json::json_pointer ptr(pointer_path);
+        if (!json.contains(ptr)) {
+            if (required) {
+                spdlog::critical("Required config key '{}' not found.", key);
+                return false;
+            }
             spdlog::warn("Config key '{}' not found. Using default value.", key);
-            return default_value;
-        } catch (const nlohmann::json::type_error& e) {
-            spdlog::error("Config key '{}' has wrong type. Using default value. Error: {}", key, e.what());
-            return default_value;
+            return true;
         }
-    }
-
-    template<typename T>
-    T get_required_value(const std::string& key) const {
         try {
-            std::string pointer_path = "/" + key;
-            std::replace(pointer_path.begin(), pointer_path.end(), '.', '/');
-            nlohmann::json::json_pointer ptr(pointer_path);
-
-            return m_config_json.at(ptr).get<T>();
-        } catch (const nlohmann::json::out_of_range& e) {
-            spdlog::critical("Required config key '{}' not found.", key);
-            throw std::runtime_error("Required config key not found: " + key);
+            out = json.at(ptr).get<T>();
+            return true;
         } catch (const nlohmann::json::type_error& e) {
-            spdlog::critical("Required config key '{}' has wrong type.", key);
-            throw std::runtime_error("Required config key has wrong type: " + key);
+            spdlog::error("Config key '{}' has wrong type. Error: {}", key, e.what());
+            return false;
         }
     }
 
-    nlohmann::json m_config_json;
-    bool m_initialized = false;
+    std::string m_config_path;
+    std::atomic<const EngineConfig*> m_current{nullptr};
+    // Every version ever published stays alive, so a reader holding a
+    // reference is never left dangling. Reloads are rare and configs small.
+    std::vector<std::unique_ptr<const EngineConfig>> m_versions;
+    std::mutex m_reload_mutex;
+    std::vector<ReloadListener> m_listeners;
+    std::thread m_watcher;
+    std::atomic<bool> m_watching{false};
 };
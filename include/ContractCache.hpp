@@ -0,0 +1,85 @@
+#pragma once
+
+#include "FixedPoint.hpp"
+#include "SymbolTable.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace TradingEngine {
+
+// Everything the engine needs to address an instrument without re-sending a
+// full description or asking the gateway again.
+struct ContractInfo {
+    SymbolId symbol_id = kInvalidSymbolId;
+    std::string symbol;
+    long con_id = 0;
+    std::string sec_type;
+    std::string exchange;
+    std::string primary_exchange;
+    std::string currency;
+    Price min_tick;
+    std::string time_zone;
+    std::string trading_hours;
+    int64_t resolved_at = 0;  // unix seconds
+};
+
+// Posted to the engine once a reqContractDetails round trip finishes, so any
+// requests parked on the symbol can be sent from the engine thread.
+struct ContractResolution {
+    SymbolId symbol_id = kInvalidSymbolId;
+    bool resolved = false;
+};
+
+// Contract master keyed by SymbolId. Lookups are a single atomic load and
+// never lock; stores come from the gateway's reader thread. When backed by a
+// file the entries live in a fixed-record memory-mapped table, so a warm
+// restart can skip contract resolution for anything resolved recently.
+class ContractCache {
+public:
+    ContractCache();
+    ~ContractCache();
+    ContractCache(const ContractCache&) = delete;
+    ContractCache& operator=(const ContractCache&) = delete;
+
+    static ContractCache& instance();
+
+    // Maps (creating if needed) the cache file and loads entries younger than
+    // max_age. Without a file the cache still works, in memory only.
+    bool open(const std::string& path, std::chrono::hours max_age = std::chrono::hours(24));
+    void close();
+
+    const ContractInfo* lookup(SymbolId id) const {
+        if (id == kInvalidSymbolId || id > SymbolTable::kMaxSymbols) {
+            return nullptr;
+        }
+        return m_entries[id].load(std::memory_order_acquire);
+    }
+
+    // Publishes (or replaces) the entry for info.symbol_id and persists it.
+    void store(const ContractInfo& info);
+
+    size_t size() const;
+
+private:
+    struct FileHeader;
+    struct Record;
+
+    void persist_locked(const ContractInfo& info);
+
+    std::unique_ptr<std::atomic<const ContractInfo*>[]> m_entries;
+    mutable std::mutex m_mutex;
+    std::deque<ContractInfo> m_storage;  // owns every published entry; never shrinks
+    std::unordered_map<SymbolId, uint32_t> m_record_slots;
+
+    int m_fd = -1;
+    void* m_map = nullptr;
+    size_t m_map_size = 0;
+};
+
+}
@@ -1,29 +1,59 @@
 #pragma once
 
-#include "ThreadSafeQueue.hpp"
+#include "LaneQueue.hpp"
 #include "Event.hpp"
 #include "OrderManager.hpp"
 #include "ScriptingInterface.hpp"
 #include "I_MarketDataHandler.hpp"
+#include "I_ExecutionHandler.hpp"
+#include "Stats.hpp"
+#include "TimerWheel.hpp"
+#include "SessionCalendar.hpp"
+#include "StrategyHost.hpp"
+#include <array>
 #include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
 #include <thread>
+#include <unordered_map>
+#include <vector>
 
 namespace TradingEngine {
 class OrderManager;
 class I_MarketDataHandler;
-class IBKRExecutionHandler;
 class IBKRGatewayClient;
+class OrderJournal;
 }
 
 namespace TradingEngine {
 
+// Cross-shard view assembled from what each worker last published.
+struct PortfolioSnapshot {
+    double gross_exposure = 0.0;  // sum of |position| * last price
+    size_t open_orders = 0;
+    size_t shards = 0;
+};
+
 class EngineCore {
 public:
     EngineCore(
         OrderManager& order_manager, std::string pub, std::string sub);
     void set_market_data_handler(I_MarketDataHandler* md_handler);
-    void set_execution_handler(IBKRExecutionHandler* exec_handler);
+    void set_execution_handler(I_ExecutionHandler* exec_handler);
     void set_gateway_client(IBKRGatewayClient* gateway_client);
+    // Optional. When set, new orders and modifications reach the gateway only
+    // after their journal record is durable. One journal per shard.
+    void set_order_journal(OrderJournal* journal, size_t shard = 0);
+    // Sharded mode (workers > 1): ticks, bars, orders and execution reports
+    // for a symbol run on worker (symbol id % workers), which owns that
+    // symbol's orders and positions in its own OrderManager. Shard 0 uses the
+    // OrderManager passed to the constructor. Call before run().
+    void set_worker_count(size_t workers);
+    size_t worker_count() const { return m_shards.size(); }
+    OrderManager& shard_order_manager(size_t shard);
+    PortfolioSnapshot portfolio_snapshot() const;
     void startup();
     void run();
     bool is_running() const;
@@ -32,23 +62,150 @@ public:
     void set_mode(std::string mode);
     std::string get_mode();
     void start_data_feed();
+    void set_stats_publish_interval(std::chrono::milliseconds interval);
+    // How many times a non-empty lower-priority lane may be passed over
+    // before it is served anyway (0 = strict priority).
+    void set_lane_starvation_limit(size_t limit);
+    // Capacity and overflow policy of each lane, applied to the control queue
+    // and every shard queue. Allocates the rings; call before run().
+    void set_event_queue_config(const std::array<LaneConfig, kEventLaneCount>& config);
+    // Exchange calendars; each exchange's OPEN, CLOSE and auction times are
+    // published on SESSION.<exchange> as they pass. Call before run().
+    void set_session_calendar(SessionCalendar calendar);
+    // Loads an in-process strategy (see StrategyPlugin.hpp). Its callbacks run
+    // on the event loop that owns each symbol. Call before run().
+    bool load_strategy_plugin(const StrategyPluginConfig& config);
     
 private:
+    using EventQueue = LaneQueue<Event, kEventLaneCount>;
+
+    // Per-lane depth, enqueue-to-dequeue wait and overflow for one event queue.
+    struct LaneStats {
+        std::string prefix;
+        std::array<Gauge*, kEventLaneCount> depth{};
+        std::array<LatencyHistogram*, kEventLaneCount> wait{};
+        std::array<Counter*, kEventLaneCount> dropped{};
+        std::array<Counter*, kEventLaneCount> conflated{};
+        std::array<Counter*, kEventLaneCount> rejected{};
+        std::array<Counter*, kEventLaneCount> blocked{};
+        // Overflow totals already folded into the counters above.
+        std::array<LaneOverload, kEventLaneCount> reported{};
+    };
+
+    struct SymbolExposure {
+        Quantity position;
+        Price last_price;
+        double exposure = 0.0;
+    };
+
+    // One event loop's slice of the engine. Only its worker thread touches
+    // order_manager and exposures; the atomics are read by portfolio_snapshot().
+    struct Shard {
+        size_t index = 0;
+        OrderManager* order_manager = nullptr;
+        std::unique_ptr<OrderManager> owned_order_manager;
+        OrderJournal* journal = nullptr;
+        EventQueue queue;
+        LaneStats lane_stats;
+        std::thread worker;
+        std::unordered_map<SymbolId, SymbolExposure> exposures;
+        double gross_exposure = 0.0;
+        std::atomic<double> published_exposure{0.0};
+        std::atomic<size_t> published_open_orders{0};
+        Gauge* queue_depth = nullptr;
+    };
+
+    class PluginContext;
+
     I_MarketDataHandler* m_market_data_handler;
-    IBKRExecutionHandler* m_execution_handler;
+    I_ExecutionHandler* m_execution_handler;
     IBKRGatewayClient* m_gateway_client;
+    OrderJournal* m_journal = nullptr;
     void process_events();
-    void handle_tick_event(const Tick& tick);
-    void handle_order_request_event(Order& order);
+    void run_shard(Shard& shard);
+    // Handles events that belong to a shard; false for control events.
+    bool handle_shard_event(Event& event, Shard& shard);
+    // Handles one event popped by the control loop.
+    void dispatch(Event& event, Shard& inline_shard);
+    void record_dequeue(const Event& event, const EventQueue& queue, LaneStats& lane_stats);
+    static LaneStats register_lane_stats(const std::string& prefix);
+    static void push_event(EventQueue& queue, Event event, bool may_block);
+    static uint32_t conflation_key(const Event& event);
+    void configure_queue(EventQueue& queue);
+    void publish_stats_if_due();
+    // Publishes an ALERT for every lane that dropped, conflated, rejected or
+    // blocked since the last check.
+    void check_overload_if_due();
+    void check_overload(const EventQueue& queue, LaneStats& lane_stats);
+    // Timers run on the control loop; it waits no longer than the next one.
+    void run_timers();
+    std::chrono::nanoseconds next_wait() const;
+    void schedule_next_session_event(const std::string& exchange, int64_t after_ns);
+    void handle_timer_request(const TimerRequest& request);
+    // Sharded mode: queues event on the owning shard(s). False for control events.
+    bool route_to_shard(Event& event, bool may_block);
+    size_t shard_for_symbol(SymbolId symbol_id) const;
+    size_t shard_for_order(uint64_t order_id, const std::string& symbol);
+    void handle_tick_event(const Tick& tick, LatencyTrace& trace, Shard& shard);
     void handle_send_new_order_event(Order& order);
-    void handle_execution_report_event(const ExecutionReport& report);
+    bool check_risk(const Order& order, Shard& shard, std::string& reason) const;
+    // Risk-checks, records and sends a new order on its owning shard. The
+    // order's id is set even if it is rejected.
+    void place_order(Order& order, LatencyTrace& trace, Shard& shard);
+    // Plugin orders and cancels: handled inline when the calling event loop
+    // owns them, otherwise queued like a command. Return 0 / true when queued.
+    uint64_t submit_strategy_order(Order& order);
+    bool cancel_strategy_order(uint64_t order_id, const std::string& strategy_id);
+    void send_new_order(const Order& order, LatencyTrace& trace);
+    void send_modify(const Order& order);
+    void send_cancel(uint64_t order_id, Shard& shard);
+    void forget_order_shard(uint64_t order_id);
+    void reject_unjournaled(uint64_t order_id, ReportType type, OrderStatus status = OrderStatus::NEW);
+    void publish_order_update(uint64_t order_id, const ExecutionReport& report, Shard& shard);
+    void update_exposure(Shard& shard, SymbolId symbol_id, const std::string& symbol, const Price* price,
+                         bool position_changed);
+    void publish_shard_state(Shard& shard);
 
     std::atomic<bool> m_is_running;
-    ThreadSafeQueue<Event> m_event_queue;
+    EventQueue m_event_queue;
+    LaneStats m_lane_stats;
+    size_t m_lane_starvation_limit = 64;
+    std::array<LaneConfig, kEventLaneCount> m_queue_config{};
 
     OrderManager& m_order_manager;
     ScriptingInterface m_scripting_interface;
     std::string m_mode;
+
+    std::vector<std::unique_ptr<Shard>> m_shards;
+    // The shard whose events this thread handles, if any.
+    static thread_local Shard* s_current_shard;
+    StrategyHost m_strategies;
+    // Sharded mode: which shard owns each working order, so cancels, modifies
+    // and execution reports that carry only an order id find it. Finished
+    // orders are dropped; a late fill for one carries its symbol, which
+    // routes to the same shard.
+    std::mutex m_order_shards_mutex;
+    std::unordered_map<uint64_t, size_t> m_order_shards;
+    // Shards still reconciling, and the corrections they made, so the last one
+    // reports a single RESYNCED.
+    std::atomic<size_t> m_reconcile_pending{0};
+    std::atomic<size_t> m_reconcile_corrections{0};
+
+    std::chrono::milliseconds m_stats_interval{1000};
+    std::chrono::steady_clock::time_point m_next_stats_publish;
+    std::chrono::steady_clock::time_point m_next_overload_check;
+    std::array<Counter*, kEventTypeCount> m_event_counters{};
+
+    // Control loop only.
+    TimerWheel m_timers;
+    SessionCalendar m_calendar;
+    std::unordered_map<std::string, TimerId> m_strategy_timers;  // "<strategy>.<name>"
+    Gauge* m_active_timers;
+    Counter* m_risk_rejects;
+    Gauge* m_queue_depth;
+    Gauge* m_queue_depth_max;
+    Gauge* m_portfolio_exposure;
+    Gauge* m_portfolio_open_orders;
 };
 
 }
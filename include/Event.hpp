@@ -1,10 +1,15 @@
 #pragma once
 #include <variant>
+#include <optional>
 #include <string>
 #include "Tick.hpp"
 #include "Order.hpp"
 #include "Bar.hpp"
 #include "ExecutionReport.hpp" 
+#include "Stats.hpp"
+#include "ContractCache.hpp"
+#include "ReconnectSupervisor.hpp"
+#include "BrokerSnapshot.hpp"
 
 namespace TradingEngine {
 
@@ -15,6 +20,40 @@ struct HistoricalDataRequest {
     std::string bar_size;  // e.g., "1 day", "1 hour"
 };
 
+// SUBSCRIBE / UNSUBSCRIBE command. subscriber is optional; when set, repeated
+// requests from the same subscriber count once.
+struct SubscriptionRequest {
+    std::string topic;
+    std::string subscriber;
+};
+
+// CANCEL_ORDER uses order_id; CANCEL_ALL uses symbol and/or strategy_id
+// (neither means every open order). For CANCEL_ORDER a strategy_id must own
+// the order.
+struct CancelRequest {
+    uint64_t order_id = 0;
+    std::string symbol;
+    std::string strategy_id;
+};
+
+// MODIFY_ORDER: unset fields keep their current value.
+struct ModifyRequest {
+    uint64_t order_id = 0;
+    std::string strategy_id;
+    std::optional<Quantity> quantity;
+    std::optional<Price> price;
+};
+
+// TIMER command: (re)arms the strategy's timer `name`, or cancels it.
+// interval_ms > 0 repeats it.
+struct TimerRequest {
+    std::string strategy_id;
+    std::string name;
+    int64_t delay_ms = 0;
+    int64_t interval_ms = 0;
+    bool cancel = false;
+};
+
 enum class EventType {
     TICK,
     ORDER_REQUEST,
@@ -23,10 +62,99 @@ enum class EventType {
     NEXT_VALID_ID,
     SYSTEM_SHUTDOWN,
     SUBSCRIBE_REQUEST,
+    UNSUBSCRIBE_REQUEST,
     HISTORICAL_DATA_REQUEST,
-    HISTORICAL_DATA         
+    HISTORICAL_DATA,
+    CONTRACT_RESOLVED,
+    CONNECTION_STATE,
+    RECONCILIATION,
+    CANCEL_ORDER_REQUEST,
+    MODIFY_ORDER_REQUEST,
+    CANCEL_ALL_REQUEST,
+    TIMER_REQUEST
 };
 
+// Keep in sync with the last enumerator above.
+constexpr size_t kEventTypeCount = static_cast<size_t>(EventType::TIMER_REQUEST) + 1;
+
+inline std::string event_type_to_string(EventType type) {
+    switch (type) {
+        case EventType::TICK:
+            return "TICK";
+        case EventType::ORDER_REQUEST:
+            return "ORDER_REQUEST";
+        case EventType::SEND_NEW_ORDER:
+            return "SEND_NEW_ORDER";
+        case EventType::EXECUTION_REPORT:
+            return "EXECUTION_REPORT";
+        case EventType::NEXT_VALID_ID:
+            return "NEXT_VALID_ID";
+        case EventType::SYSTEM_SHUTDOWN:
+            return "SYSTEM_SHUTDOWN";
+        case EventType::SUBSCRIBE_REQUEST:
+            return "SUBSCRIBE_REQUEST";
+        case EventType::UNSUBSCRIBE_REQUEST:
+            return "UNSUBSCRIBE_REQUEST";
+        case EventType::HISTORICAL_DATA_REQUEST:
+            return "HISTORICAL_DATA_REQUEST";
+        case EventType::HISTORICAL_DATA:
+            return "HISTORICAL_DATA";
+        case EventType::CONTRACT_RESOLVED:
+            return "CONTRACT_RESOLVED";
+        case EventType::CONNECTION_STATE:
+            return "CONNECTION_STATE";
+        case EventType::RECONCILIATION:
+            return "RECONCILIATION";
+        case EventType::CANCEL_ORDER_REQUEST:
+            return "CANCEL_ORDER_REQUEST";
+        case EventType::MODIFY_ORDER_REQUEST:
+            return "MODIFY_ORDER_REQUEST";
+        case EventType::CANCEL_ALL_REQUEST:
+            return "CANCEL_ALL_REQUEST";
+        case EventType::TIMER_REQUEST:
+            return "TIMER_REQUEST";
+        default:
+            return "UNKNOWN";
+    }
+}
+
+// Event queues drain lanes in this order (see LaneQueue), so orders, fills
+// and control messages never wait behind a burst of ticks.
+enum class EventLane {
+    CONTROL,      // orders, cancels, execution reports, connection and subscription control
+    MARKET_DATA,  // ticks
+    BULK          // history and shutdown
+};
+
+constexpr size_t kEventLaneCount = static_cast<size_t>(EventLane::BULK) + 1;
+
+constexpr EventLane event_lane(EventType type) {
+    switch (type) {
+        case EventType::TICK:
+            return EventLane::MARKET_DATA;
+        // Shutdown goes last so whatever was queued before it is still handled.
+        case EventType::SYSTEM_SHUTDOWN:
+        case EventType::HISTORICAL_DATA_REQUEST:
+        case EventType::HISTORICAL_DATA:
+            return EventLane::BULK;
+        default:
+            return EventLane::CONTROL;
+    }
+}
+
+inline std::string event_lane_to_string(EventLane lane) {
+    switch (lane) {
+        case EventLane::CONTROL:
+            return "control";
+        case EventLane::MARKET_DATA:
+            return "market_data";
+        case EventLane::BULK:
+            return "bulk";
+        default:
+            return "unknown";
+    }
+}
+
 struct Event {
     EventType type;
     std::variant<
@@ -37,8 +165,16 @@ struct Event {
         ExecutionReport,
         std::string,
         HistoricalDataRequest,
-        Bar                    
+        SubscriptionRequest,
+        Bar,
+        ContractResolution,
+        ConnectionStatus,
+        BrokerSnapshot,
+        CancelRequest,
+        ModifyRequest,
+        TimerRequest
     > data;
+    LatencyTrace trace;
 };
 
 }
@@ -1,25 +1,42 @@
 #pragma once
 
 #include "types.hpp"
+#include "FixedPoint.hpp"
 #include <string>
 #include <chrono>
 
 namespace TradingEngine {
 
+// STATUS carries a broker status change (and, from mocks, an inline fill);
+// FILL is one execution, deduplicated by exec_id; CANCEL_REJECTED tells the
+// order manager a PENDING_CANCEL order is still working. MODIFIED means the
+// broker took a cancel-replace, whose terms are in order_quantity/order_price;
+// MODIFY_REJECTED means it refused one and the order keeps its old terms.
+enum class ReportType {
+    STATUS,
+    FILL,
+    CANCEL_REJECTED,
+    MODIFIED,
+    MODIFY_REJECTED
+};
+
 struct ExecutionReport {
     uint64_t report_id;
     uint64_t order_id;
+    ReportType type;
+    std::string exec_id;
     std::string symbol;
     OrderStatus new_status;
-    double fill_quantity;
-    double fill_price;
+    Quantity fill_quantity;
+    Price fill_price;
+    Quantity order_quantity;  // MODIFIED only
+    Price order_price;        // MODIFIED only; zero unless a limit order
     std::chrono::system_clock::time_point execution_timestamp;
 
     ExecutionReport() : report_id(0),
                         order_id(0),
+                        type(ReportType::STATUS),
                         new_status(OrderStatus::NEW),
-                        fill_quantity(0.0),
-                        fill_price(0.0),
                         execution_timestamp(std::chrono::system_clock::now()) {}
 };
 
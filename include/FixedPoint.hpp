@@ -0,0 +1,255 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace TradingEngine {
+
+constexpr int64_t pow10_i64(int exponent) {
+    int64_t result = 1;
+    while (exponent-- > 0) result *= 10;
+    return result;
+}
+
+// Signed decimal stored as an integer number of 10^-Decimals units, so sums
+// and comparisons are exact and cost the same as on an int64. The Tag keeps
+// prices and quantities from being mixed up by accident.
+template<typename Tag, int Decimals>
+class FixedPoint {
+public:
+    static constexpr int kDecimals = Decimals;
+    static constexpr int64_t kScale = pow10_i64(Decimals);
+
+    constexpr FixedPoint() = default;
+
+    static constexpr FixedPoint from_raw(int64_t raw) {
+        FixedPoint value;
+        value.m_raw = raw;
+        return value;
+    }
+    static constexpr FixedPoint from_int(int64_t units) { return from_raw(units * kScale); }
+    static FixedPoint from_double(double value) {
+        return from_raw(static_cast<int64_t>(std::llround(value * static_cast<double>(kScale))));
+    }
+
+    // Exact parse of a plain decimal ("-12.345"); digits beyond the scale are
+    // rounded half away from zero. Returns false on anything else.
+    static bool parse(std::string_view text, FixedPoint& out);
+
+    // IB's Decimal is an IEEE 754-2008 BID64. These convert directly between the
+    // bit pattern and the scaled integer, without going through a string.
+    uint64_t to_bid64() const;
+    static bool from_bid64(uint64_t bits, FixedPoint& out);
+
+    constexpr int64_t raw() const { return m_raw; }
+    double to_double() const { return static_cast<double>(m_raw) / static_cast<double>(kScale); }
+    std::string to_string() const;
+
+    constexpr bool is_zero() const { return m_raw == 0; }
+    constexpr bool is_integral() const { return m_raw % kScale == 0; }
+    constexpr int64_t integral_part() const { return m_raw / kScale; }
+
+    constexpr FixedPoint operator-() const { return from_raw(-m_raw); }
+    constexpr FixedPoint operator+(FixedPoint other) const { return from_raw(m_raw + other.m_raw); }
+    constexpr FixedPoint operator-(FixedPoint other) const { return from_raw(m_raw - other.m_raw); }
+    constexpr FixedPoint operator*(int64_t n) const { return from_raw(m_raw * n); }
+    constexpr FixedPoint& operator+=(FixedPoint other) { m_raw += other.m_raw; return *this; }
+    constexpr FixedPoint& operator-=(FixedPoint other) { m_raw -= other.m_raw; return *this; }
+
+    constexpr bool operator==(FixedPoint other) const { return m_raw == other.m_raw; }
+    constexpr bool operator!=(FixedPoint other) const { return m_raw != other.m_raw; }
+    constexpr bool operator<(FixedPoint other) const { return m_raw < other.m_raw; }
+    constexpr bool operator<=(FixedPoint other) const { return m_raw <= other.m_raw; }
+    constexpr bool operator>(FixedPoint other) const { return m_raw > other.m_raw; }
+    constexpr bool operator>=(FixedPoint other) const { return m_raw >= other.m_raw; }
+
+private:
+    int64_t m_raw = 0;
+};
+
+struct PriceTag {};
+struct QuantityTag {};
+
+// 1e-8 covers sub-penny equity, FX and crypto quotes; 1e-4 covers fractional shares.
+using Price = FixedPoint<PriceTag, 8>;
+using Quantity = FixedPoint<QuantityTag, 4>;
+
+// Price * Quantity in 10^-12 units. 128 bits so no realistic notional overflows.
+using Notional = __int128;
+
+inline Notional notional(Price price, Quantity quantity) {
+    return static_cast<Notional>(price.raw()) * quantity.raw();
+}
+
+inline double notional_to_double(Notional value) {
+    return static_cast<double>(value) / (static_cast<double>(Price::kScale) * static_cast<double>(Quantity::kScale));
+}
+
+// Rounds half away from zero.
+inline Notional divide_rounded(Notional numerator, Notional denominator) {
+    Notional quotient = numerator / denominator;
+    Notional remainder = numerator % denominator;
+    if (remainder < 0) remainder = -remainder;
+    if (2 * remainder >= (denominator < 0 ? -denominator : denominator)) {
+        quotient += ((numerator < 0) != (denominator < 0)) ? -1 : 1;
+    }
+    return quotient;
+}
+
+// Volume-weighted average price for a total notional spread over a quantity.
+inline Price average_price(Notional total, Quantity quantity) {
+    if (quantity.is_zero()) {
+        return Price{};
+    }
+    return Price::from_raw(static_cast<int64_t>(divide_rounded(total, quantity.raw())));
+}
+
+template<typename Tag, int Decimals>
+std::ostream& operator<<(std::ostream& os, FixedPoint<Tag, Decimals> value) {
+    return os << value.to_string();
+}
+
+// Minimum price increment per symbol. Filled from config at startup and only
+// read afterwards, so lookups take no lock.
+class TickSizeTable {
+public:
+    TickSizeTable() : m_default_tick(Price::from_raw(Price::kScale / 100)) {}
+
+    static TickSizeTable& instance();
+
+    void set_default(Price tick) { m_default_tick = tick; }
+    void set(const std::string& symbol, Price tick) { m_ticks[symbol] = tick; }
+
+    Price tick_size(const std::string& symbol) const;
+    bool is_on_tick(const std::string& symbol, Price price) const;
+    Price round_to_tick(const std::string& symbol, Price price) const;
+
+private:
+    Price m_default_tick;
+    std::unordered_map<std::string, Price> m_ticks;
+};
+
+template<typename Tag, int Decimals>
+bool FixedPoint<Tag, Decimals>::parse(std::string_view text, FixedPoint& out) {
+    size_t i = 0;
+    bool negative = false;
+    if (i < text.size() && (text[i] == '-' || text[i] == '+')) {
+        negative = text[i] == '-';
+        ++i;
+    }
+    int64_t integral = 0;
+    int64_t fraction = 0;
+    int fraction_digits = 0;
+    bool round_up = false;
+    bool any_digit = false;
+    for (; i < text.size() && text[i] >= '0' && text[i] <= '9'; ++i) {
+        if (integral > (INT64_MAX / kScale - 9) / 10) {
+            return false;
+        }
+        integral = integral * 10 + (text[i] - '0');
+        any_digit = true;
+    }
+    if (i < text.size() && text[i] == '.') {
+        ++i;
+        for (; i < text.size() && text[i] >= '0' && text[i] <= '9'; ++i) {
+            if (fraction_digits < Decimals) {
+                fraction = fraction * 10 + (text[i] - '0');
+                ++fraction_digits;
+            } else if (fraction_digits == Decimals) {
+                round_up = text[i] >= '5';
+                ++fraction_digits;
+            }
+            any_digit = true;
+        }
+    }
+    if (!any_digit || i != text.size()) {
+        return false;
+    }
+    for (int d = fraction_digits; d < Decimals; ++d) {
+        fraction *= 10;
+    }
+    int64_t raw = integral * kScale + fraction + (round_up ? 1 : 0);
+    out = from_raw(negative ? -raw : raw);
+    return true;
+}
+
+template<typename Tag, int Decimals>
+std::string FixedPoint<Tag, Decimals>::to_string() const {
+    uint64_t magnitude = m_raw < 0 ? 0 - static_cast<uint64_t>(m_raw) : static_cast<uint64_t>(m_raw);
+    std::string out = m_raw < 0 ? "-" : "";
+    out += std::to_string(magnitude / kScale);
+    uint64_t fraction = magnitude % kScale;
+    if (fraction != 0) {
+        std::string digits = std::to_string(fraction);
+        digits.insert(0, Decimals - digits.size(), '0');
+        digits.erase(digits.find_last_not_of('0') + 1);
+        out += '.';
+        out += digits;
+    }
+    return out;
+}
+
+namespace bid64 {
+    constexpr int kExponentBias = 398;
+    constexpr uint64_t kMaxCoefficient = 9999999999999999ULL;
+    constexpr uint64_t kSmallCoefficientMask = (uint64_t{1} << 53) - 1;
+    constexpr uint64_t kLargeCoefficientMask = (uint64_t{1} << 51) - 1;
+}
+
+template<typename Tag, int Decimals>
+uint64_t FixedPoint<Tag, Decimals>::to_bid64() const {
+    uint64_t sign = m_raw < 0 ? uint64_t{1} << 63 : 0;
+    uint64_t coefficient = m_raw < 0 ? 0 - static_cast<uint64_t>(m_raw) : static_cast<uint64_t>(m_raw);
+    int exponent = -Decimals;
+    // BID64 holds 16 significant digits; drop trailing precision beyond that.
+    while (coefficient > bid64::kMaxCoefficient) {
+        coefficient = (coefficient + 5) / 10;
+        ++exponent;
+    }
+    uint64_t biased = static_cast<uint64_t>(exponent + bid64::kExponentBias);
+    if (coefficient <= bid64::kSmallCoefficientMask) {
+        return sign | (biased << 53) | coefficient;
+    }
+    return sign | (uint64_t{3} << 61) | (biased << 51) | (coefficient & bid64::kLargeCoefficientMask);
+}
+
+template<typename Tag, int Decimals>
+bool FixedPoint<Tag, Decimals>::from_bid64(uint64_t bits, FixedPoint& out) {
+    bool negative = (bits >> 63) != 0;
+    uint64_t coefficient;
+    int exponent;
+    if (((bits >> 61) & 3) == 3) {
+        if (((bits >> 59) & 3) == 3) {
+            return false;  // infinity or NaN (IB's UNSET_DECIMAL is a NaN)
+        }
+        exponent = static_cast<int>((bits >> 51) & 0x3FF);
+        coefficient = (bits & bid64::kLargeCoefficientMask) | (uint64_t{1} << 53);
+        if (coefficient > bid64::kMaxCoefficient) {
+            coefficient = 0;  // non-canonical encodings are zero by definition
+        }
+    } else {
+        exponent = static_cast<int>((bits >> 53) & 0x3FF);
+        coefficient = bits & bid64::kSmallCoefficientMask;
+    }
+    int shift = exponent - bid64::kExponentBias + Decimals;
+    int64_t raw;
+    if (shift >= 0) {
+        if (shift > 18 || coefficient > static_cast<uint64_t>(INT64_MAX / pow10_i64(shift))) {
+            return false;
+        }
+        raw = static_cast<int64_t>(coefficient) * pow10_i64(shift);
+    } else if (-shift > 18) {
+        raw = 0;
+    } else {
+        uint64_t divisor = static_cast<uint64_t>(pow10_i64(-shift));
+        raw = static_cast<int64_t>((coefficient + divisor / 2) / divisor);
+    }
+    out = from_raw(negative ? -raw : raw);
+    return true;
+}
+
+}
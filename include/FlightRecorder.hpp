@@ -0,0 +1,265 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#else
+#include <time.h>
+#endif
+
+namespace TradingEngine {
+
+// Always-on crash recorder. Each thread that records gets a fixed ring of the
+// last N records (events handled, commands received, gateway messages in and
+// out), overwritten oldest first. Recording is a TSC read and a 32-byte store
+// into a thread-local ring: no locks, no allocation, no formatting. The rings
+// are written to disk on a crash signal, on SIGINT and on request, and
+// tools/flight_decode prints them.
+
+enum class FlightKind : uint8_t {
+    EVENT,        // code: EventType, dequeued by the event loop or a shard
+    COMMAND,      // text: the command topic, as received from a strategy
+    GATEWAY_IN,   // code: FlightGatewayMessage
+    GATEWAY_OUT   // code: FlightGatewayMessage
+};
+
+enum class FlightGatewayMessage : uint8_t {
+    TICK_PRICE,    // a: price raw
+    ORDER_STATUS,  // a: order id, b: OrderStatus
+    EXECUTION,     // a: order id, b: quantity raw
+    ERROR,         // a: request id, b: error code
+    PLACE_ORDER,   // a: order id, b: quantity raw
+    CANCEL_ORDER   // a: order id
+};
+
+inline const char* flight_kind_to_string(FlightKind kind) {
+    switch (kind) {
+        case FlightKind::EVENT: return "EVENT";
+        case FlightKind::COMMAND: return "COMMAND";
+        case FlightKind::GATEWAY_IN: return "GATEWAY_IN";
+        case FlightKind::GATEWAY_OUT: return "GATEWAY_OUT";
+        default: return "UNKNOWN";
+    }
+}
+
+inline const char* flight_gateway_message_to_string(FlightGatewayMessage message) {
+    switch (message) {
+        case FlightGatewayMessage::TICK_PRICE: return "TICK_PRICE";
+        case FlightGatewayMessage::ORDER_STATUS: return "ORDER_STATUS";
+        case FlightGatewayMessage::EXECUTION: return "EXECUTION";
+        case FlightGatewayMessage::ERROR: return "ERROR";
+        case FlightGatewayMessage::PLACE_ORDER: return "PLACE_ORDER";
+        case FlightGatewayMessage::CANCEL_ORDER: return "CANCEL_ORDER";
+        default: return "UNKNOWN";
+    }
+}
+
+struct FlightRecord {
+    uint64_t ticks;  // TSC (x86) or monotonic ns; the dump header maps it to wall time
+    FlightKind kind;
+    uint8_t code;
+    uint16_t flags;  // kind-specific, e.g. the side of an order
+    uint32_t symbol_id;
+    uint64_t a;
+    uint64_t b;
+};
+static_assert(sizeof(FlightRecord) == 32, "two FlightRecords per cache line");
+
+// Dump layout (native byte order):
+//   FlightDumpHeader
+//   symbol_count x { u16 len, name bytes }     (ids 1..symbol_count)
+//   ring_count x {
+//     FlightRingHeader
+//     record_count x FlightRecord, oldest first (sequence numbers first_sequence...)
+//     u64 head after the records were written
+//   }
+// Threads keep recording while a ring is written, so records whose sequence
+// number is below (trailing head - capacity) may have been overwritten mid-copy
+// and must be discarded.
+constexpr char kFlightDumpMagic[8] = {'T', 'E', 'F', 'L', 'I', 'G', 'H', 'T'};
+constexpr uint32_t kFlightDumpVersion = 1;
+
+struct FlightDumpHeader {
+    char magic[8];
+    uint32_t version;
+    int32_t signal;  // 0 when dumped on request
+    uint64_t wall_ns;     // realtime clock at the dump
+    uint64_t ticks;       // record clock at the dump
+    double ns_per_tick;
+    uint32_t symbol_count;
+    uint32_t ring_count;
+};
+
+struct FlightRingHeader {
+    char thread_name[16];
+    uint32_t thread_id;
+    uint32_t capacity;
+    uint64_t first_sequence;
+    uint64_t record_count;
+};
+
+class FlightRecorder {
+public:
+    static constexpr size_t kMaxThreads = 128;
+
+    FlightRecorder(const FlightRecorder&) = delete;
+    FlightRecorder& operator=(const FlightRecorder&) = delete;
+
+    // Turns recording on. records_per_thread rounds up to a power of two.
+    // Dumps go to <directory>/flight-<unix ms>-<signal>.rec.
+    static bool enable(const std::string& directory, size_t records_per_thread = 4096);
+    static bool enabled() { return s_enabled.load(std::memory_order_relaxed); }
+
+    static void record(FlightKind kind, uint8_t code, uint32_t symbol_id = 0, uint64_t a = 0, uint64_t b = 0,
+                       uint16_t flags = 0) {
+        if (!enabled()) {
+            return;
+        }
+        Ring* ring = t_ring ? t_ring : attach();
+        if (!ring) {
+            return;
+        }
+        uint64_t head = ring->head.load(std::memory_order_relaxed);
+        FlightRecord& slot = ring->records[head & ring->mask];
+        slot.ticks = ticks();
+        slot.kind = kind;
+        slot.code = code;
+        slot.flags = flags;
+        slot.symbol_id = symbol_id;
+        slot.a = a;
+        slot.b = b;
+        ring->head.store(head + 1, std::memory_order_release);
+    }
+
+    // Records up to 16 bytes of text in a and b (a command topic, say).
+    static void record_text(FlightKind kind, std::string_view text) {
+        if (!enabled()) {
+            return;
+        }
+        uint64_t words[2] = {0, 0};
+        std::memcpy(words, text.data(), std::min(text.size(), sizeof(words)));
+        record(kind, 0, 0, words[0], words[1]);
+    }
+
+    // Dumps the rings on SIGSEGV, SIGBUS, SIGFPE, SIGILL and SIGABRT, then lets
+    // the signal take its default action. Recording threads get an alternate
+    // signal stack, so a stack overflow is caught too.
+    static void install_crash_handlers();
+    // Async-signal-safe; for use from a signal handler. Returns whether a file
+    // was written.
+    static bool dump_from_signal(int signal);
+    // Dumps now; returns the file written, or "" on failure.
+    static std::string dump();
+
+    static uint64_t ticks() {
+#if defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#else
+        timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return static_cast<uint64_t>(ts.tv_sec) * 1000000000ull + static_cast<uint64_t>(ts.tv_nsec);
+#endif
+    }
+
+private:
+    FlightRecorder() = default;
+
+    // Written only by its thread; read by whoever dumps. A ring whose thread
+    // has exited is handed to the next new thread, from sequence start on.
+    struct Ring {
+        FlightRecord* records = nullptr;
+        uint64_t mask = 0;
+        std::atomic<uint64_t> head{0};
+        std::atomic<uint64_t> start{0};
+        std::atomic<bool> in_use{false};
+        char thread_name[16] = {};
+        uint32_t thread_id = 0;
+    };
+
+    struct Registry;
+    static Registry& registry();
+    static Ring* attach();
+    // The dump itself; async-signal-safe. path receives the file name.
+    static bool write_dump(int signal, char* path, size_t path_size);
+
+    inline static std::atomic<bool> s_enabled{false};
+    inline static thread_local Ring* t_ring = nullptr;
+};
+
+// A dump read back, with possibly-overwritten records already discarded.
+struct FlightDump {
+    struct Thread {
+        std::string name;
+        uint32_t thread_id = 0;
+        uint64_t first_sequence = 0;
+        std::vector<FlightRecord> records;
+    };
+
+    FlightDumpHeader header{};
+    std::vector<std::string> symbols;  // symbols[id - 1]
+    std::vector<Thread> threads;
+
+    // Wall time of a record, in ns since the epoch.
+    uint64_t wall_ns(const FlightRecord& record) const {
+        double behind = static_cast<double>(static_cast<int64_t>(header.ticks - record.ticks)) * header.ns_per_tick;
+        return header.wall_ns - static_cast<int64_t>(behind);
+    }
+
+    std::string symbol(uint32_t id) const {
+        return id >= 1 && id <= symbols.size() ? symbols[id - 1] : std::string();
+    }
+};
+
+inline bool read_flight_dump(const std::string& path, FlightDump& dump) {
+    std::ifstream in(path, std::ios::binary);
+    auto get = [&in](auto& value) {
+        return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(value)));
+    };
+    if (!get(dump.header) || std::memcmp(dump.header.magic, kFlightDumpMagic, sizeof(kFlightDumpMagic)) != 0 ||
+        dump.header.version != kFlightDumpVersion) {
+        return false;
+    }
+    dump.symbols.resize(dump.header.symbol_count);
+    for (auto& symbol : dump.symbols) {
+        uint16_t len = 0;
+        if (!get(len)) {
+            return false;
+        }
+        symbol.resize(len);
+        if (!in.read(symbol.data(), len)) {
+            return false;
+        }
+    }
+    dump.threads.resize(dump.header.ring_count);
+    for (auto& thread : dump.threads) {
+        FlightRingHeader ring;
+        if (!get(ring)) {
+            return false;
+        }
+        thread.name.assign(ring.thread_name, strnlen(ring.thread_name, sizeof(ring.thread_name)));
+        thread.thread_id = ring.thread_id;
+        std::vector<FlightRecord> records(ring.record_count);
+        uint64_t head_after = 0;
+        if (!in.read(reinterpret_cast<char*>(records.data()), records.size() * sizeof(FlightRecord)) ||
+            !get(head_after)) {
+            return false;
+        }
+        uint64_t valid_from = head_after > ring.capacity ? head_after - ring.capacity : 0;
+        size_t skip = valid_from > ring.first_sequence
+                          ? static_cast<size_t>(std::min<uint64_t>(valid_from - ring.first_sequence, records.size()))
+                          : 0;
+        thread.first_sequence = ring.first_sequence + skip;
+        thread.records.assign(records.begin() + skip, records.end());
+    }
+    return true;
+}
+
+}
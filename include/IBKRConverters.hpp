@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Order.hpp"
+#include "ContractCache.hpp"
 #include "Order.h"
 #include "Contract.h"
 #include "Decimal.h" 
@@ -8,26 +9,55 @@
 
 namespace TradingEngine {
 
-    inline ::Contract convert_to_ibkr_contract(const TradingEngine::Order& order) {
+    // A resolved contract is addressed by conId; the rest is informational.
+    inline ::Contract convert_to_ibkr_contract(const ContractInfo& info) {
         ::Contract contract;
-        contract.symbol = order.symbol;
+        contract.conId = info.con_id;
+        contract.symbol = info.symbol;
+        contract.secType = info.sec_type;
+        contract.exchange = info.exchange;
+        contract.primaryExchange = info.primary_exchange;
+        contract.currency = info.currency;
+        return contract;
+    }
+
+    // Unresolved symbols fall back to the default US stock description.
+    inline ::Contract convert_to_ibkr_contract(const std::string& symbol) {
+        ::Contract contract;
+        contract.symbol = symbol;
         contract.secType = "STK";
         contract.exchange = "SMART";
         contract.currency = "USD";
         return contract;
     }
 
+    inline ::Contract convert_to_ibkr_contract(const TradingEngine::Order& order) {
+        if (const ContractInfo* info = ContractCache::instance().lookup(order.symbol_id)) {
+            return convert_to_ibkr_contract(*info);
+        }
+        return convert_to_ibkr_contract(order.symbol);
+    }
+
     inline ::Order convert_to_ibkr_order(const TradingEngine::Order& order) {
         ::Order ibkr_order;
         ibkr_order.action = (order.side == TradingEngine::Side::BUY) ? "BUY" : "SELL";
         
-        ibkr_order.totalQuantity = DecimalFunctions::stringToDecimal(std::to_string(static_cast<long long>(order.quantity)));
-        
+        ibkr_order.totalQuantity = order.quantity.to_bid64();
+
         ibkr_order.orderType = (order.order_type == TradingEngine::OrderType::MARKET) ? "MKT" : "LMT";
         if (order.order_type == TradingEngine::OrderType::LIMIT) {
-            ibkr_order.lmtPrice = order.price;
+            ibkr_order.lmtPrice = order.price.to_double();
         }
         return ibkr_order;
     }
 
+    // Decodes the BID64 bits directly; unset (NaN) or out-of-range values map to zero.
+    inline Quantity convert_from_ibkr_decimal(Decimal value) {
+        Quantity quantity;
+        if (!Quantity::from_bid64(value, quantity)) {
+            return Quantity{};
+        }
+        return quantity;
+    }
+
 } // namespace TradingEngine
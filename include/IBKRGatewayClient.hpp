@@ -5,12 +5,23 @@
 #include "EReaderOSSignal.h"
 #include "I_MarketDataHandler.hpp"
 #include "EReader.h"
+#include "ContractCache.hpp"
+#include "SubscriptionManager.hpp"
+#include "OutboundScheduler.hpp"
+#include "ReconnectSupervisor.hpp"
+#include "BrokerSnapshot.hpp"
+#include "ExecutionReport.hpp"
+#include "Stats.hpp"
 #include <memory>
 #include <future>
 #include <atomic>
 #include <thread>
 #include <string>
 #include <map>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
 
 namespace TradingEngine {
 class EngineCore;
@@ -32,15 +43,89 @@ public:
     void set_engine_core(EngineCore* engine_core);
     void request_market_data(TickerId tickerId, const Contract& contract);
     void place_order(OrderId orderId, const Contract& contract, const ::Order& order);
-    void subscribe_to_market_data(const std::string& topic);
+    // A placeOrder on a live id, which IB treats as cancel-replace. Its answer
+    // is posted as a MODIFIED or MODIFY_REJECTED report.
+    void modify_order(OrderId orderId, const Contract& contract, const ::Order& order);
+    // Goes ahead of queued new orders, unless that order's own placeOrder is
+    // still queued: then it follows it, so IB never sees the cancel first.
+    void cancel_order(OrderId orderId);
+    // Topics are "<DATA_TYPE>.<SYMBOL>", e.g. "TICK.AAPL". Engine thread only.
+    void subscribe_to_market_data(const std::string& topic, const std::string& subscriber = "");
+    void unsubscribe_from_market_data(const std::string& topic, const std::string& subscriber = "");
+    void set_market_data_line_limit(size_t line_limit);
+    void set_outbound_config(const OutboundScheduler::Config& config);
+    // Direct: one thread epolls the socket and decodes in place. Threaded: the
+    // EReader thread reads and queues, the gateway thread decodes. Before connect().
+    void set_direct_reader(bool direct);
+    void set_reconnect_config(const ReconnectSupervisor::Config& config, std::chrono::milliseconds connect_timeout);
+    // Engine thread: replays subscriptions and reconciles orders after a reconnect.
+    void on_connection_state(const ConnectionStatus& status);
     
     void request_historical_data(const std::string& symbol, const std::string& end_date_time, const std::string& duration, const std::string& bar_size);
+    // A stream dropped because its contract could not be resolved.
+    struct FailedSubscription {
+        std::string topic;
+        std::vector<std::string> subscribers;
+    };
+    // Engine thread: runs the requests that were parked waiting on this
+    // contract. If it failed, its unopened streams are dropped (freeing their
+    // lines, so a later SUBSCRIBE retries) and returned for the caller to report.
+    std::vector<FailedSubscription> on_contract_resolved(const ContractResolution& resolution);
 
     void historicalData(TickerId reqId, const ::Bar& bar) override;
     void historicalDataEnd(int reqId, const std::string& startDateStr, const std::string& endDateStr) override;
 
 private:
+    using ContractAction = std::function<void(const Contract&)>;
+
+    // What a modify asked for, to recognise IB's openOrder echo of it.
+    struct ModifyTerms {
+        Quantity quantity;
+        Price price;
+        bool has_price = false;
+    };
+
+    struct Reconciliation {
+        bool active = false;
+        int executions_request = -1;
+        bool orders_done = false;
+        bool executions_done = false;
+        bool positions_done = false;
+        BrokerSnapshot snapshot;
+    };
+
     void process_messages();
+    // One socket session: connect and wait for nextValidId / tear it all down.
+    bool open_session();
+    void close_session();
+    void resolve_connection(bool acknowledged);
+    void post_connection_state(const ConnectionStatus& status);
+    void resynchronize();
+    void request_reconciliation();
+    void finish_reconciliation_locked();
+    void open_stream(const std::string& symbol, const std::string& data_type);
+    void request_contract_details(SymbolId symbol_id);
+    // Runs action with the cached contract, or parks it and resolves the symbol first.
+    void with_contract(const std::string& symbol, ContractAction action);
+    void post_contract_resolution(SymbolId symbol_id, bool resolved);
+    // Drops one queued placeOrder for the id once it is sent (or discarded).
+    void forget_queued_order(OrderId orderId);
+    void post_execution_report(const ExecutionReport& report);
+    static bool split_topic(const std::string& topic, std::string& data_type, std::string& symbol);
+    void update_line_gauges();
+
+    // Ticker ids are handed out sequentially, so a ring of slots maps an id to
+    // its symbol without a lock on the reader thread's tick path. The counter
+    // is shared with other request ids, so after a wrap an id can land on a
+    // slot a live stream still holds: allocate_ticker_id() skips those, which
+    // keeps each slot owned by one stream and lets its owner clear it.
+    static constexpr size_t kTickerSlots = 1 << 16;
+    // Engine thread. -1 if every slot is taken.
+    TickerId allocate_ticker_id();
+    static constexpr int kDirectReaderTimeoutMs = 100;
+    SymbolId ticker_symbol(TickerId ticker_id) const {
+        return m_ticker_symbols[static_cast<size_t>(ticker_id) % kTickerSlots].load(std::memory_order_acquire);
+    }
     void tickPrice(TickerId tickerId, TickType field, double price, const TickAttrib& attrib) override;
     void tickSize(TickerId tickerId, TickType field, Decimal size) override;
     void tickOptionComputation(TickerId tickerId, TickType tickType, int tickAttrib, double impliedVol, double delta, double optPrice, double pvDividend, double gamma, double vega, double theta, double undPrice) override;
@@ -130,13 +215,20 @@ private:
     void userInfo(int reqId, const std::string& whiteBrandingId) override;
 
 private:
+    std::mutex m_connection_mutex;
     std::promise<void> m_connection_promise;
+    bool m_connection_resolved = false;
     std::atomic<bool> m_is_connection_acknowledged;
+    std::atomic<bool> m_closing{false};
+    std::chrono::milliseconds m_connect_timeout{10000};
+    ReconnectSupervisor::Config m_reconnect_config;
+    std::unique_ptr<ReconnectSupervisor> m_supervisor;
     std::unique_ptr<EClientSocket> m_client;
     EReaderOSSignal m_signal;
     std::unique_ptr<EReader> m_reader;
     std::thread m_reader_thread;
-    std::map<TickerId, std::string> m_ticker_id_to_symbol;
+    bool m_direct_reader = false;
+    std::unique_ptr<std::atomic<SymbolId>[]> m_ticker_symbols;
     std::string m_host;
     int m_port;
     int m_client_id;
@@ -145,6 +237,31 @@ private:
     OrderId m_next_valid_id;
     std::atomic<TickerId> m_next_ticker_id;
     std::atomic<bool> m_is_connected;
+
+    // Engine thread only.
+    std::unordered_map<SymbolId, std::vector<ContractAction>> m_pending_contract_actions;
+    SubscriptionManager m_subscriptions;
+    Gauge& m_lines_in_use;
+    Gauge& m_line_limit;
+    // Every outbound EClient request goes through here, paced and prioritised.
+    std::unique_ptr<OutboundScheduler> m_outbound;
+    // placeOrder calls submitted but not yet sent, per order id.
+    std::mutex m_queued_orders_mutex;
+    std::unordered_map<OrderId, int> m_queued_orders;
+    // Orders whose placeOrder was dropped while disconnected; handed to the next reconciliation.
+    std::vector<uint64_t> m_unsent_orders;
+    // Modifies sent and not yet answered, latest per order id.
+    std::mutex m_modifies_mutex;
+    std::unordered_map<OrderId, ModifyTerms> m_modifies;
+    // Shared with the reader thread: contract-details reqId -> symbol, and the first match per request.
+    std::mutex m_contract_request_mutex;
+    std::unordered_map<int, SymbolId> m_contract_requests;
+    std::unordered_map<int, ContractInfo> m_contract_results;
+    // Reader thread fills this in after a reconnect; posted once all three parts end.
+    std::mutex m_reconcile_mutex;
+    Reconciliation m_reconcile;
+    Gauge& m_connected_gauge;
+    Counter& m_reconnects;
 };
 
 }
@@ -0,0 +1,275 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace TradingEngine {
+
+// What a full lane does with one more item.
+enum class OverflowPolicy {
+    BLOCK,        // producer waits for room (falls back to REJECT when it may not block)
+    DROP_OLDEST,  // discard the lane's oldest item
+    CONFLATE,     // overwrite the queued item with the same key; else drop the oldest
+    REJECT        // discard the new item
+};
+
+inline bool overflow_policy_from_string(const std::string& name, OverflowPolicy& policy) {
+    if (name == "block") policy = OverflowPolicy::BLOCK;
+    else if (name == "drop_oldest") policy = OverflowPolicy::DROP_OLDEST;
+    else if (name == "conflate") policy = OverflowPolicy::CONFLATE;
+    else if (name == "reject") policy = OverflowPolicy::REJECT;
+    else return false;
+    return true;
+}
+
+struct LaneConfig {
+    size_t capacity = 4096;
+    OverflowPolicy policy = OverflowPolicy::BLOCK;
+};
+
+// Running totals of what overflow cost a lane.
+struct LaneOverload {
+    uint64_t dropped = 0;
+    uint64_t conflated = 0;
+    uint64_t rejected = 0;
+    uint64_t blocked = 0;
+};
+
+// Blocking queue with Lanes bounded FIFO lanes in strict priority order: lane
+// 0 is always popped first. Within a lane, order is preserved. So that a busy
+// high-priority lane cannot starve the rest, a lane that has been passed over
+// starvation_limit times while non-empty gets the next pop (0 turns this off).
+//
+// Each lane is a ring allocated by configure(); push and pop never allocate.
+template<typename T, size_t Lanes>
+class LaneQueue {
+public:
+    static constexpr size_t kLanes = Lanes;
+
+    // Conflation key of an item, 0 for none. Keys at or above the key space
+    // passed to configure() are not conflated.
+    using KeyFn = uint32_t (*)(const T&);
+
+    explicit LaneQueue(size_t starvation_limit = 64) : m_starvation_limit(starvation_limit) {
+        configure(std::array<LaneConfig, Lanes>{});
+    }
+    LaneQueue(const LaneQueue&) = delete;
+    LaneQueue& operator=(const LaneQueue&) = delete;
+
+    // Sizes every lane (capacity rounds up to a power of two). Call before
+    // producers start; anything still queued is discarded.
+    void configure(const std::array<LaneConfig, Lanes>& configs, KeyFn key_fn = nullptr, size_t key_space = 0) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_key_fn = key_fn;
+        m_key_space = key_fn ? key_space : 0;
+        for (size_t i = 0; i < Lanes; ++i) {
+            Lane& lane = m_lanes[i];
+            size_t capacity = 1;
+            while (capacity < configs[i].capacity) {
+                capacity <<= 1;
+            }
+            lane.policy = configs[i].policy;
+            lane.mask = capacity - 1;
+            lane.slots = std::make_unique<T[]>(capacity);
+            lane.head = lane.tail = 0;
+            lane.latest.assign(lane.policy == OverflowPolicy::CONFLATE ? m_key_space : 0, 0);
+            m_lane_sizes[i].store(0, std::memory_order_relaxed);
+        }
+        m_size.store(0, std::memory_order_relaxed);
+    }
+
+    // Returns false if the item was not queued (REJECT, a BLOCK lane pushed
+    // with may_block false, or a closed queue that is full).
+    bool push(size_t lane_index, T item, bool may_block = true) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        Lane& lane = m_lanes[lane_index];
+        uint32_t key = lane.latest.empty() ? 0 : m_key_fn(item);
+        if (key >= lane.latest.size()) {
+            key = 0;
+        }
+        if (lane.full()) {
+            switch (lane.policy) {
+                case OverflowPolicy::BLOCK:
+                    if (!may_block || m_closed) {
+                        ++lane.overload.rejected;
+                        return false;
+                    }
+                    ++lane.overload.blocked;
+                    ++m_blocked_producers;
+                    m_not_full.wait(lock, [&lane, this] { return !lane.full() || m_closed; });
+                    --m_blocked_producers;
+                    if (lane.full()) {
+                        ++lane.overload.rejected;
+                        return false;
+                    }
+                    break;
+                case OverflowPolicy::CONFLATE:
+                    if (key != 0) {
+                        uint64_t position = lane.latest[key];
+                        if (position != 0 && position - 1 >= lane.head) {
+                            lane.slots[(position - 1) & lane.mask] = std::move(item);
+                            ++lane.overload.conflated;
+                            return true;
+                        }
+                    }
+                    lane.drop_oldest();
+                    break;
+                case OverflowPolicy::DROP_OLDEST:
+                    lane.drop_oldest();
+                    break;
+                case OverflowPolicy::REJECT:
+                    ++lane.overload.rejected;
+                    return false;
+            }
+        }
+        if (key != 0) {
+            lane.latest[key] = lane.tail + 1;
+        }
+        lane.slots[lane.tail & lane.mask] = std::move(item);
+        ++lane.tail;
+        m_lane_sizes[lane_index].store(lane.size(), std::memory_order_relaxed);
+        m_size.store(total_locked(), std::memory_order_relaxed);
+        m_cond_var.notify_one();
+        return true;
+    }
+
+    void wait_and_pop(T& item) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_cond_var.wait(lock, [this]{ return m_size.load(std::memory_order_relaxed) != 0; });
+        pop_locked(item);
+    }
+
+    template<typename Rep, typename Period>
+    bool wait_and_pop_for(T& item, const std::chrono::duration<Rep, Period>& timeout) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (!m_cond_var.wait_for(lock, timeout, [this]{ return m_size.load(std::memory_order_relaxed) != 0; })) {
+            return false;
+        }
+        pop_locked(item);
+        return true;
+    }
+
+    bool try_pop(T& item) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_size.load(std::memory_order_relaxed) == 0) {
+            return false;
+        }
+        pop_locked(item);
+        return true;
+    }
+
+    // The consumer is gone: wake blocked producers and never block again.
+    void close() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_closed = true;
+        m_not_full.notify_all();
+    }
+
+    void set_starvation_limit(size_t limit) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_starvation_limit = limit;
+    }
+
+    LaneOverload overload(size_t lane) const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_lanes[lane].overload;
+    }
+
+    size_t capacity(size_t lane) const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_lanes[lane].mask + 1;
+    }
+
+    // Lock-free approximate depths, for gauges.
+    size_t size() const {
+        return m_size.load(std::memory_order_relaxed);
+    }
+
+    size_t size(size_t lane) const {
+        return m_lane_sizes[lane].load(std::memory_order_relaxed);
+    }
+
+private:
+    struct Lane {
+        std::unique_ptr<T[]> slots;
+        size_t mask = 0;
+        uint64_t head = 0;  // positions only grow; slot = position & mask
+        uint64_t tail = 0;
+        OverflowPolicy policy = OverflowPolicy::BLOCK;
+        // CONFLATE lanes: key -> position + 1 of its newest queued item.
+        std::vector<uint64_t> latest;
+        LaneOverload overload;
+
+        size_t size() const { return static_cast<size_t>(tail - head); }
+        bool empty() const { return head == tail; }
+        bool full() const { return size() > mask; }
+        void drop_oldest() {
+            slots[head & mask] = T{};
+            ++head;
+            ++overload.dropped;
+        }
+    };
+
+    size_t total_locked() const {
+        size_t total = 0;
+        for (const Lane& lane : m_lanes) {
+            total += lane.size();
+        }
+        return total;
+    }
+
+    void pop_locked(T& item) {
+        size_t index = Lanes;
+        if (m_starvation_limit > 0) {
+            for (size_t i = 1; i < Lanes; ++i) {
+                if (!m_lanes[i].empty() && m_passed_over[i] >= m_starvation_limit) {
+                    index = i;
+                    break;
+                }
+            }
+        }
+        if (index == Lanes) {
+            index = 0;
+            while (m_lanes[index].empty()) {
+                ++index;
+            }
+        }
+        for (size_t i = index + 1; i < Lanes; ++i) {
+            if (!m_lanes[i].empty()) {
+                ++m_passed_over[i];
+            }
+        }
+        m_passed_over[index] = 0;
+        Lane& lane = m_lanes[index];
+        item = std::move(lane.slots[lane.head & lane.mask]);
+        ++lane.head;
+        m_lane_sizes[index].store(lane.size(), std::memory_order_relaxed);
+        m_size.store(m_size.load(std::memory_order_relaxed) - 1, std::memory_order_relaxed);
+        if (m_blocked_producers > 0) {
+            m_not_full.notify_all();
+        }
+    }
+
+    std::array<Lane, Lanes> m_lanes;
+    std::array<size_t, Lanes> m_passed_over{};
+    std::array<std::atomic<size_t>, Lanes> m_lane_sizes{};
+    std::atomic<size_t> m_size{0};
+    size_t m_starvation_limit;
+    KeyFn m_key_fn = nullptr;
+    size_t m_key_space = 0;
+    size_t m_blocked_producers = 0;
+    bool m_closed = false;
+    mutable std::mutex m_mutex;
+    std::condition_variable m_cond_var;
+    std::condition_variable m_not_full;
+};
+
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "Tick.hpp"
+#include "Bar.hpp"
+#include "SymbolTable.hpp"
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace TradingEngine {
+
+// The latest tick and bar per symbol and the latest report of every working
+// order, kept whether or not anyone is subscribed so a late joiner can be sent
+// a snapshot. Ticks are stored per symbol id under a sequence lock: recording
+// one is a handful of relaxed stores and never blocks the shard publishing it.
+class LastValueCache {
+public:
+    LastValueCache();
+
+    void record_tick(const Tick& tick) {
+        SymbolId id = tick.symbol_id != kInvalidSymbolId ? tick.symbol_id : SymbolTable::instance().find(tick.symbol);
+        if (id == kInvalidSymbolId || id > SymbolTable::kMaxSymbols) {
+            return;
+        }
+        TickSlot& slot = m_ticks[id];
+        // Each symbol has one publishing shard, so this rarely spins; the CAS
+        // only keeps two writers from interleaving if that ever changes.
+        uint64_t sequence = slot.sequence.load(std::memory_order_relaxed);
+        while ((sequence & 1) ||
+               !slot.sequence.compare_exchange_weak(sequence, sequence + 1, std::memory_order_acquire)) {
+            sequence = slot.sequence.load(std::memory_order_relaxed);
+        }
+        slot.price.store(tick.price.raw(), std::memory_order_relaxed);
+        slot.size.store(tick.size.raw(), std::memory_order_relaxed);
+        slot.timestamp.store(tick.timestamp.time_since_epoch().count(), std::memory_order_relaxed);
+        slot.sequence.store(sequence + 2, std::memory_order_release);
+    }
+
+    // False if no tick has been recorded for the symbol.
+    bool last_tick(SymbolId id, Tick& out) const;
+
+    void record_bar(const Bar& bar);
+
+    // payload is the order's report as it should be replayed; open is false
+    // once the order is done, which drops it.
+    void record_order(uint64_t order_id, const std::string& topic, std::string payload, bool open);
+
+    // Calls fn(const Bar&) for every symbol's latest bar.
+    template <typename Fn>
+    void for_each_bar(Fn&& fn) const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (const auto& [symbol, bar] : m_bars) {
+            fn(bar);
+        }
+    }
+
+    // Calls fn(topic, payload) for every working order, oldest id first.
+    template <typename Fn>
+    void for_each_open_order(Fn&& fn) const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (const auto& [order_id, order] : m_orders) {
+            fn(order.topic, order.payload);
+        }
+    }
+
+private:
+    struct alignas(64) TickSlot {
+        std::atomic<uint64_t> sequence{0};  // odd while being written; 0 until the first tick
+        std::atomic<int64_t> price{0};
+        std::atomic<int64_t> size{0};
+        std::atomic<int64_t> timestamp{0};
+    };
+
+    struct OpenOrder {
+        std::string topic;
+        std::string payload;
+    };
+
+    std::unique_ptr<TickSlot[]> m_ticks;  // indexed by SymbolId
+
+    mutable std::mutex m_mutex;
+    std::map<std::string, Bar> m_bars;
+    std::map<uint64_t, OpenOrder> m_orders;
+};
+
+}
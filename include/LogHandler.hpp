@@ -3,6 +3,9 @@
 #include <spdlog/spdlog.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
 #include <spdlog/sinks/basic_file_sink.h>
+#include <spdlog/async.h>
+#include <atomic>
+#include <chrono>
 #include <memory>
 #include <vector>
 #include <iostream> 
@@ -12,7 +15,11 @@ public:
     LogHandler(const LogHandler&) = delete;
     LogHandler& operator=(const LogHandler&) = delete;
 
-    static void initialize(const std::string& log_file_path = "engine.log") {
+    // In async mode records are handed to a single spdlog worker thread through a
+    // preallocated queue; when it is full the oldest entry is overwritten so the
+    // caller never blocks on file or console I/O.
+    static void initialize(const std::string& log_file_path = "engine.log", bool async = false,
+                           size_t queue_size = 8192) {
         if (get_instance().m_initialized) {
             return;
         }
@@ -20,29 +27,59 @@ public:
         try {
             std::vector<spdlog::sink_ptr> sinks;
             
-            auto console_sink = std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
+            // A single worker thread owns the sinks in async mode, so they need no locking.
+            spdlog::sink_ptr console_sink;
+            spdlog::sink_ptr file_sink;
+            if (async) {
+                console_sink = std::make_shared<spdlog::sinks::stdout_color_sink_st>();
+                file_sink = std::make_shared<spdlog::sinks::basic_file_sink_st>(log_file_path, true);
+            } else {
+                console_sink = std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
+                file_sink = std::make_shared<spdlog::sinks::basic_file_sink_mt>(log_file_path, true);
+            }
             console_sink->set_level(spdlog::level::trace);
             sinks.push_back(console_sink);
 
-            auto file_sink = std::make_shared<spdlog::sinks::basic_file_sink_mt>(log_file_path, true);
             file_sink->set_level(spdlog::level::info);
             sinks.push_back(file_sink);
 
-            get_instance().m_logger = std::make_shared<spdlog::logger>("engine_logger", begin(sinks), end(sinks));
+            if (async) {
+                spdlog::init_thread_pool(queue_size, 1);
+                get_instance().m_logger = std::make_shared<spdlog::async_logger>(
+                    "engine_logger", begin(sinks), end(sinks), spdlog::thread_pool(),
+                    spdlog::async_overflow_policy::overrun_oldest);
+            } else {
+                get_instance().m_logger = std::make_shared<spdlog::logger>("engine_logger", begin(sinks), end(sinks));
+            }
             
             get_instance().m_logger->set_level(spdlog::level::trace);
+            get_instance().m_logger->flush_on(spdlog::level::err);
             spdlog::register_logger(get_instance().m_logger);
             
             spdlog::set_default_logger(get_instance().m_logger);
+            if (async) {
+                spdlog::flush_every(std::chrono::seconds(1));
+            }
 
             get_instance().m_initialized = true;
-            spdlog::info("LogHandler initialized successfully.");
+            spdlog::info("LogHandler initialized successfully ({} mode).", async ? "async" : "sync");
 
         } catch (const spdlog::spdlog_ex& ex) {
             std::cerr << "Log initialization failed: " << ex.what() << std::endl;
         }
     }
 
+    // Flushes pending records and stops the async worker, if any.
+    static void shutdown() {
+        if (!get_instance().m_initialized) {
+            return;
+        }
+        get_instance().m_logger->flush();
+        spdlog::shutdown();
+        get_instance().m_logger.reset();
+        get_instance().m_initialized = false;
+    }
+
 private:
     LogHandler() : m_initialized(false) {}
 
@@ -54,3 +91,41 @@ private:
     bool m_initialized;
     std::shared_ptr<spdlog::logger> m_logger;
 };
+
+// Lets through at most `per_second` calls per wall-clock second; the rest are
+// discarded without formatting. Shared by all threads hitting the same site.
+class LogRateLimiter {
+public:
+    explicit LogRateLimiter(uint32_t per_second) : m_limit(per_second) {}
+
+    bool allow() {
+        int64_t now = std::chrono::duration_cast<std::chrono::seconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+        int64_t window = m_window.load(std::memory_order_relaxed);
+        if (now != window && m_window.compare_exchange_strong(window, now, std::memory_order_relaxed)) {
+            m_count.store(0, std::memory_order_relaxed);
+        }
+        return m_count.fetch_add(1, std::memory_order_relaxed) < m_limit;
+    }
+
+private:
+    const uint32_t m_limit;
+    std::atomic<int64_t> m_window{0};
+    std::atomic<uint32_t> m_count{0};
+};
+
+#define TE_LOG_EVERY_N(level, n, ...)                                                      \
+    do {                                                                                   \
+        static std::atomic<uint64_t> te_log_every_n_count_{0};                             \
+        if (te_log_every_n_count_.fetch_add(1, std::memory_order_relaxed) % (n) == 0) {    \
+            spdlog::log(level, __VA_ARGS__);                                               \
+        }                                                                                  \
+    } while (0)
+
+#define TE_LOG_RATE_LIMITED(level, per_second, ...)                                        \
+    do {                                                                                   \
+        static LogRateLimiter te_log_rate_limiter_(per_second);                            \
+        if (te_log_rate_limiter_.allow()) {                                                \
+            spdlog::log(level, __VA_ARGS__);                                               \
+        }                                                                                  \
+    } while (0)
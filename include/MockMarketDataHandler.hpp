@@ -1,6 +1,7 @@
 #pragma once
 
 #include "I_MarketDataHandler.hpp"
+#include "Tick.hpp"
 #include <string>
 #include <thread>
 #include <atomic>
@@ -17,6 +18,9 @@ public:
     void disconnect() override;
     void set_engine_core(EngineCore* engine_core);
 
+    // Parses one "SYMBOL,PRICE,SIZE" line. Returns false if the line is malformed.
+    static bool parse_tick_line(const std::string& line, Tick& tick);
+
 private:
     void process_data_feed();
     std::string m_csv_path;
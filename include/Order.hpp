@@ -1,31 +1,44 @@
 #pragma once
 
 #include "types.hpp"
+#include "FixedPoint.hpp"
+#include "SymbolTable.hpp"
 #include <string>
 #include <chrono>
+#include <optional>
 
 namespace TradingEngine {
 
+// Orders that arrive without a strategy_id belong to this strategy. Strategy
+// ids appear in topics, so they may not contain '.'.
+inline constexpr const char* kDefaultStrategyId = "DEFAULT";
+
 struct Order {
     uint64_t order_id;
+    std::string correlation_id;
+    std::string strategy_id;
     std::string symbol;
+    SymbolId symbol_id;
     Side side;
     OrderType order_type;
     OrderStatus status;
-    double quantity;
-    double price;
-    double filled_quantity;
-    double avg_fill_price;
+    Quantity quantity;
+    Price price;
+    Quantity filled_quantity;
+    Price avg_fill_price;
     std::chrono::system_clock::time_point creation_timestamp;
+    // When the first broker report for the order arrived; the epoch until then.
+    std::chrono::system_clock::time_point acknowledged_at;
+    // A modify sent but not yet answered. quantity and price keep the terms
+    // the broker is working until it accepts these.
+    std::optional<Quantity> pending_quantity;
+    std::optional<Price> pending_price;
 
     Order() : order_id(0),
+              symbol_id(kInvalidSymbolId),
               side(Side::BUY),
               order_type(OrderType::MARKET),
               status(OrderStatus::NEW),
-              quantity(0.0),
-              price(0.0),
-              filled_quantity(0.0),
-              avg_fill_price(0.0),
               creation_timestamp(std::chrono::system_clock::now()) {}
 };
 
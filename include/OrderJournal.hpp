@@ -0,0 +1,137 @@
+#pragma once
+
+#include "OrderManager.hpp"
+#include "ExecutionReport.hpp"
+#include "Stats.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+#include <sys/types.h>
+
+namespace TradingEngine {
+
+enum class JournalRecordType : uint8_t {
+    ORDER = 1,     // order accepted by the engine
+    REPORT = 2,    // ExecutionReport that changed an order
+    CANCEL = 3,    // cancel requested (order moved to PENDING_CANCEL)
+    MODIFY = 4     // cancel-replace requested
+};
+
+// Write-ahead log of every OrderManager mutation plus periodic snapshots.
+//
+// Directory layout: orders.wal holds records appended since the last
+// snapshot; orders.snapshot holds the full OrderManagerState and the sequence
+// number of the last record it includes. Each record is
+//   u32 payload length, u32 CRC-32 of payload, payload = u8 type, u64 seq, fields
+// so a torn tail from a crash is detected and cut off on recovery.
+//
+// The engine thread appends; a writer thread does the I/O. Records that pile
+// up while one fsync is in flight share the next one (group commit), so
+// a burst of orders costs one fsync, not one each. Callbacks passed with a
+// record run on the writer thread once it is durable; new orders are only
+// handed to the gateway from there.
+//
+// A failed write is cut back to the last good record and retried once. If
+// that does not work either the journal fails: callbacks get durable=false
+// and nothing more is written, so the owner must stop placing orders.
+class OrderJournal {
+public:
+    struct Config {
+        std::string directory;
+        bool fsync = true;
+        uint64_t snapshot_every_records = 10000;
+    };
+
+    using DurableCallback = std::function<void(bool durable)>;
+
+    OrderJournal();
+    ~OrderJournal();
+    OrderJournal(const OrderJournal&) = delete;
+    OrderJournal& operator=(const OrderJournal&) = delete;
+
+    // Loads the snapshot and replays the log tail into order_manager, then
+    // starts the writer. Call once, before the engine processes events.
+    bool open(const Config& config, OrderManager& order_manager);
+    // Flushes everything appended so far and stops the writer.
+    void close();
+    bool is_open() const { return m_fd >= 0; }
+    // Set by the writer thread once a batch could not be made durable.
+    bool failed() const { return m_failed.load(std::memory_order_acquire); }
+
+    // Engine thread only.
+    void append_order(const Order& order, DurableCallback on_durable = nullptr);
+    void append_report(const ExecutionReport& report);
+    // on_send is called here at once (durable=true), unless the order was
+    // appended with a callback that has not run yet. Then it runs on the writer
+    // thread right after that callback, with the same outcome, so a cancel
+    // never overtakes its own order.
+    void append_cancel(uint64_t order_id, DurableCallback on_send = nullptr);
+    void append_modify(uint64_t order_id, std::optional<Quantity> quantity, std::optional<Price> price,
+                       DurableCallback on_durable = nullptr);
+    // Snapshots now if enough records have been appended since the last one.
+    void maybe_snapshot(const OrderManager& order_manager);
+    void snapshot(const OrderManager& order_manager);
+
+    // Blocks until every record appended so far is durable (or the journal
+    // has failed).
+    void sync();
+
+    uint64_t last_sequence() const { return m_next_sequence - 1; }
+
+private:
+    struct Batch {
+        std::vector<char> records;
+        std::vector<DurableCallback> callbacks;
+        size_t record_count = 0;
+        std::optional<OrderManagerState> snapshot;
+        uint64_t snapshot_sequence = 0;
+        size_t snapshot_offset = 0;
+        uint64_t last_sequence = 0;
+        std::vector<uint64_t> released_orders;  // ids whose callbacks are in this batch
+    };
+
+    void append(std::vector<char>& payload, DurableCallback on_durable);
+    void queue_record_locked(const std::vector<char>& payload);
+    void begin_record(std::vector<char>& payload, JournalRecordType type);
+    void run();
+    bool write_batch(Batch& batch);
+    bool write_snapshot(const OrderManagerState& state, uint64_t sequence);
+    bool load_snapshot(OrderManager& order_manager, uint64_t& sequence);
+    size_t replay(OrderManager& order_manager, uint64_t after_sequence);
+    bool reset_wal();
+
+    Config m_config;
+    std::string m_wal_path;
+    std::string m_snapshot_path;
+    int m_fd = -1;
+    // End of the last record known to be on disk; a failed write is cut back to it.
+    off_t m_good_offset = 0;
+    std::atomic<bool> m_failed{false};
+    uint64_t m_next_sequence = 1;
+    uint64_t m_records_since_snapshot = 0;
+
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::condition_variable m_durable_cv;
+    Batch m_pending;
+    uint64_t m_durable_sequence = 0;
+    // Orders appended with a callback that has not finished running.
+    std::unordered_set<uint64_t> m_unreleased;
+    bool m_stopping = false;
+    std::thread m_writer;
+
+    Counter& m_fsyncs;
+    Counter& m_records;
+    LatencyHistogram& m_commit_latency;
+};
+
+}
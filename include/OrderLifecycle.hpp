@@ -0,0 +1,88 @@
+#pragma once
+
+#include "types.hpp"
+#include <cstdint>
+#include <string_view>
+
+namespace TradingEngine {
+
+namespace detail {
+
+constexpr uint16_t status_bit(OrderStatus status) {
+    return static_cast<uint16_t>(1u << static_cast<unsigned>(status));
+}
+
+// Row = current status, bits = statuses it may move to. Terminal states have
+// no exits. PENDING_CANCEL only moves forward; a rejected cancel is undone
+// explicitly by OrderManager rather than through this table.
+constexpr uint16_t kOrderTransitions[kOrderStatusCount] = {
+    // NEW
+    status_bit(OrderStatus::PENDING_NEW) | status_bit(OrderStatus::CONFIRMED) |
+        status_bit(OrderStatus::PARTIALLY_FILLED) | status_bit(OrderStatus::FILLED) |
+        status_bit(OrderStatus::CANCELED) | status_bit(OrderStatus::REJECTED) |
+        status_bit(OrderStatus::PENDING_CANCEL),
+    // PENDING_NEW
+    status_bit(OrderStatus::CONFIRMED) | status_bit(OrderStatus::PARTIALLY_FILLED) |
+        status_bit(OrderStatus::FILLED) | status_bit(OrderStatus::CANCELED) |
+        status_bit(OrderStatus::REJECTED) | status_bit(OrderStatus::PENDING_CANCEL),
+    // CONFIRMED
+    status_bit(OrderStatus::PARTIALLY_FILLED) | status_bit(OrderStatus::FILLED) |
+        status_bit(OrderStatus::CANCELED) | status_bit(OrderStatus::REJECTED) |
+        status_bit(OrderStatus::PENDING_CANCEL),
+    // PARTIALLY_FILLED
+    status_bit(OrderStatus::FILLED) | status_bit(OrderStatus::CANCELED) |
+        status_bit(OrderStatus::PENDING_CANCEL),
+    // FILLED
+    0,
+    // CANCELED
+    0,
+    // REJECTED
+    0,
+    // PENDING_CANCEL
+    status_bit(OrderStatus::FILLED) | status_bit(OrderStatus::CANCELED),
+};
+
+struct IbkrStatusMapping {
+    std::string_view name;
+    OrderStatus status;
+};
+
+// Status strings from EWrapper::orderStatus.
+constexpr IbkrStatusMapping kIbkrOrderStatuses[] = {
+    {"ApiPending", OrderStatus::PENDING_NEW},
+    {"PendingSubmit", OrderStatus::PENDING_NEW},
+    {"PreSubmitted", OrderStatus::CONFIRMED},
+    {"Submitted", OrderStatus::CONFIRMED},
+    {"PendingCancel", OrderStatus::PENDING_CANCEL},
+    {"ApiCancelled", OrderStatus::CANCELED},
+    {"Cancelled", OrderStatus::CANCELED},
+    {"Filled", OrderStatus::FILLED},
+    {"Inactive", OrderStatus::REJECTED},
+};
+
+}
+
+constexpr bool is_terminal(OrderStatus status) {
+    return status == OrderStatus::FILLED || status == OrderStatus::CANCELED || status == OrderStatus::REJECTED;
+}
+
+constexpr bool can_transition(OrderStatus from, OrderStatus to) {
+    return (detail::kOrderTransitions[static_cast<size_t>(from)] & detail::status_bit(to)) != 0;
+}
+
+// Returns false for strings IB may add later; callers log and ignore them.
+constexpr bool order_status_from_ibkr(std::string_view ib_status, OrderStatus& status) {
+    for (const auto& mapping : detail::kIbkrOrderStatuses) {
+        if (mapping.name == ib_status) {
+            status = mapping.status;
+            return true;
+        }
+    }
+    return false;
+}
+
+static_assert(!can_transition(OrderStatus::FILLED, OrderStatus::CANCELED), "terminal states have no exits");
+static_assert(!can_transition(OrderStatus::PARTIALLY_FILLED, OrderStatus::CONFIRMED), "fills never regress");
+static_assert(can_transition(OrderStatus::PENDING_CANCEL, OrderStatus::FILLED), "a fill can beat a cancel");
+
+}
@@ -2,29 +2,103 @@
 
 #include "Order.hpp"
 #include "ExecutionReport.hpp"
+#include "BrokerSnapshot.hpp"
 #include <unordered_map>
+#include <unordered_set>
+#include <optional>
 #include <string>
+#include <vector>
 #include <atomic>
 #include <cstdint>
 
 namespace TradingEngine {
 
+// One strategy's holding in one symbol. avg_price is the average cost of the
+// open position; realized_pnl accumulates as it is reduced or flipped.
+struct StrategyPosition {
+    Quantity position;
+    Price avg_price;
+    Notional realized_pnl = 0;
+};
+
+// Everything OrderManager knows, as plain values. The journal snapshots this
+// and restores it on startup before replaying the log tail.
+struct OrderManagerState {
+    uint64_t next_order_id = 1;
+    std::vector<Order> orders;
+    std::unordered_map<std::string, Quantity> positions;
+    std::unordered_map<std::string, std::unordered_map<std::string, StrategyPosition>> strategy_positions;
+    std::vector<std::string> exec_ids;
+};
+
 class OrderManager {
 public:
 OrderManager();
 
     uint64_t add_new_order(Order& order);
+    // Journal replay: re-inserts an order under its original id.
+    void restore_order(const Order& order);
+    OrderManagerState export_state() const;
+    void import_state(OrderManagerState state);
     void set_next_order_id(uint64_t id);
-    void update_order_status(const ExecutionReport& report);
+    // Engine shards each own an OrderManager but draw ids from owner's
+    // counter, so ids stay unique and increasing across all of them.
+    void share_order_ids(OrderManager& owner);
+    // Fills move positions (once per exec_id); status changes follow the
+    // transition table in OrderLifecycle.hpp and are dropped if not allowed.
+    // Returns false if the report changed nothing (unknown order, repeated execution).
+    bool update_order_status(const ExecutionReport& report);
+    // Marks a working order PENDING_CANCEL. False if it is unknown, done,
+    // already being cancelled or (when strategy_id is set) owned by another
+    // strategy, in which case nothing should be sent.
+    bool request_cancel(uint64_t order_id, const std::string& strategy_id = "");
+    // Cancel-replace of quantity and/or limit price. The new quantity must
+    // exceed what has already filled. The order keeps its terms, with these
+    // as pending, until a MODIFIED report applies them or MODIFY_REJECTED
+    // drops them.
+    bool request_modify(uint64_t order_id, std::optional<Quantity> quantity, std::optional<Price> price,
+                        const std::string& strategy_id = "");
+    // Cancels every open order for symbol, strategy, both or (if both are
+    // empty) everything. Returns the ids that moved to PENDING_CANCEL.
+    std::vector<uint64_t> request_mass_cancel(const std::string& symbol, const std::string& strategy_id);
+    // Applies fills and status changes the engine missed and adopts the
+    // broker's positions. Returns the number of corrections made; closed, if
+    // given, gets the ids of orders it finished.
+    size_t reconcile(const BrokerSnapshot& snapshot, std::vector<uint64_t>* closed = nullptr);
 
     Order get_order(uint64_t order_id) const;
 
-    double get_position(const std::string& symbol) const;
+    Quantity get_position(const std::string& symbol) const;
+    StrategyPosition get_strategy_position(const std::string& strategy_id, const std::string& symbol) const;
+    // Realized P&L across all of a strategy's symbols.
+    Notional get_strategy_realized_pnl(const std::string& strategy_id) const;
+
+    // Orders not yet FILLED, CANCELED or REJECTED; all of them if symbol is empty.
+    size_t open_order_count(const std::string& symbol = "") const;
 
 private:
+    void apply_fill(Order& order, Quantity quantity, Price price);
+    void apply_strategy_fill(const Order& order, Quantity quantity, Price price);
+    bool owned_by(const Order& order, const std::string& strategy_id) const;
+    bool transition(Order& order, OrderStatus status);
+    // Bypasses the transition table (reconcile, cancel rejects) but keeps the indices right.
+    void force_status(Order& order, OrderStatus status);
+    void index_open(const Order& order);
+    void unindex_open(const Order& order);
+    // Moves the (possibly shared) id counter forward to at least id.
+    bool raise_next_order_id(uint64_t id);
+
     std::atomic<uint64_t> m_next_order_id;
+    std::atomic<uint64_t>* m_ids = &m_next_order_id;
     std::unordered_map<uint64_t, Order> m_orders;
-    std::unordered_map<std::string, double> m_positions;
+    std::unordered_map<std::string, Quantity> m_positions;
+    // strategy id -> symbol -> position.
+    std::unordered_map<std::string, std::unordered_map<std::string, StrategyPosition>> m_strategy_positions;
+    std::unordered_set<std::string> m_exec_ids;
+    // Open orders only, so mass cancels never walk finished orders.
+    std::unordered_set<uint64_t> m_open_orders;
+    std::unordered_map<std::string, std::unordered_set<uint64_t>> m_open_by_symbol;
+    std::unordered_map<std::string, std::unordered_set<uint64_t>> m_open_by_strategy;
 };
 
 }
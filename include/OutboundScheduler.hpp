@@ -0,0 +1,104 @@
+#pragma once
+
+#include "Stats.hpp"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace TradingEngine {
+
+// Dispatch order for outbound gateway requests; lower values go first.
+enum class OutboundPriority : uint8_t { CANCEL, NEW_ORDER, SUBSCRIPTION, HISTORY, COUNT };
+
+constexpr size_t kOutboundPriorityCount = static_cast<size_t>(OutboundPriority::COUNT);
+
+const char* outbound_priority_to_string(OutboundPriority priority);
+
+// Classic token bucket driven by an explicit clock so it can be tested.
+class TokenBucket {
+public:
+    TokenBucket(double rate_per_second, double burst);
+
+    // Takes a token if more than `reserve` would remain afterwards.
+    bool try_consume(uint64_t now_ns, double reserve = 0.0);
+    // Nanoseconds until try_consume(now_ns, reserve) can succeed.
+    uint64_t wait_ns(uint64_t now_ns, double reserve = 0.0);
+
+private:
+    void refill(uint64_t now_ns);
+
+    double m_rate_per_ns;
+    double m_burst;
+    double m_tokens;
+    uint64_t m_last_ns = 0;
+};
+
+// Single thread that owns every outbound EClient call. Requests are queued per
+// priority class and released through a token bucket sized under IB's
+// ~50 msg/s limit. Subscription and history requests may not dip into the
+// last `low_priority_reserve` tokens, so a burst of them cannot delay an order
+// or cancel, and history requests are additionally spaced apart.
+class OutboundScheduler {
+public:
+    struct Config {
+        double messages_per_second = 45.0;
+        double burst = 20.0;
+        double low_priority_reserve = 5.0;
+        std::chrono::milliseconds history_spacing{250};
+    };
+
+    OutboundScheduler() : OutboundScheduler(Config{}) {}
+    explicit OutboundScheduler(Config config);
+    ~OutboundScheduler();
+    OutboundScheduler(const OutboundScheduler&) = delete;
+    OutboundScheduler& operator=(const OutboundScheduler&) = delete;
+
+    void start();
+    // Stops the thread; anything still queued is discarded, and submit()
+    // rejects new requests until the next start().
+    void stop();
+
+    // Returns false if the scheduler is stopped and the request was dropped.
+    bool submit(OutboundPriority priority, std::function<void()> send);
+
+    size_t pending(OutboundPriority priority) const;
+    size_t pending() const;
+
+    // Sends everything the bucket allows at now_ns, highest priority first.
+    // Returns nanoseconds until the next send is possible, or 0 when idle.
+    uint64_t dispatch_ready(uint64_t now_ns);
+
+private:
+    struct Request {
+        std::function<void()> send;
+        uint64_t enqueued_ns;
+    };
+
+    void run();
+    void update_depth_gauges_locked();
+
+    Config m_config;
+    TokenBucket m_bucket;
+    uint64_t m_next_history_ns = 0;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::array<std::deque<Request>, kOutboundPriorityCount> m_queues;
+    uint64_t m_submissions = 0;  // wakes a throttled wait when something new arrives
+    bool m_closed = false;
+    std::thread m_thread;
+    std::atomic<bool> m_running{false};
+
+    std::array<Gauge*, kOutboundPriorityCount> m_depth{};
+    std::array<LatencyHistogram*, kOutboundPriorityCount> m_wait{};
+    Counter& m_sent;
+    Counter& m_throttled;
+};
+
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace TradingEngine {
+
+enum class ConnectionState : uint8_t {
+    CONNECTING,
+    CONNECTED,
+    DISCONNECTED,
+    RECONNECTING,
+    RESYNCED
+};
+
+const char* connection_state_to_string(ConnectionState state);
+
+// Published on the CONNECTION topic. attempt is 0 for the initial connect;
+// resync asks the engine to replay subscriptions and reconcile orders.
+struct ConnectionStatus {
+    ConnectionState state = ConnectionState::DISCONNECTED;
+    int attempt = 0;
+    bool resync = false;
+    int64_t downtime_ms = 0;
+    std::string detail;
+};
+
+// Exponential backoff: initial, 2x, 4x ... capped at max.
+class ReconnectBackoff {
+public:
+    ReconnectBackoff(std::chrono::milliseconds initial, std::chrono::milliseconds max);
+
+    std::chrono::milliseconds next_delay();
+    void reset() { m_next = m_initial; }
+
+private:
+    std::chrono::milliseconds m_initial;
+    std::chrono::milliseconds m_max;
+    std::chrono::milliseconds m_next;
+};
+
+// Owns the reconnect loop so the thread that notices a dead socket (the
+// reader) never has to tear the session down itself. On notify_connection_lost
+// it tears down, retries immediately, then backs off until reconnect succeeds
+// or stop() is called.
+class ReconnectSupervisor {
+public:
+    struct Config {
+        std::chrono::milliseconds initial_delay{250};
+        std::chrono::milliseconds max_delay{30000};
+    };
+
+    struct Callbacks {
+        std::function<void()> teardown;
+        std::function<bool(int attempt)> reconnect;
+        std::function<void(const ConnectionStatus&)> on_state;
+    };
+
+    ReconnectSupervisor(Config config, Callbacks callbacks);
+    ~ReconnectSupervisor();
+    ReconnectSupervisor(const ReconnectSupervisor&) = delete;
+    ReconnectSupervisor& operator=(const ReconnectSupervisor&) = delete;
+
+    void start();
+    void stop();
+
+    // Safe from any thread, including the one that owns the dead session.
+    void notify_connection_lost(const std::string& reason);
+    bool is_reconnecting() const { return m_reconnecting; }
+
+private:
+    void run();
+    void report(ConnectionState state, int attempt, int64_t downtime_ms, const std::string& detail);
+
+    Config m_config;
+    Callbacks m_callbacks;
+
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    bool m_lost = false;
+    bool m_stopping = false;
+    std::string m_reason;
+    std::thread m_thread;
+    std::atomic<bool> m_reconnecting{false};
+};
+
+}
@@ -3,8 +3,15 @@
 #include <zmq.hpp>
 #include <thread>
 #include <atomic>
+#include <mutex>
 #include "Tick.hpp"
 #include "Bar.hpp"
+#include "Stats.hpp"
+#include "ReconnectSupervisor.hpp"
+#include "OrderManager.hpp"
+#include "SessionCalendar.hpp"
+#include "TopicSubscriptions.hpp"
+#include "LastValueCache.hpp"
 
 namespace TradingEngine {
 class EngineCore;
@@ -21,16 +28,62 @@ public:
 
     void stop();
 
+    // Ticks and bars are only serialized if someone subscribes to their topic,
+    // but are always kept in the last-value cache.
     void publish_historical_data(const Bar& bar);
 
-    void publish_tick(const Tick& tick);
+    // Topic HISTORY_END.<SYMBOL>: every bar of a history request has been sent.
+    void publish_history_end(const std::string& symbol);
+
+    // Topic PONG.<CLIENT_ID>: the answer to a client's PING.
+    void publish_pong(const std::string& client_id, uint64_t nonce);
+
+    void publish_tick(const Tick& tick, LatencyTrace* trace = nullptr);
+
+    void publish_stats(const std::string& payload);
+
+    // Topic ALERT: operational warnings such as event queue overload.
+    void publish_alert(const std::string& payload);
+
+    // Topic TIMER.<STRATEGY>: one of the strategy's timers fired.
+    void publish_timer(const std::string& strategy_id, const std::string& name, int64_t fired_ns);
+
+    // Topic SESSION.<EXCHANGE>: OPEN, CLOSE or an auction milestone.
+    void publish_session_event(const SessionEvent& event, int64_t fired_ns);
+
+    void publish_connection_state(const ConnectionStatus& status);
+
+    // Topic EXECUTION.<STRATEGY>.<ORDER_ID>, so a strategy subscribes to
+    // "EXECUTION.<STRATEGY>." and sees only its own orders.
+    void publish_execution_report(const Order& order, const ExecutionReport& report, const StrategyPosition& position);
+
+    // snapshot marks a replay of the last value sent to a new subscriber.
+    static std::string serialize_tick(const Tick& tick, bool snapshot = false);
+
+    const TopicSubscriptions& subscriptions() const { return m_subscriptions; }
+    const LastValueCache& last_values() const { return m_last_values; }
 
 private:
     void listen_for_commands();
+    void send(const std::string& topic, const std::string& payload);
+    // send() for callers already holding m_publish_mutex.
+    void send_locked(const std::string& topic, const std::string& payload);
+    // Reads the subscribe/unsubscribe messages queued on the XPUB socket and
+    // answers each subscribe with a snapshot.
+    void drain_subscriptions();
+    // Sends the cached last value of every topic matching prefix. Called with
+    // m_publish_mutex held, so every live message sent afterwards follows it.
+    void send_snapshot(std::string_view prefix);
 
     EngineCore& m_engine_core;
     zmq::context_t m_context;
+    // XPUB, so subscriptions can be seen; guarded by m_publish_mutex.
     zmq::socket_t m_data_publisher;
+    std::mutex m_publish_mutex;
+    TopicSubscriptions m_subscriptions;
+    Counter* m_unsubscribed_skips;
+    LastValueCache m_last_values;
+    Counter* m_snapshot_messages;
     zmq::socket_t m_command_subscriber;
 
     std::string m_data_pub_endpoint;
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <set>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+namespace TradingEngine {
+
+// When an exchange's local clock moves forward an hour.
+enum class DstRule {
+    NONE,
+    US,  // second Sunday of March to first Sunday of November
+    EU   // last Sunday of March to last Sunday of October
+};
+
+enum class SessionEventType { OPEN, CLOSE, AUCTION };
+
+const char* session_event_type_to_string(SessionEventType type);
+
+// A named auction milestone, placed relative to the day's open or close so
+// that it follows an early close.
+struct AuctionTime {
+    std::string name;
+    bool relative_to_close = false;
+    int offset_minutes = 0;
+};
+
+// One exchange's regular session, in local time. Trades Monday to Friday
+// except holidays; the session must not span midnight.
+struct ExchangeSession {
+    std::string name;
+    int utc_offset_minutes = 0;  // standard (winter) time
+    DstRule dst = DstRule::NONE;
+    int open_minute = 9 * 60 + 30;  // minutes after local midnight
+    int close_minute = 16 * 60;
+    std::set<int32_t> holidays;           // local dates, as days since 1970-01-01
+    std::map<int32_t, int> early_closes;  // local date -> close minute
+    std::vector<AuctionTime> auctions;
+};
+
+struct SessionEvent {
+    std::string exchange;
+    SessionEventType type = SessionEventType::OPEN;
+    std::string name;  // "OPEN", "CLOSE" or the auction's name
+    int64_t time_ns = 0;  // UTC, since the epoch
+};
+
+// Per-exchange trading calendar: which days trade, when each session opens
+// and closes in UTC (DST included), and the auction times in between.
+class SessionCalendar {
+public:
+    // Parses the "sessions" config object; false (and logs) on a bad entry.
+    bool load(const nlohmann::json& sessions);
+    void add_exchange(ExchangeSession session);
+
+    bool is_open(const std::string& exchange, int64_t utc_ns) const;
+    // The exchange's first event strictly after after_ns, looking up to a
+    // month ahead. nullopt for an unknown exchange or an empty calendar.
+    std::optional<SessionEvent> next_event(const std::string& exchange, int64_t after_ns) const;
+    // Every event of one local trading day, in time order; empty on a weekend or holiday.
+    std::vector<SessionEvent> day_events(const std::string& exchange, int32_t day) const;
+
+    std::vector<std::string> exchanges() const;
+    bool empty() const { return m_exchanges.empty(); }
+
+    // Civil date <-> days since 1970-01-01 (proleptic Gregorian).
+    static int32_t days_from_civil(int year, unsigned month, unsigned day);
+    // "YYYY-MM-DD"; false if malformed.
+    static bool parse_date(const std::string& text, int32_t& day);
+    // "HH:MM" -> minutes after midnight; false if malformed.
+    static bool parse_time(const std::string& text, int& minute);
+    // UTC offset in minutes on a local date, DST included.
+    static int utc_offset_minutes(const ExchangeSession& session, int32_t day);
+
+private:
+    const ExchangeSession* find(const std::string& exchange) const;
+    std::vector<SessionEvent> events_on(const ExchangeSession& session, int32_t day) const;
+    static int32_t local_day(const ExchangeSession& session, int64_t utc_ns);
+
+    std::vector<ExchangeSession> m_exchanges;
+};
+
+}
@@ -0,0 +1,199 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <nlohmann/json_fwd.hpp>
+
+namespace TradingEngine {
+
+inline uint64_t monotonic_ns() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+// Log-linear (HDR-style) histogram: exact below 16ns, then 16 sub-buckets per
+// power of two (~6% relative error) up to 2^64. Recording is wait-free but
+// assumes a single writer thread; snapshots may be taken from any thread.
+class LatencyHistogram {
+public:
+    static constexpr int kSubBucketBits = 4;
+    static constexpr int kSubBuckets = 1 << kSubBucketBits;
+    static constexpr int kBucketCount = kSubBuckets + (64 - kSubBucketBits) * kSubBuckets;
+
+    struct Snapshot {
+        std::vector<uint64_t> counts = std::vector<uint64_t>(kBucketCount, 0);
+        uint64_t count = 0;
+        uint64_t sum = 0;
+        uint64_t min = UINT64_MAX;
+        uint64_t max = 0;
+
+        void merge(const Snapshot& other);
+        uint64_t percentile(double pct) const;
+        double mean() const { return count ? static_cast<double>(sum) / count : 0.0; }
+    };
+
+    void record(uint64_t value) {
+        bump(m_counts[bucket_index(value)], 1);
+        bump(m_count, 1);
+        bump(m_sum, value);
+        if (value < m_min.load(std::memory_order_relaxed)) m_min.store(value, std::memory_order_relaxed);
+        if (value > m_max.load(std::memory_order_relaxed)) m_max.store(value, std::memory_order_relaxed);
+    }
+
+    Snapshot snapshot() const;
+
+    static int bucket_index(uint64_t value) {
+        if (value < kSubBuckets) {
+            return static_cast<int>(value);
+        }
+        int msb = 63 - __builtin_clzll(value);
+        int shift = msb - kSubBucketBits;
+        int sub = static_cast<int>(value >> shift) - kSubBuckets;
+        return kSubBuckets + shift * kSubBuckets + sub;
+    }
+
+    // Highest value that maps to the given bucket.
+    static uint64_t bucket_upper_bound(int index);
+
+private:
+    static void bump(std::atomic<uint64_t>& cell, uint64_t n) {
+        cell.store(cell.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    }
+
+    std::array<std::atomic<uint64_t>, kBucketCount> m_counts{};
+    std::atomic<uint64_t> m_count{0};
+    std::atomic<uint64_t> m_sum{0};
+    std::atomic<uint64_t> m_min{UINT64_MAX};
+    std::atomic<uint64_t> m_max{0};
+};
+
+class Counter {
+public:
+    void add(uint64_t n = 1) { m_value.fetch_add(n, std::memory_order_relaxed); }
+    uint64_t value() const { return m_value.load(std::memory_order_relaxed); }
+private:
+    std::atomic<uint64_t> m_value{0};
+};
+
+class Gauge {
+public:
+    void set(int64_t v) { m_value.store(v, std::memory_order_relaxed); }
+    void add(int64_t v) { m_value.fetch_add(v, std::memory_order_relaxed); }
+    void update_max(int64_t v) {
+        int64_t cur = m_value.load(std::memory_order_relaxed);
+        while (v > cur && !m_value.compare_exchange_weak(cur, v, std::memory_order_relaxed)) {}
+    }
+    int64_t value() const { return m_value.load(std::memory_order_relaxed); }
+    int64_t exchange(int64_t v) { return m_value.exchange(v, std::memory_order_relaxed); }
+private:
+    std::atomic<int64_t> m_value{0};
+};
+
+// The stages a tick or order passes through between the gateway/command socket
+// and the wire. A trace travels inside the Event and is folded into the
+// per-thread histograms once the path completes.
+enum class LatencyPath : uint8_t { TICK, ORDER, COUNT };
+enum class LatencyStage : uint8_t { INGEST, ENQUEUE, DEQUEUE, HANDLE, SERIALIZE, SEND, COUNT };
+
+constexpr size_t kLatencyPathCount = static_cast<size_t>(LatencyPath::COUNT);
+constexpr size_t kLatencyStageCount = static_cast<size_t>(LatencyStage::COUNT);
+
+class LatencyStats {
+public:
+    static void set_enabled(bool enabled) { s_enabled.store(enabled, std::memory_order_relaxed); }
+
+    static bool enabled() {
+#ifdef ENGINE_NO_LATENCY_STATS
+        return false;
+#else
+        return s_enabled.load(std::memory_order_relaxed);
+#endif
+    }
+
+private:
+    inline static std::atomic<bool> s_enabled{false};
+};
+
+struct LatencyTrace {
+#ifdef ENGINE_NO_LATENCY_STATS
+    void stamp(LatencyStage) {}
+    bool complete() const { return false; }
+    uint64_t elapsed(LatencyStage, LatencyStage) const { return 0; }
+#else
+    std::array<uint64_t, kLatencyStageCount> stamps{};
+
+    void stamp(LatencyStage stage) {
+        if (LatencyStats::enabled()) {
+            stamps[static_cast<size_t>(stage)] = monotonic_ns();
+        }
+    }
+    bool complete() const {
+        return stamps.front() != 0 && stamps.back() != 0;
+    }
+    // 0 unless both stages were stamped.
+    uint64_t elapsed(LatencyStage from, LatencyStage to) const {
+        uint64_t start = stamps[static_cast<size_t>(from)];
+        uint64_t end = stamps[static_cast<size_t>(to)];
+        return start != 0 && end >= start ? end - start : 0;
+    }
+#endif
+};
+
+// Process-wide home for counters, gauges and histograms. Registration takes a
+// lock and returns a reference that stays valid for the life of the process;
+// updates through that reference never lock.
+class StatsRegistry {
+public:
+    StatsRegistry(const StatsRegistry&) = delete;
+    StatsRegistry& operator=(const StatsRegistry&) = delete;
+
+    static StatsRegistry& instance();
+
+    Counter& counter(const std::string& name);
+    Gauge& gauge(const std::string& name);
+    LatencyHistogram& histogram(const std::string& name);
+
+    // Folds a finished trace into the calling thread's stage histograms.
+    void record_trace(LatencyPath path, const LatencyTrace& trace);
+
+    // Builds the STATS payload. Rates are computed against the previous call,
+    // so this is meant to be driven from a single publishing thread.
+    nlohmann::json snapshot();
+    void log_summary();
+
+private:
+    StatsRegistry() = default;
+
+    static constexpr size_t kSegmentCount = kLatencyStageCount;  // 5 hops + total
+
+    struct ThreadHistograms {
+        std::array<std::array<LatencyHistogram, kSegmentCount>, kLatencyPathCount> segments;
+    };
+
+    template<typename T>
+    struct Named {
+        std::string name;
+        T value;
+    };
+
+    ThreadHistograms& thread_histograms();
+    LatencyHistogram::Snapshot merged_segment(size_t path, size_t segment);
+
+    std::mutex m_mutex;
+    std::deque<Named<Counter>> m_counters;
+    std::deque<Named<Gauge>> m_gauges;
+    std::deque<Named<LatencyHistogram>> m_histograms;
+    std::vector<std::unique_ptr<ThreadHistograms>> m_thread_histograms;
+
+    std::vector<uint64_t> m_last_counter_values;
+    uint64_t m_last_snapshot_ns = 0;
+};
+
+}
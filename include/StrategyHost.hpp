@@ -0,0 +1,94 @@
+#pragma once
+
+#include "StrategyPlugin.hpp"
+#include "SymbolTable.hpp"
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace TradingEngine {
+
+struct StrategyPluginConfig {
+    std::string id;       // becomes every order's strategy_id; may not contain '.'
+    std::string library;  // path handed to dlopen
+    std::vector<std::string> symbols;
+    std::string params = "{}";  // JSON text passed to te_create_strategy
+};
+
+// Loads strategy plugins and routes events to them: ticks and bars by symbol,
+// order updates by strategy id. Loading happens before the event loops start
+// and the routing tables are fixed from then on, so dispatch takes no locks.
+// A plugin whose callback throws is logged and disabled: it gets no further
+// callbacks (on_stop included), and the engine keeps running.
+class StrategyHost {
+public:
+    StrategyHost() = default;
+    // Destroys the strategies, then unloads their libraries.
+    ~StrategyHost();
+
+    StrategyHost(const StrategyHost&) = delete;
+    StrategyHost& operator=(const StrategyHost&) = delete;
+
+    // dlopens the library, checks its API version and creates the strategy.
+    // Logs and returns false on any failure, leaving nothing loaded.
+    bool load(const StrategyPluginConfig& config, std::unique_ptr<StrategyContext> context);
+
+    bool empty() const { return m_plugins.empty(); }
+    size_t size() const { return m_plugins.size(); }
+    // Every symbol some strategy listed, once each.
+    std::vector<std::string> symbols() const;
+
+    void start();
+    void stop();
+
+    void on_tick(const Tick& tick) {
+        SymbolId id = tick.symbol_id != kInvalidSymbolId ? tick.symbol_id : SymbolTable::instance().find(tick.symbol);
+        if (id < m_by_symbol.size()) {
+            for (Plugin* plugin : m_by_symbol[id]) {
+                dispatch(*plugin, "on_tick", [&tick](Strategy& strategy) { strategy.on_tick(tick); });
+            }
+        }
+    }
+    void on_bar(const Bar& bar);
+    void on_order_update(const Order& order, const ExecutionReport& report);
+
+    // False once the plugin has thrown (or if no plugin has this id).
+    bool enabled(const std::string& strategy_id) const;
+
+private:
+    struct Plugin {
+        StrategyPluginConfig config;
+        void* handle = nullptr;
+        Strategy* strategy = nullptr;
+        DestroyStrategyFn destroy = nullptr;
+        std::unique_ptr<StrategyContext> context;
+        // Plugins may run on several shard threads, one per symbol.
+        std::atomic<bool> disabled{false};
+    };
+
+    // A try block costs nothing until something throws, so ticks pay no more.
+    template <typename Fn>
+    void dispatch(Plugin& plugin, const char* callback, Fn&& fn) {
+        if (plugin.disabled.load(std::memory_order_relaxed)) {
+            return;
+        }
+        try {
+            fn(*plugin.strategy);
+        } catch (const std::exception& e) {
+            disable(plugin, callback, e.what());
+        } catch (...) {
+            disable(plugin, callback, "unknown exception");
+        }
+    }
+    void disable(Plugin& plugin, const char* callback, const char* what);
+
+    std::vector<std::unique_ptr<Plugin>> m_plugins;
+    std::vector<std::vector<Plugin*>> m_by_symbol;  // indexed by SymbolId
+    std::unordered_map<std::string, Plugin*> m_by_strategy_id;
+    bool m_started = false;
+};
+
+}
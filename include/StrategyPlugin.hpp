@@ -0,0 +1,83 @@
+#pragma once
+
+#include "Tick.hpp"
+#include "Bar.hpp"
+#include "Order.hpp"
+#include "ExecutionReport.hpp"
+#include <string>
+
+// In-process strategies. A plugin is a shared library built against these
+// headers (with the engine's compiler and flags, since C++ types cross the
+// boundary) that defines a Strategy subclass and exports it with
+// TE_STRATEGY_PLUGIN. The engine dlopens the libraries listed under
+// "strategy_plugins" in the config and calls them straight from the event
+// loop that owns the symbol, so a tick reaches the strategy and its order
+// reaches the gateway without leaving the thread: no ZMQ, no JSON.
+
+namespace TradingEngine {
+
+// Bumped whenever Strategy, StrategyContext or a type they pass changes, so a
+// stale plugin is refused at load instead of crashing.
+inline constexpr int kStrategyApiVersion = 1;
+
+// The engine as a plugin sees it. Only call it from inside a callback, on the
+// thread that made the call.
+class StrategyContext {
+public:
+    virtual ~StrategyContext() = default;
+
+    virtual const std::string& strategy_id() const = 0;
+
+    // Goes through the same risk checks as CREATE_ORDER. If this event loop
+    // owns the symbol (always, unless worker_shards > 1), the order is checked
+    // and sent before this returns, and its id is returned even if it was
+    // rejected (on_order_update then reports REJECTED). Otherwise it is queued
+    // for the owning shard and 0 is returned; its id arrives with
+    // on_order_update, matched on correlation_id. strategy_id is filled in.
+    virtual uint64_t submit_order(Order order) = 0;
+    // False if the order is not one of this strategy's working orders. Orders
+    // on another shard are queued and report true.
+    virtual bool cancel_order(uint64_t order_id) = 0;
+    // This strategy's holding in the symbol, as of its last fill. With
+    // worker_shards > 1 only the calling shard's symbols are known; others
+    // read as zero.
+    virtual Quantity position(const std::string& symbol) const = 0;
+};
+
+// Callbacks for the symbols listed in the plugin's config. With
+// worker_shards > 1, callbacks for symbols on different shards can run at
+// the same time; a strategy that shares state between them must guard it.
+class Strategy {
+public:
+    virtual ~Strategy() = default;
+
+    // Before the event loop starts. The context outlives the strategy.
+    virtual void on_start(StrategyContext& context) { (void)context; }
+    virtual void on_tick(const Tick& tick) { (void)tick; }
+    virtual void on_bar(const Bar& bar) { (void)bar; }
+    // Every status change and fill of this strategy's own orders, including
+    // ones it placed over the control channel. May be called from inside
+    // submit_order or cancel_order.
+    virtual void on_order_update(const Order& order, const ExecutionReport& report) {
+        (void)order;
+        (void)report;
+    }
+    // After the event loop has stopped.
+    virtual void on_stop() {}
+};
+
+}
+
+// What the engine looks up in each plugin library.
+using StrategyApiVersionFn = int (*)();
+// params is the plugin's "params" object from the config, as JSON text.
+using CreateStrategyFn = TradingEngine::Strategy* (*)(const char* params);
+using DestroyStrategyFn = void (*)(TradingEngine::Strategy*);
+
+// Exports a Strategy subclass constructible from the params JSON text.
+#define TE_STRATEGY_PLUGIN(StrategyType)                                                              \
+    extern "C" int te_strategy_api_version() { return TradingEngine::kStrategyApiVersion; }          \
+    extern "C" TradingEngine::Strategy* te_create_strategy(const char* params) {                     \
+        return new StrategyType(params);                                                             \
+    }                                                                                                \
+    extern "C" void te_destroy_strategy(TradingEngine::Strategy* strategy) { delete strategy; }
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace TradingEngine {
+
+// Reference-counts market data subscribers per (symbol, data type) so each
+// stream uses one gateway line no matter how many strategies want it. This
+// class only does the bookkeeping; the gateway acts on the returned Change.
+//
+// A named subscriber holds at most one reference per stream, so repeated
+// SUBSCRIBEs from the same strategy are idempotent. Anonymous subscribers
+// (empty name) take one reference per call.
+class SubscriptionManager {
+public:
+    enum class Change {
+        NONE,               // reference count changed, nothing to send
+        FIRST_SUBSCRIBER,   // open the stream
+        LAST_UNSUBSCRIBED,  // cancel the stream
+        LINE_LIMIT_REACHED, // rejected: would exceed the line limit
+        NOT_SUBSCRIBED      // unsubscribe for a stream/subscriber that has no reference
+    };
+
+    static constexpr long kNoRequest = -1;
+
+    explicit SubscriptionManager(size_t line_limit = 100) : m_line_limit(line_limit) {}
+
+    Change subscribe(const std::string& symbol, const std::string& data_type, const std::string& subscriber);
+    Change unsubscribe(const std::string& symbol, const std::string& data_type, const std::string& subscriber);
+
+    // Removes the stream outright, whoever holds it (e.g. its contract could
+    // not be resolved), freeing its line. Returns the subscribers it had.
+    std::vector<std::string> drop_stream(const std::string& symbol, const std::string& data_type);
+
+    // Associates the gateway request id with an open stream once it is sent.
+    void bind_request(const std::string& symbol, const std::string& data_type, long request_id);
+    long request_id(const std::string& symbol, const std::string& data_type) const;
+
+    size_t subscriber_count(const std::string& symbol, const std::string& data_type) const;
+    size_t lines_in_use() const { return m_streams.size(); }
+    size_t line_limit() const { return m_line_limit; }
+    void set_line_limit(size_t line_limit) { m_line_limit = line_limit; }
+
+    // (symbol, data_type) for every open stream.
+    std::vector<std::pair<std::string, std::string>> active_streams() const;
+
+private:
+    struct Stream {
+        std::string symbol;
+        std::string data_type;
+        std::unordered_map<std::string, size_t> references;  // subscriber -> count
+        long request_id = kNoRequest;
+    };
+
+    static std::string key(const std::string& symbol, const std::string& data_type) {
+        return data_type + '.' + symbol;
+    }
+
+    size_t m_line_limit;
+    std::unordered_map<std::string, Stream> m_streams;
+};
+
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace TradingEngine {
+
+using SymbolId = uint32_t;
+constexpr SymbolId kInvalidSymbolId = 0;
+
+// Interns symbol strings into dense ids (1, 2, 3, ...) so hot paths can index
+// arrays instead of hashing strings. Entries are never removed or moved, so
+// name() is a lock-free array read; only interning a new symbol takes a lock.
+class SymbolTable {
+public:
+    static constexpr size_t kMaxSymbols = 16384;
+
+    SymbolTable();
+    SymbolTable(const SymbolTable&) = delete;
+    SymbolTable& operator=(const SymbolTable&) = delete;
+
+    static SymbolTable& instance();
+
+    // Returns kInvalidSymbolId if the table is full.
+    SymbolId intern(std::string_view symbol);
+    SymbolId find(std::string_view symbol) const;
+    const std::string& name(SymbolId id) const;
+    size_t size() const { return m_size.load(std::memory_order_acquire); }
+
+private:
+    std::unique_ptr<std::string[]> m_names;
+    std::atomic<size_t> m_size{0};
+    mutable std::mutex m_mutex;
+    std::unordered_map<std::string, SymbolId> m_ids;
+};
+
+}
@@ -2,6 +2,8 @@
 
 #include <queue>
 #include <mutex>
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
 
 namespace TradingEngine {
@@ -16,6 +18,7 @@ public:
     void push(T item) {
         std::lock_guard<std::mutex> lock(m_mutex);
         m_queue.push(std::move(item));
+        m_size.store(m_queue.size(), std::memory_order_relaxed);
         m_cond_var.notify_one();
     }
 
@@ -24,6 +27,19 @@ public:
         m_cond_var.wait(lock, [this]{ return !m_queue.empty(); });
         item = std::move(m_queue.front());
         m_queue.pop();
+        m_size.store(m_queue.size(), std::memory_order_relaxed);
+    }
+
+    template<typename Rep, typename Period>
+    bool wait_and_pop_for(T& item, const std::chrono::duration<Rep, Period>& timeout) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (!m_cond_var.wait_for(lock, timeout, [this]{ return !m_queue.empty(); })) {
+            return false;
+        }
+        item = std::move(m_queue.front());
+        m_queue.pop();
+        m_size.store(m_queue.size(), std::memory_order_relaxed);
+        return true;
     }
 
     bool try_pop(T& item) {
@@ -33,9 +49,15 @@ public:
         }
         item = std::move(m_queue.front());
         m_queue.pop();
+        m_size.store(m_queue.size(), std::memory_order_relaxed);
         return true;
     }
 
+    // Lock-free approximate depth, for gauges.
+    size_t size() const {
+        return m_size.load(std::memory_order_relaxed);
+    }
+
     bool empty() const {
         std::lock_guard<std::mutex> lock(m_mutex);
         return m_queue.empty();
@@ -45,6 +67,7 @@ private:
     std::queue<T> m_queue;
     mutable std::mutex m_mutex;
     std::condition_variable m_cond_var;
+    std::atomic<size_t> m_size{0};
 };
 
 }
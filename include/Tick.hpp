@@ -1,5 +1,7 @@
 #pragma once
 
+#include "FixedPoint.hpp"
+#include "SymbolTable.hpp"
 #include <string>
 #include <chrono>
 
@@ -7,8 +9,10 @@ namespace TradingEngine {
 
 struct Tick {
     std::string symbol;
-    double price;
-    uint64_t size;
+    // Optional; producers that already know it save the engine a lookup.
+    SymbolId symbol_id = kInvalidSymbolId;
+    Price price;
+    Quantity size;
     std::chrono::system_clock::time_point timestamp;
 };
 
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace TradingEngine {
+
+using TimerId = uint64_t;
+constexpr TimerId kInvalidTimerId = 0;
+
+// Hierarchical timing wheel: four levels of 256 slots, each level 256 times
+// coarser than the one below, so with 1 ms ticks it covers ~49 days (anything
+// further is parked in the top level and re-cascaded). Timers live in
+// intrusive lists, so schedule and cancel are O(1); advance() skips ticks with
+// nothing to do, so an idle stretch costs a slot scan rather than a step per tick.
+//
+// Driven by an explicit clock (nanoseconds, any epoch) so it can be tested.
+// Not thread-safe: one thread schedules, cancels and advances.
+class TimerWheel {
+public:
+    using Callback = std::function<void(TimerId)>;
+
+    explicit TimerWheel(uint64_t now_ns, uint64_t tick_ns = 1000000);
+
+    // One-shot unless period_ns > 0. A timer never fires early; it may fire
+    // up to one tick late. Callbacks may schedule and cancel timers.
+    TimerId schedule_at(uint64_t deadline_ns, Callback callback, uint64_t period_ns = 0);
+    // False if the timer already fired (one-shot) or was cancelled.
+    bool cancel(TimerId id);
+
+    // Fires everything due at or before now_ns, tick by tick, so timers fire
+    // in deadline order to tick resolution. A periodic timer fires at most
+    // once per call, however many periods a stall skipped, and keeps its
+    // phase. Returns how many fired.
+    size_t advance(uint64_t now_ns);
+
+    // Nanoseconds until advance() has work (a timer fires or a level cascades),
+    // for bounding a wait. UINT64_MAX with no timers pending.
+    uint64_t ns_until_next(uint64_t now_ns) const;
+
+    size_t size() const { return m_active; }
+    uint64_t tick_ns() const { return m_tick_ns; }
+
+private:
+    static constexpr size_t kLevels = 4;
+    static constexpr size_t kSlotBits = 8;
+    static constexpr size_t kSlots = size_t{1} << kSlotBits;
+    static constexpr uint64_t kSlotMask = kSlots - 1;
+    static constexpr uint32_t kNone = UINT32_MAX;
+    // Slot list heads are nodes too, so unlinking never special-cases a head.
+    static constexpr uint32_t kHeadCount = static_cast<uint32_t>(kLevels * kSlots);
+
+    struct Node {
+        uint32_t prev = kNone;
+        uint32_t next = kNone;
+        uint32_t generation = 0;
+        bool active = false;
+        uint64_t expires = 0;  // tick
+        uint64_t period = 0;   // ticks
+        Callback callback;
+    };
+
+    uint32_t allocate();
+    void release(uint32_t index);
+    void link(uint32_t index);
+    void unlink(uint32_t index);
+    void cascade(size_t level);
+    uint64_t next_tick() const;
+    // target is the tick advance() is heading for; a periodic timer that
+    // fell behind is rescheduled past it rather than fired once per missed period.
+    size_t fire_slot(uint32_t head, uint64_t target);
+    uint32_t node_index(TimerId id) const;
+    TimerId make_id(uint32_t index) const;
+    bool slot_empty(uint32_t head) const { return m_nodes[head].next == head; }
+
+    uint64_t m_tick_ns;
+    uint64_t m_current;  // last tick processed
+    size_t m_active = 0;
+    std::vector<Node> m_nodes;
+    std::vector<uint32_t> m_free;
+};
+
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "SymbolTable.hpp"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+namespace TradingEngine {
+
+// Per-symbol topic families checked on the publish hot path.
+enum class TopicFamily : uint8_t { TICK, HISTORY, COUNT };
+
+inline constexpr std::string_view topic_family_prefix(TopicFamily family) {
+    return family == TopicFamily::TICK ? std::string_view("TICK.") : std::string_view("HISTORY.");
+}
+
+// What the data channel's subscribers have asked for, as reported by the XPUB
+// socket: one count per subscribed prefix (ZMQ matches topics by prefix).
+// Updates come from one thread; has_subscriber() may be called from any
+// number of threads and, once a symbol's answer is cached, is a single
+// relaxed atomic load.
+class TopicSubscriptions {
+public:
+    // Called with the prefix and its new subscriber count on every change.
+    using ChangeListener = std::function<void(const std::string& prefix, int count)>;
+
+    TopicSubscriptions();
+
+    // Applies one XPUB subscription message: a 1 (subscribe) or 0
+    // (unsubscribe) byte followed by the prefix. Returns false for anything
+    // else, or an unsubscribe of a prefix nobody holds.
+    bool apply(std::string_view message);
+
+    void on_change(ChangeListener listener) { m_listener = std::move(listener); }
+
+    // Whether anyone would receive <family prefix><symbol>.
+    bool has_subscriber(TopicFamily family, SymbolId id, std::string_view symbol) const {
+        const uint64_t generation = m_generation.load(std::memory_order_acquire);
+        if (id == kInvalidSymbolId || id >= SymbolTable::kMaxSymbols) {
+            return lookup(family, symbol);
+        }
+        std::atomic<uint64_t>& slot = m_cache[static_cast<size_t>(family) * SymbolTable::kMaxSymbols + id];
+        const uint64_t cached = slot.load(std::memory_order_relaxed);
+        if ((cached >> 1) == generation) {
+            return cached & 1;
+        }
+        // Tagged with the generation read first, so a change made meanwhile
+        // makes the entry stale rather than wrong.
+        const bool wanted = lookup(family, symbol);
+        slot.store((generation << 1) | (wanted ? 1 : 0), std::memory_order_relaxed);
+        return wanted;
+    }
+
+    // Whether any subscribed prefix matches topic.
+    bool has_subscriber(std::string_view topic) const;
+
+    int subscriber_count(const std::string& prefix) const;
+
+private:
+    bool lookup(TopicFamily family, std::string_view symbol) const;
+
+    mutable std::mutex m_mutex;
+    std::map<std::string, int, std::less<>> m_counts;  // only prefixes with count > 0
+    // Starts at 1 so the zeroed cache reads as stale; bumped on every change.
+    std::atomic<uint64_t> m_generation{1};
+    // (generation << 1) | wanted, per family and symbol id.
+    std::unique_ptr<std::atomic<uint64_t>[]> m_cache;
+    ChangeListener m_listener;
+};
+
+}
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <string>
 
 namespace TradingEngine {
@@ -16,9 +17,13 @@ enum class OrderStatus {
     PARTIALLY_FILLED,
     FILLED,
     CANCELED,
-    REJECTED
+    REJECTED,
+    PENDING_CANCEL
 };
 
+// Keep in sync with the last enumerator above.
+constexpr size_t kOrderStatusCount = static_cast<size_t>(OrderStatus::PENDING_CANCEL) + 1;
+
 enum class OrderType {
     MARKET,
     LIMIT
@@ -51,6 +56,8 @@ inline std::string status_to_string(OrderStatus status) {
             return "CANCELED";
         case OrderStatus::REJECTED:
             return "REJECTED";
+        case OrderStatus::PENDING_CANCEL:
+            return "PENDING_CANCEL";
         default:
             return "UNKNOWN";
     }
@@ -0,0 +1,90 @@
+// Example in-process strategy: goes long a fixed quantity when a tick trades
+// above the average of the previous `window` ticks by `threshold_bps`, and
+// flattens when it trades below it. One order at a time per symbol.
+//
+// Config:
+//   "strategy_plugins": [{"id": "momentum", "library": "build/libexample_momentum.so",
+//                         "symbols": ["AAPL"], "params": {"window": 20, "quantity": 100, "threshold_bps": 5}}]
+
+#include "StrategyPlugin.hpp"
+#include <nlohmann/json.hpp>
+#include <deque>
+#include <unordered_map>
+
+namespace {
+
+using namespace TradingEngine;
+
+class MomentumStrategy : public Strategy {
+public:
+    explicit MomentumStrategy(const char* params) {
+        auto json = nlohmann::json::parse(params);
+        m_window = json.value("window", size_t{20});
+        m_quantity = Quantity::from_double(json.value("quantity", 100.0));
+        m_threshold = json.value("threshold_bps", 5.0) / 10000.0;
+    }
+
+    void on_start(StrategyContext& context) override { m_context = &context; }
+
+    void on_tick(const Tick& tick) override {
+        SymbolState& state = m_symbols[tick.symbol];
+        const double price = tick.price.to_double();
+        if (state.prices.size() == m_window && state.working_order == 0) {
+            const double average = state.sum / static_cast<double>(m_window);
+            const bool long_now = m_context->position(tick.symbol).raw() > 0;
+            if (!long_now && price > average * (1.0 + m_threshold)) {
+                send(tick.symbol, Side::BUY, m_quantity, state);
+            } else if (long_now && price < average * (1.0 - m_threshold)) {
+                send(tick.symbol, Side::SELL, m_context->position(tick.symbol), state);
+            }
+        }
+        state.prices.push_back(price);
+        state.sum += price;
+        if (state.prices.size() > m_window) {
+            state.sum -= state.prices.front();
+            state.prices.pop_front();
+        }
+    }
+
+    void on_order_update(const Order& order, const ExecutionReport&) override {
+        SymbolState& state = m_symbols[order.symbol];
+        const bool done = order.status == OrderStatus::FILLED || order.status == OrderStatus::CANCELED ||
+                          order.status == OrderStatus::REJECTED;
+        if (done && (order.order_id == state.working_order || state.working_order == kSubmitting)) {
+            state.working_order = 0;
+        }
+    }
+
+private:
+    static constexpr uint64_t kSubmitting = UINT64_MAX;
+
+    struct SymbolState {
+        std::deque<double> prices;
+        double sum = 0.0;
+        uint64_t working_order = 0;
+    };
+
+    void send(const std::string& symbol, Side side, Quantity quantity, SymbolState& state) {
+        Order order;
+        order.symbol = symbol;
+        order.side = side;
+        order.order_type = OrderType::MARKET;
+        order.quantity = quantity;
+        // A rejection is reported from inside submit_order, before the id is known.
+        state.working_order = kSubmitting;
+        uint64_t order_id = m_context->submit_order(order);
+        if (state.working_order == kSubmitting) {
+            state.working_order = order_id;
+        }
+    }
+
+    StrategyContext* m_context = nullptr;
+    size_t m_window = 20;
+    Quantity m_quantity;
+    double m_threshold = 0.0;
+    std::unordered_map<std::string, SymbolState> m_symbols;
+};
+
+}
+
+TE_STRATEGY_PLUGIN(MomentumStrategy)
@@ -0,0 +1,207 @@
+#include "BinaryLog.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace TradingEngine {
+
+namespace {
+
+// Single-producer (the owning thread) / single-consumer (the flusher) ring.
+struct Ring {
+    explicit Ring(size_t capacity) : records(capacity), mask(capacity - 1) {}
+
+    std::vector<BinaryLogRecord> records;
+    const size_t mask;
+    alignas(64) std::atomic<uint64_t> head{0};
+    uint64_t cached_tail = 0;
+    alignas(64) std::atomic<uint64_t> tail{0};
+};
+
+struct SiteDef {
+    uint16_t id;
+    uint8_t level;
+    uint8_t arg_count;
+    std::array<BinaryArgKind, BinaryLogRecord::kMaxArgs> kinds;
+    std::string format;
+    std::string file;
+    uint32_t line;
+};
+
+struct State {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<Ring>> rings;
+    std::vector<SiteDef> sites;
+    size_t sites_written = 0;
+    size_t ring_capacity = 16384;
+    std::FILE* file = nullptr;
+    std::thread flusher;
+    std::atomic<bool> running{false};
+    std::atomic<uint64_t> dropped{0};
+    uint64_t dropped_written = 0;
+};
+
+State& state() {
+    static State s;
+    return s;
+}
+
+thread_local Ring* t_ring = nullptr;
+
+template<typename T>
+void put(std::FILE* f, const T& value) {
+    std::fwrite(&value, sizeof(T), 1, f);
+}
+
+void put_string(std::FILE* f, const std::string& s) {
+    uint16_t len = static_cast<uint16_t>(std::min<size_t>(s.size(), UINT16_MAX));
+    put(f, len);
+    std::fwrite(s.data(), 1, len, f);
+}
+
+// Caller holds state().mutex.
+void drain_locked(State& st) {
+    for (; st.sites_written < st.sites.size(); ++st.sites_written) {
+        const SiteDef& site = st.sites[st.sites_written];
+        std::fputc('S', st.file);
+        put(st.file, site.id);
+        put(st.file, site.level);
+        put(st.file, site.arg_count);
+        std::fwrite(site.kinds.data(), sizeof(BinaryArgKind), site.kinds.size(), st.file);
+        put_string(st.file, site.format);
+        put_string(st.file, site.file);
+        put(st.file, site.line);
+    }
+    for (auto& ring : st.rings) {
+        uint64_t tail = ring->tail.load(std::memory_order_relaxed);
+        uint64_t head = ring->head.load(std::memory_order_acquire);
+        for (; tail < head; ++tail) {
+            std::fputc('R', st.file);
+            put(st.file, ring->records[tail & ring->mask]);
+        }
+        ring->tail.store(tail, std::memory_order_release);
+    }
+    uint64_t dropped = st.dropped.load(std::memory_order_relaxed);
+    if (dropped != st.dropped_written) {
+        std::fputc('D', st.file);
+        put(st.file, dropped - st.dropped_written);
+        st.dropped_written = dropped;
+    }
+    std::fflush(st.file);
+}
+
+void flusher_loop() {
+    State& st = state();
+    while (st.running.load(std::memory_order_relaxed)) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        std::lock_guard<std::mutex> lock(st.mutex);
+        drain_locked(st);
+    }
+}
+
+}
+
+bool BinaryLog::open(const std::string& path, size_t ring_capacity) {
+    State& st = state();
+    std::lock_guard<std::mutex> lock(st.mutex);
+    if (st.file) {
+        spdlog::warn("Binary log is already open.");
+        return true;
+    }
+    std::error_code ec;
+    auto parent = std::filesystem::path(path).parent_path();
+    if (!parent.empty()) {
+        std::filesystem::create_directories(parent, ec);
+    }
+    st.file = std::fopen(path.c_str(), "wb");
+    if (!st.file) {
+        spdlog::error("Failed to open binary log file: {}", path);
+        return false;
+    }
+    // Round up to a power of two so the ring index is a mask.
+    size_t capacity = 1;
+    while (capacity < ring_capacity) capacity <<= 1;
+    st.ring_capacity = capacity;
+    st.sites_written = 0;
+    std::fwrite(kBinaryLogMagic, 1, sizeof(kBinaryLogMagic), st.file);
+    st.running = true;
+    st.flusher = std::thread(flusher_loop);
+    s_enabled = true;
+    spdlog::info("Binary hot-path log writing to {}", path);
+    return true;
+}
+
+void BinaryLog::close() {
+    State& st = state();
+    s_enabled = false;
+    st.running = false;
+    if (st.flusher.joinable()) {
+        st.flusher.join();
+    }
+    std::lock_guard<std::mutex> lock(st.mutex);
+    if (st.file) {
+        drain_locked(st);
+        std::fclose(st.file);
+        st.file = nullptr;
+    }
+}
+
+uint64_t BinaryLog::now_ns() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+}
+
+uint16_t BinaryLog::register_site(BinaryLogSite& site, spdlog::level::level_enum level, const char* format,
+                                  const char* file, int line, size_t arg_count, const BinaryArgKind* kinds) {
+    State& st = state();
+    std::lock_guard<std::mutex> lock(st.mutex);
+    uint16_t id = site.id.load(std::memory_order_relaxed);
+    if (id != 0) {
+        return id;
+    }
+    if (st.sites.size() >= UINT16_MAX - 1) {
+        return 0;
+    }
+    SiteDef def;
+    def.id = static_cast<uint16_t>(st.sites.size() + 1);
+    def.level = static_cast<uint8_t>(level);
+    def.arg_count = static_cast<uint8_t>(arg_count);
+    std::copy(kinds, kinds + BinaryLogRecord::kMaxArgs, def.kinds.begin());
+    def.format = format;
+    def.file = file;
+    def.line = static_cast<uint32_t>(line);
+    st.sites.push_back(std::move(def));
+    site.id.store(st.sites.back().id, std::memory_order_release);
+    return st.sites.back().id;
+}
+
+BinaryLogRecord* BinaryLog::claim() {
+    if (!t_ring) {
+        State& st = state();
+        auto ring = std::make_unique<Ring>(st.ring_capacity);
+        std::lock_guard<std::mutex> lock(st.mutex);
+        t_ring = ring.get();
+        st.rings.push_back(std::move(ring));
+    }
+    Ring& ring = *t_ring;
+    uint64_t head = ring.head.load(std::memory_order_relaxed);
+    if (head - ring.cached_tail >= ring.records.size()) {
+        ring.cached_tail = ring.tail.load(std::memory_order_acquire);
+        if (head - ring.cached_tail >= ring.records.size()) {
+            state().dropped.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+    }
+    return &ring.records[head & ring.mask];
+}
+
+void BinaryLog::publish() {
+    t_ring->head.store(t_ring->head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+}
@@ -1,61 +1,411 @@
 #include "ConfigHandler.hpp"
+#include "LaneQueue.hpp"
+#include "SessionCalendar.hpp"
+#include <cstring>
+#include <filesystem>
 #include <fstream>
+#include <poll.h>
+#include <set>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+namespace {
+
+// Editors and deploy tools often write a file in several steps; wait for
+// this much quiet before reloading.
+constexpr int kReloadSettleMs = 100;
+
+}
+
+ConfigHandler::~ConfigHandler() {
+    m_watching = false;
+    if (m_watcher.joinable()) {
+        m_watcher.join();
+    }
+}
+
+ConfigHandler& ConfigHandler::get_instance() {
+    static ConfigHandler instance;
+    return instance;
+}
 
 bool ConfigHandler::initialize(const std::string& config_path) {
     auto& instance = get_instance();
-    if (instance.m_initialized) {
+    if (instance.m_current.load(std::memory_order_acquire)) {
         spdlog::warn("ConfigHandler is already initialized.");
         return true;
     }
-    std::ifstream config_file(config_path);
+    instance.m_config_path = config_path;
+    auto config = std::make_unique<EngineConfig>();
+    if (!instance.load_file(*config)) {
+        return false;
+    }
+    instance.publish(std::move(config));
+    spdlog::info("ConfigHandler initialized successfully from {}", config_path);
+    return true;
+}
+
+const EngineConfig& ConfigHandler::current() {
+    const EngineConfig* config = get_instance().m_current.load(std::memory_order_acquire);
+    if (config) {
+        return *config;
+    }
+    static const EngineConfig defaults;
+    return defaults;
+}
+
+bool ConfigHandler::load_file(EngineConfig& config) const {
+    std::ifstream config_file(m_config_path);
     if (!config_file.is_open()) {
-        spdlog::critical("Failed to open configuration file: {}", config_path);
+        spdlog::critical("Failed to open configuration file: {}", m_config_path);
         return false;
     }
     try {
-        instance.m_config_json = nlohmann::json::parse(config_file);
-        instance.m_initialized = true;
-        spdlog::info("ConfigHandler initialized successfully from {}", config_path);
-        return true;
+        return compile(nlohmann::json::parse(config_file), config);
     } catch (const nlohmann::json::parse_error& e) {
-        spdlog::critical("Failed to parse config file: {}. Error: {}", config_path, e.what());
+        spdlog::critical("Failed to parse config file: {}. Error: {}", m_config_path, e.what());
         return false;
     }
 }
 
-ConfigHandler& ConfigHandler::get_instance() {
-    static ConfigHandler instance;
-    return instance;
+bool ConfigHandler::compile(const nlohmann::json& json, EngineConfig& config) {
+    bool ok = true;
+    ok &= read_value(json, "engine_settings.mode", config.engine_mode);
+    ok &= read_value(json, "engine_settings.log_file_path", config.log_file_path);
+    ok &= read_value(json, "engine_settings.log_mode", config.log_mode);
+    ok &= read_value(json, "engine_settings.log_queue_size", config.log_queue_size);
+    ok &= read_value(json, "engine_settings.binary_log_path", config.binary_log_path);
+    ok &= read_value(json, "engine_settings.contract_cache_path", config.contract_cache_path);
+    ok &= read_value(json, "engine_settings.contract_cache_max_age_hours", config.contract_cache_max_age_hours);
+    ok &= read_value(json, "engine_settings.gateway_reader_mode", config.gateway_reader_mode);
+    ok &= read_value(json, "engine_settings.worker_shards", config.worker_shards);
+    ok &= read_value(json, "engine_settings.lane_starvation_limit", config.lane_starvation_limit);
+    ok &= read_value(json, "risk_management.max_order_size", config.max_order_size);
+    ok &= read_value(json, "risk_management.max_position_value_usd", config.max_position_value);
+    ok &= read_value(json, "market_data_subscriptions", config.market_data_subscriptions);
+    ok &= read_value(json, "market_data_line_limit", config.market_data_line_limit);
+    ok &= read_value(json, "outbound_pacing.messages_per_second", config.outbound_messages_per_second);
+    ok &= read_value(json, "outbound_pacing.burst", config.outbound_burst);
+    ok &= read_value(json, "outbound_pacing.history_spacing_ms", config.history_request_spacing_ms);
+    ok &= read_value(json, "reconnect.initial_delay_ms", config.reconnect_initial_delay_ms);
+    ok &= read_value(json, "reconnect.max_delay_ms", config.reconnect_max_delay_ms);
+    ok &= read_value(json, "reconnect.connect_timeout_ms", config.connect_timeout_ms);
+    ok &= read_value(json, "journal.directory", config.journal_directory);
+    ok &= read_value(json, "journal.fsync", config.journal_fsync);
+    ok &= read_value(json, "journal.snapshot_every_records", config.journal_snapshot_every_records);
+    ok &= read_value(json, "flight_recorder.directory", config.flight_recorder_directory);
+    ok &= read_value(json, "flight_recorder.records_per_thread", config.flight_recorder_records_per_thread);
+    ok &= read_value(json, "tick_sizes", config.tick_sizes);
+    ok &= read_value(json, "scripting.publish_endpoint", config.scripting_publish_endpoint, true);
+    ok &= read_value(json, "scripting.subscribe_endpoint", config.scripting_subscribe_endpoint, true);
+    ok &= read_value(json, "telemetry.latency_stats", config.latency_stats);
+    ok &= read_value(json, "telemetry.stats_publish_interval_ms", config.stats_publish_interval_ms);
+    if (json.contains("sessions")) {
+        config.sessions = json.at("sessions");
+    }
+    if (json.contains("event_queue") && json.at("event_queue").is_object()) {
+        for (const auto& [lane, entry] : json.at("event_queue").items()) {
+            EngineConfig::EventQueueLane& queue = config.event_queue[lane];
+            ok &= read_value(entry, "capacity", queue.capacity);
+            ok &= read_value(entry, "policy", queue.policy);
+        }
+    }
+    if (json.contains("strategy_plugins")) {
+        for (const auto& entry : json.at("strategy_plugins")) {
+            EngineConfig::StrategyPlugin plugin;
+            ok &= read_value(entry, "id", plugin.id, true);
+            ok &= read_value(entry, "library", plugin.library, true);
+            ok &= read_value(entry, "symbols", plugin.symbols);
+            if (entry.contains("params")) {
+                plugin.params = entry.at("params");
+            }
+            config.strategy_plugins.push_back(std::move(plugin));
+        }
+    }
+    if (!ok) {
+        return false;
+    }
+
+    // Checked here once, so nothing downstream has to.
+    auto invalid = [&ok](const std::string& reason) {
+        spdlog::error("Invalid config: {}", reason);
+        ok = false;
+    };
+    if (config.log_mode != "sync" && config.log_mode != "async") {
+        invalid("engine_settings.log_mode must be \"sync\" or \"async\"");
+    }
+    if (config.gateway_reader_mode != "direct" && config.gateway_reader_mode != "threaded") {
+        invalid("engine_settings.gateway_reader_mode must be \"direct\" or \"threaded\"");
+    }
+    if (config.worker_shards < 1) {
+        invalid("engine_settings.worker_shards must be at least 1");
+    }
+    if (config.max_order_size <= 0 || config.max_position_value <= 0.0) {
+        invalid("risk_management limits must be positive");
+    }
+    if (config.outbound_messages_per_second <= 0.0 || config.outbound_burst < 1.0) {
+        invalid("outbound_pacing needs a positive rate and a burst of at least 1");
+    }
+    if (config.flight_recorder_records_per_thread <= 0) {
+        invalid("flight_recorder.records_per_thread must be positive");
+    }
+    if (config.stats_publish_interval_ms <= 0) {
+        invalid("telemetry.stats_publish_interval_ms must be positive");
+    }
+    for (const auto& [lane, queue] : config.event_queue) {
+        TradingEngine::OverflowPolicy policy;
+        if (queue.capacity < 0 || (!queue.policy.empty() && !TradingEngine::overflow_policy_from_string(queue.policy, policy))) {
+            invalid("event_queue." + lane + " has a bad capacity or policy");
+        }
+    }
+    for (const auto& [symbol, tick] : config.tick_sizes) {
+        if (tick <= 0.0) {
+            invalid("tick_sizes." + symbol + " must be positive");
+        }
+    }
+    std::set<std::string> plugin_ids;
+    for (const auto& plugin : config.strategy_plugins) {
+        if (plugin.id.empty() || plugin.id.find('.') != std::string::npos || !plugin_ids.insert(plugin.id).second) {
+            invalid("strategy_plugins ids must be unique, non-empty and free of '.'");
+        }
+        if (!plugin.params.is_object()) {
+            invalid("strategy_plugins." + plugin.id + ".params must be an object");
+        }
+    }
+    TradingEngine::SessionCalendar calendar;
+    if (!calendar.load(config.sessions)) {
+        invalid("sessions");
+    }
+    return ok;
+}
+
+void ConfigHandler::publish(std::unique_ptr<EngineConfig> config) {
+    const EngineConfig* previous = m_current.load(std::memory_order_acquire);
+    config->version = previous ? previous->version + 1 : 1;
+    const EngineConfig* published = config.get();
+    m_versions.push_back(std::move(config));
+    m_current.store(published, std::memory_order_release);
+    if (previous) {
+        for (const auto& listener : m_listeners) {
+            listener(*previous, *published);
+        }
+    }
+}
+
+bool ConfigHandler::reload() {
+    auto& instance = get_instance();
+    std::lock_guard<std::mutex> lock(instance.m_reload_mutex);
+    if (instance.m_config_path.empty()) {
+        spdlog::error("Config reload requested before initialize().");
+        return false;
+    }
+    auto config = std::make_unique<EngineConfig>();
+    if (!instance.load_file(*config)) {
+        spdlog::error("Config reload of {} failed; keeping version {}.", instance.m_config_path,
+                      current().version);
+        return false;
+    }
+    instance.publish(std::move(config));
+    spdlog::info("Config reloaded from {} (version {}).", instance.m_config_path, current().version);
+    return true;
+}
+
+void ConfigHandler::on_reload(ReloadListener listener) {
+    auto& instance = get_instance();
+    std::lock_guard<std::mutex> lock(instance.m_reload_mutex);
+    instance.m_listeners.push_back(std::move(listener));
+}
+
+bool ConfigHandler::start_watching() {
+    auto& instance = get_instance();
+    if (instance.m_watching.exchange(true)) {
+        return true;
+    }
+    std::filesystem::path path(instance.m_config_path);
+    std::string directory = path.has_parent_path() ? path.parent_path().string() : ".";
+    int fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (fd < 0 || inotify_add_watch(fd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE) < 0) {
+        spdlog::error("Cannot watch {} for config changes: {}", directory, std::strerror(errno));
+        if (fd >= 0) {
+            ::close(fd);
+        }
+        instance.m_watching = false;
+        return false;
+    }
+    instance.m_watcher = std::thread(&ConfigHandler::watch, &instance, fd);
+    spdlog::info("Watching {} for changes.", instance.m_config_path);
+    return true;
+}
+
+void ConfigHandler::stop_watching() {
+    auto& instance = get_instance();
+    instance.m_watching = false;
+    if (instance.m_watcher.joinable()) {
+        instance.m_watcher.join();
+    }
+}
+
+void ConfigHandler::watch(int inotify_fd) {
+    const std::string file_name = std::filesystem::path(m_config_path).filename().string();
+    alignas(inotify_event) char buffer[4096];
+    bool pending = false;
+    pollfd descriptor{inotify_fd, POLLIN, 0};
+    while (m_watching) {
+        // Short timeout: it both bounds stop_watching() and ends the settle wait.
+        int ready = ::poll(&descriptor, 1, pending ? kReloadSettleMs : 200);
+        if (ready > 0) {
+            ssize_t length = ::read(inotify_fd, buffer, sizeof(buffer));
+            for (ssize_t offset = 0; offset < length;) {
+                const auto* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+                if (event->len > 0 && file_name == event->name) {
+                    pending = true;
+                }
+                offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+            }
+        } else if (ready == 0 && pending) {
+            pending = false;
+            reload();
+        }
+    }
+    ::close(inotify_fd);
 }
 
 std::string ConfigHandler::get_engine_mode() {
-    return get_instance().get_value<std::string>("engine_settings.mode", "mock");
+    return current().engine_mode;
 }
 
 std::string ConfigHandler::get_log_file_path() {
-    return get_instance().get_value<std::string>("engine_settings.log_file_path", "logs/engine.log");
+    return current().log_file_path;
 }
 
 int ConfigHandler::get_max_order_size() {
-    return get_instance().get_value<int>("risk_management.max_order_size", 100);
+    return current().max_order_size;
 }
 
 double ConfigHandler::get_max_position_value() {
-    return get_instance().get_value<double>("risk_management.max_position_value_usd", 10000.0);
+    return current().max_position_value;
 }
 
 std::vector<std::string> ConfigHandler::get_market_data_subscriptions() {
-    auto& instance = get_instance();
-    if (instance.m_config_json.contains("market_data_subscriptions")) {
-        return instance.m_config_json.at("market_data_subscriptions").get<std::vector<std::string>>();
-    }
-    return {};
+    return current().market_data_subscriptions;
+}
+
+int ConfigHandler::get_market_data_line_limit() {
+    return current().market_data_line_limit;
+}
+
+double ConfigHandler::get_outbound_messages_per_second() {
+    return current().outbound_messages_per_second;
+}
+
+double ConfigHandler::get_outbound_burst() {
+    return current().outbound_burst;
+}
+
+int ConfigHandler::get_history_request_spacing_ms() {
+    return current().history_request_spacing_ms;
+}
+
+int ConfigHandler::get_reconnect_initial_delay_ms() {
+    return current().reconnect_initial_delay_ms;
+}
+
+int ConfigHandler::get_reconnect_max_delay_ms() {
+    return current().reconnect_max_delay_ms;
+}
+
+int ConfigHandler::get_connect_timeout_ms() {
+    return current().connect_timeout_ms;
+}
+
+std::string ConfigHandler::get_gateway_reader_mode() {
+    return current().gateway_reader_mode;
+}
+
+int ConfigHandler::get_worker_shards() {
+    return current().worker_shards;
+}
+
+int ConfigHandler::get_lane_starvation_limit() {
+    return current().lane_starvation_limit;
+}
+
+int ConfigHandler::get_event_queue_capacity(const std::string& lane, int default_capacity) {
+    const auto& lanes = current().event_queue;
+    auto it = lanes.find(lane);
+    return it != lanes.end() && it->second.capacity > 0 ? it->second.capacity : default_capacity;
+}
+
+std::string ConfigHandler::get_event_queue_policy(const std::string& lane, const std::string& default_policy) {
+    const auto& lanes = current().event_queue;
+    auto it = lanes.find(lane);
+    return it != lanes.end() && !it->second.policy.empty() ? it->second.policy : default_policy;
+}
+
+std::string ConfigHandler::get_journal_directory() {
+    return current().journal_directory;
+}
+
+bool ConfigHandler::get_journal_fsync() {
+    return current().journal_fsync;
+}
+
+int ConfigHandler::get_journal_snapshot_every_records() {
+    return current().journal_snapshot_every_records;
+}
+
+std::string ConfigHandler::get_flight_recorder_directory() {
+    return current().flight_recorder_directory;
+}
+
+int ConfigHandler::get_flight_recorder_records_per_thread() {
+    return current().flight_recorder_records_per_thread;
+}
+
+std::unordered_map<std::string, double> ConfigHandler::get_tick_sizes() {
+    return current().tick_sizes;
+}
+
+nlohmann::json ConfigHandler::get_sessions() {
+    return current().sessions;
+}
+
+std::vector<EngineConfig::StrategyPlugin> ConfigHandler::get_strategy_plugins() {
+    return current().strategy_plugins;
 }
 
 std::string ConfigHandler::get_scripting_publish_endpoint() {
-    return get_instance().get_required_value<std::string>("scripting.publish_endpoint");
+    return current().scripting_publish_endpoint;
 }
 
 std::string ConfigHandler::get_scripting_subscribe_endpoint() {
-    return get_instance().get_required_value<std::string>("scripting.subscribe_endpoint");
+    return current().scripting_subscribe_endpoint;
+}
+
+bool ConfigHandler::get_latency_stats_enabled() {
+    return current().latency_stats;
+}
+
+int ConfigHandler::get_stats_publish_interval_ms() {
+    return current().stats_publish_interval_ms;
+}
+
+std::string ConfigHandler::get_log_mode() {
+    return current().log_mode;
+}
+
+int ConfigHandler::get_log_queue_size() {
+    return current().log_queue_size;
+}
+
+std::string ConfigHandler::get_binary_log_path() {
+    return current().binary_log_path;
+}
+
+std::string ConfigHandler::get_contract_cache_path() {
+    return current().contract_cache_path;
+}
+
+int ConfigHandler::get_contract_cache_max_age_hours() {
+    return current().contract_cache_max_age_hours;
 }
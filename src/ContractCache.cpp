@@ -0,0 +1,220 @@
+#include "ContractCache.hpp"
+#include "LogHandler.hpp"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace TradingEngine {
+
+namespace {
+
+constexpr char kFileMagic[8] = {'T', 'E', 'C', 'O', 'N', 'T', 'R', '1'};
+constexpr uint32_t kFileCapacity = 4096;
+
+template<size_t N>
+void copy_field(char (&dest)[N], const std::string& src) {
+    std::memset(dest, 0, N);
+    std::memcpy(dest, src.data(), std::min(src.size(), N - 1));
+}
+
+template<size_t N>
+std::string read_field(const char (&src)[N]) {
+    return std::string(src, strnlen(src, N));
+}
+
+}
+
+struct ContractCache::FileHeader {
+    char magic[8];
+    uint32_t record_size;
+    uint32_t capacity;
+    uint32_t count;
+    uint32_t reserved;
+};
+
+struct ContractCache::Record {
+    char symbol[32];
+    char sec_type[8];
+    char currency[8];
+    char exchange[16];
+    char primary_exchange[16];
+    int64_t con_id;
+    int64_t min_tick_raw;
+    int64_t resolved_at;
+    char time_zone[40];
+    char trading_hours[832];
+};
+
+ContractCache::ContractCache()
+    : m_entries(std::make_unique<std::atomic<const ContractInfo*>[]>(SymbolTable::kMaxSymbols + 1)) {
+    for (size_t i = 0; i <= SymbolTable::kMaxSymbols; ++i) {
+        m_entries[i].store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+ContractCache::~ContractCache() {
+    close();
+}
+
+ContractCache& ContractCache::instance() {
+    static ContractCache cache;
+    return cache;
+}
+
+bool ContractCache::open(const std::string& path, std::chrono::hours max_age) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_map) {
+        spdlog::warn("Contract cache is already open.");
+        return true;
+    }
+    std::error_code ec;
+    auto parent = std::filesystem::path(path).parent_path();
+    if (!parent.empty()) {
+        std::filesystem::create_directories(parent, ec);
+    }
+    m_fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (m_fd < 0) {
+        spdlog::error("Failed to open contract cache file: {}", path);
+        return false;
+    }
+    m_map_size = sizeof(FileHeader) + sizeof(Record) * kFileCapacity;
+    struct stat st{};
+    bool fresh = ::fstat(m_fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(FileHeader);
+    if (::ftruncate(m_fd, static_cast<off_t>(m_map_size)) != 0) {
+        spdlog::error("Failed to size contract cache file: {}", path);
+        ::close(m_fd);
+        m_fd = -1;
+        return false;
+    }
+    m_map = ::mmap(nullptr, m_map_size, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+    if (m_map == MAP_FAILED) {
+        spdlog::error("Failed to map contract cache file: {}", path);
+        m_map = nullptr;
+        ::close(m_fd);
+        m_fd = -1;
+        return false;
+    }
+
+    auto* header = static_cast<FileHeader*>(m_map);
+    if (fresh || std::memcmp(header->magic, kFileMagic, sizeof(kFileMagic)) != 0 ||
+        header->record_size != sizeof(Record) || header->capacity != kFileCapacity) {
+        if (!fresh) {
+            spdlog::warn("Contract cache {} has an incompatible layout; starting empty.", path);
+        }
+        std::memset(m_map, 0, m_map_size);
+        std::memcpy(header->magic, kFileMagic, sizeof(kFileMagic));
+        header->record_size = sizeof(Record);
+        header->capacity = kFileCapacity;
+        header->count = 0;
+    }
+
+    auto* records = reinterpret_cast<Record*>(header + 1);
+    int64_t now = std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    int64_t max_age_s = std::chrono::duration_cast<std::chrono::seconds>(max_age).count();
+    size_t loaded = 0;
+    for (uint32_t slot = 0; slot < header->count && slot < kFileCapacity; ++slot) {
+        const Record& record = records[slot];
+        ContractInfo info;
+        info.symbol = read_field(record.symbol);
+        info.symbol_id = SymbolTable::instance().intern(info.symbol);
+        if (info.symbol_id == kInvalidSymbolId) {
+            continue;
+        }
+        // Keep the slot even when stale so re-resolution overwrites it in place.
+        m_record_slots[info.symbol_id] = slot;
+        if (now - record.resolved_at > max_age_s) {
+            continue;
+        }
+        info.con_id = static_cast<long>(record.con_id);
+        info.sec_type = read_field(record.sec_type);
+        info.exchange = read_field(record.exchange);
+        info.primary_exchange = read_field(record.primary_exchange);
+        info.currency = read_field(record.currency);
+        info.min_tick = Price::from_raw(record.min_tick_raw);
+        info.time_zone = read_field(record.time_zone);
+        info.trading_hours = read_field(record.trading_hours);
+        info.resolved_at = record.resolved_at;
+        const ContractInfo& stored = m_storage.emplace_back(std::move(info));
+        m_entries[stored.symbol_id].store(&stored, std::memory_order_release);
+        ++loaded;
+    }
+    spdlog::info("Contract cache {} loaded {} of {} entries.", path, loaded, header->count);
+    return true;
+}
+
+void ContractCache::close() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_map) {
+        ::msync(m_map, m_map_size, MS_SYNC);
+        ::munmap(m_map, m_map_size);
+        m_map = nullptr;
+    }
+    if (m_fd >= 0) {
+        ::close(m_fd);
+        m_fd = -1;
+    }
+}
+
+void ContractCache::store(const ContractInfo& info) {
+    if (info.symbol_id == kInvalidSymbolId || info.symbol_id > SymbolTable::kMaxSymbols) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const ContractInfo& stored = m_storage.emplace_back(info);
+    m_entries[info.symbol_id].store(&stored, std::memory_order_release);
+    persist_locked(stored);
+}
+
+size_t ContractCache::size() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    size_t count = 0;
+    for (size_t i = 1; i <= SymbolTable::kMaxSymbols; ++i) {
+        if (m_entries[i].load(std::memory_order_relaxed)) ++count;
+    }
+    return count;
+}
+
+void ContractCache::persist_locked(const ContractInfo& info) {
+    if (!m_map) {
+        return;
+    }
+    auto* header = static_cast<FileHeader*>(m_map);
+    auto* records = reinterpret_cast<Record*>(header + 1);
+    uint32_t slot;
+    auto it = m_record_slots.find(info.symbol_id);
+    bool append = it == m_record_slots.end();
+    if (!append) {
+        slot = it->second;
+    } else if (header->count < kFileCapacity) {
+        slot = header->count;
+    } else {
+        spdlog::warn("Contract cache file is full; {} will not persist.", info.symbol);
+        return;
+    }
+    Record& record = records[slot];
+    copy_field(record.symbol, info.symbol);
+    copy_field(record.sec_type, info.sec_type);
+    copy_field(record.currency, info.currency);
+    copy_field(record.exchange, info.exchange);
+    copy_field(record.primary_exchange, info.primary_exchange);
+    record.con_id = info.con_id;
+    record.min_tick_raw = info.min_tick.raw();
+    record.resolved_at = info.resolved_at;
+    copy_field(record.time_zone, info.time_zone);
+    copy_field(record.trading_hours, info.trading_hours);
+    if (info.trading_hours.size() >= sizeof(record.trading_hours)) {
+        spdlog::debug("Trading hours for {} truncated in the contract cache.", info.symbol);
+    }
+    if (append) {
+        // Publish the count only after the record is fully written.
+        m_record_slots[info.symbol_id] = slot;
+        header->count = slot + 1;
+    }
+}
+
+}
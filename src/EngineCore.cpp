@@ -5,23 +5,129 @@
 #include "IBKRGatewayClient.hpp"
 #include "I_MarketDataHandler.hpp"
 #include "IBKRConverters.hpp"
+#include "OrderJournal.hpp"
+#include "FlightRecorder.hpp"
+#include "OrderLifecycle.hpp"
+#include <nlohmann/json.hpp>
+#include <cmath>
+#include <pthread.h>
 #include <variant>
 
 namespace TradingEngine {
 
+namespace {
+// Set on the control loop and shard workers. A loop that blocked on a full
+// queue could be the one that has to drain it, so their posts never block.
+thread_local bool t_on_event_loop = false;
+
+// Timers and session times are wall-clock, so the calendar lines up with UTC.
+int64_t wall_clock_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+// The ids, quantities and prices that say what an event was about.
+void record_flight(const Event& event) {
+    if (!FlightRecorder::enabled()) {
+        return;
+    }
+    const auto code = static_cast<uint8_t>(event.type);
+    switch (event.type) {
+        case EventType::TICK: {
+            const Tick& tick = std::get<Tick>(event.data);
+            FlightRecorder::record(FlightKind::EVENT, code, tick.symbol_id, static_cast<uint64_t>(tick.price.raw()));
+            break;
+        }
+        case EventType::ORDER_REQUEST:
+        case EventType::SEND_NEW_ORDER: {
+            const Order& order = std::get<Order>(event.data);
+            FlightRecorder::record(FlightKind::EVENT, code, order.symbol_id, order.order_id,
+                                   static_cast<uint64_t>(order.quantity.raw()), static_cast<uint16_t>(order.side));
+            break;
+        }
+        case EventType::EXECUTION_REPORT: {
+            const ExecutionReport& report = std::get<ExecutionReport>(event.data);
+            // Reports carry the symbol as text only; the order id identifies it.
+            FlightRecorder::record(FlightKind::EVENT, code, 0, report.order_id,
+                                   static_cast<uint64_t>(report.fill_quantity.raw()),
+                                   static_cast<uint16_t>(report.new_status));
+            break;
+        }
+        case EventType::CANCEL_ORDER_REQUEST:
+            FlightRecorder::record(FlightKind::EVENT, code, 0, std::get<CancelRequest>(event.data).order_id);
+            break;
+        case EventType::MODIFY_ORDER_REQUEST:
+            FlightRecorder::record(FlightKind::EVENT, code, 0, std::get<ModifyRequest>(event.data).order_id);
+            break;
+        default:
+            FlightRecorder::record(FlightKind::EVENT, code);
+            break;
+    }
+}
+}
+
+thread_local EngineCore::Shard* EngineCore::s_current_shard = nullptr;
+
+class EngineCore::PluginContext : public StrategyContext {
+public:
+    PluginContext(EngineCore& engine, std::string strategy_id)
+        : m_engine(engine), m_strategy_id(std::move(strategy_id)) {}
+
+    const std::string& strategy_id() const override { return m_strategy_id; }
+
+    uint64_t submit_order(Order order) override {
+        order.strategy_id = m_strategy_id;
+        return m_engine.submit_strategy_order(order);
+    }
+
+    bool cancel_order(uint64_t order_id) override {
+        return m_engine.cancel_strategy_order(order_id, m_strategy_id);
+    }
+
+    // Only the calling shard's positions can be read without a race.
+    Quantity position(const std::string& symbol) const override {
+        Shard* shard = s_current_shard;
+        if (!shard) {
+            return Quantity{};
+        }
+        return shard->order_manager->get_strategy_position(m_strategy_id, symbol).position;
+    }
+
+private:
+    EngineCore& m_engine;
+    std::string m_strategy_id;
+};
+
 EngineCore::EngineCore(OrderManager& order_manager, std::string pub, std::string sub)
     : m_is_running(false),
       m_order_manager(order_manager),
       m_market_data_handler(nullptr),
       m_execution_handler(nullptr),
       m_gateway_client(nullptr),
-      m_scripting_interface(*this, pub, sub) {}
+      m_scripting_interface(*this, pub, sub),
+      m_timers(static_cast<uint64_t>(wall_clock_ns())) {
+    auto& stats = StatsRegistry::instance();
+    for (size_t i = 0; i < kEventTypeCount; ++i) {
+        m_event_counters[i] = &stats.counter("events." + event_type_to_string(static_cast<EventType>(i)));
+    }
+    m_queue_depth = &stats.gauge("event_queue.depth");
+    m_queue_depth_max = &stats.gauge("event_queue.depth_max");
+    m_lane_stats = register_lane_stats("event_lane");
+    configure_queue(m_event_queue);
+    m_portfolio_exposure = &stats.gauge("portfolio.gross_exposure");
+    m_portfolio_open_orders = &stats.gauge("portfolio.open_orders");
+    m_active_timers = &stats.gauge("timers.active");
+    m_risk_rejects = &stats.counter("risk.rejected");
+    auto shard = std::make_unique<Shard>();
+    shard->order_manager = &m_order_manager;
+    m_shards.push_back(std::move(shard));
+}
 
 void EngineCore::set_market_data_handler(I_MarketDataHandler* md_handler) {
     m_market_data_handler = md_handler;
 }
 
-void EngineCore::set_execution_handler(IBKRExecutionHandler* exec_handler) {
+void EngineCore::set_execution_handler(I_ExecutionHandler* exec_handler) {
     m_execution_handler = exec_handler;
 }
 
@@ -29,12 +135,139 @@ void EngineCore::set_gateway_client(IBKRGatewayClient* gateway_client) {
     m_gateway_client = gateway_client;
 }
 
+void EngineCore::set_order_journal(OrderJournal* journal, size_t shard) {
+    if (shard >= m_shards.size()) {
+        spdlog::error("Cannot attach an order journal to shard {}; there are {} shard(s).", shard, m_shards.size());
+        return;
+    }
+    m_shards[shard]->journal = journal;
+}
+
+void EngineCore::set_lane_starvation_limit(size_t limit) {
+    m_lane_starvation_limit = limit;
+    m_event_queue.set_starvation_limit(limit);
+    for (auto& shard : m_shards) {
+        shard->queue.set_starvation_limit(limit);
+    }
+}
+
+void EngineCore::set_event_queue_config(const std::array<LaneConfig, kEventLaneCount>& config) {
+    if (m_is_running) {
+        spdlog::error("The event queues cannot be resized while the engine is running.");
+        return;
+    }
+    m_queue_config = config;
+    configure_queue(m_event_queue);
+    for (auto& shard : m_shards) {
+        configure_queue(shard->queue);
+    }
+}
+
+void EngineCore::set_session_calendar(SessionCalendar calendar) {
+    if (m_is_running) {
+        spdlog::error("The session calendar cannot change while the engine is running.");
+        return;
+    }
+    m_calendar = std::move(calendar);
+}
+
+bool EngineCore::load_strategy_plugin(const StrategyPluginConfig& config) {
+    if (m_is_running) {
+        spdlog::error("Strategy plugin {} not loaded: the engine is already running.", config.id);
+        return false;
+    }
+    return m_strategies.load(config, std::make_unique<PluginContext>(*this, config.id));
+}
+
+void EngineCore::configure_queue(EventQueue& queue) {
+    queue.configure(m_queue_config, &EngineCore::conflation_key, SymbolTable::kMaxSymbols + 1);
+}
+
+// Ticks conflate per symbol; nothing else has a key.
+uint32_t EngineCore::conflation_key(const Event& event) {
+    if (event.type != EventType::TICK) {
+        return 0;
+    }
+    return std::get<Tick>(event.data).symbol_id;
+}
+
+EngineCore::LaneStats EngineCore::register_lane_stats(const std::string& prefix) {
+    auto& stats = StatsRegistry::instance();
+    LaneStats lane_stats;
+    lane_stats.prefix = prefix;
+    for (size_t lane = 0; lane < kEventLaneCount; ++lane) {
+        std::string name = prefix + "." + event_lane_to_string(static_cast<EventLane>(lane));
+        lane_stats.depth[lane] = &stats.gauge(name + ".depth");
+        lane_stats.wait[lane] = &stats.histogram(name + ".wait_ns");
+        lane_stats.dropped[lane] = &stats.counter(name + ".dropped");
+        lane_stats.conflated[lane] = &stats.counter(name + ".conflated");
+        lane_stats.rejected[lane] = &stats.counter(name + ".rejected");
+        lane_stats.blocked[lane] = &stats.counter(name + ".blocked");
+    }
+    return lane_stats;
+}
+
+void EngineCore::push_event(EventQueue& queue, Event event, bool may_block) {
+    EventLane lane = event_lane(event.type);
+    EventType type = event.type;
+    if (!queue.push(static_cast<size_t>(lane), std::move(event), may_block) && lane == EventLane::CONTROL) {
+        // Market data and bulk overflow is reported in aggregate; a lost control
+        // event (an order, a fill) deserves its own line.
+        spdlog::error("Event queue full: {} event rejected.", event_type_to_string(type));
+    }
+}
+
+void EngineCore::set_worker_count(size_t workers) {
+    if (m_is_running) {
+        spdlog::error("The worker count cannot change while the engine is running.");
+        return;
+    }
+    workers = std::max<size_t>(workers, 1);
+    m_shards.resize(std::min(workers, m_shards.size()));
+    while (m_shards.size() < workers) {
+        auto shard = std::make_unique<Shard>();
+        shard->index = m_shards.size();
+        shard->owned_order_manager = std::make_unique<OrderManager>();
+        shard->owned_order_manager->share_order_ids(m_order_manager);
+        shard->order_manager = shard->owned_order_manager.get();
+        shard->queue.set_starvation_limit(m_lane_starvation_limit);
+        configure_queue(shard->queue);
+        m_shards.push_back(std::move(shard));
+    }
+    if (workers > 1) {
+        for (auto& shard : m_shards) {
+            std::string prefix = "shard." + std::to_string(shard->index);
+            shard->queue_depth = &StatsRegistry::instance().gauge(prefix + ".queue_depth");
+            shard->lane_stats = register_lane_stats(prefix);
+        }
+    }
+    spdlog::info("EngineCore configured with {} worker shard(s).", workers);
+}
+
+OrderManager& EngineCore::shard_order_manager(size_t shard) {
+    return *m_shards.at(shard)->order_manager;
+}
+
+PortfolioSnapshot EngineCore::portfolio_snapshot() const {
+    PortfolioSnapshot snapshot;
+    for (const auto& shard : m_shards) {
+        snapshot.gross_exposure += shard->published_exposure.load(std::memory_order_relaxed);
+        snapshot.open_orders += shard->published_open_orders.load(std::memory_order_relaxed);
+    }
+    snapshot.shards = m_shards.size();
+    return snapshot;
+}
+
 void EngineCore::set_mode(std::string mode) {
     m_mode = mode;
 }
 
 std::string EngineCore::get_mode() { return m_mode; }
 
+void EngineCore::set_stats_publish_interval(std::chrono::milliseconds interval) {
+    m_stats_interval = interval;
+}
+
 void EngineCore::start_data_feed() {
     m_market_data_handler->start();
 }
@@ -47,8 +280,57 @@ void EngineCore::startup() {
 
 void EngineCore::run() {
     m_is_running = true;
-    spdlog::info("EngineCore event loop is starting...");
+    m_next_stats_publish = std::chrono::steady_clock::now() + m_stats_interval;
+    m_next_overload_check = m_next_stats_publish;
+    const int64_t now_ns = wall_clock_ns();
+    for (const auto& exchange : m_calendar.exchanges()) {
+        spdlog::info("{} is {}.", exchange, m_calendar.is_open(exchange, now_ns) ? "open" : "closed");
+        schedule_next_session_event(exchange, now_ns);
+    }
+    m_strategies.start();
+    const bool sharded = m_shards.size() > 1;
+    if (sharded) {
+        // Orders recovered from the journals, so events naming them find their shard.
+        {
+            std::lock_guard<std::mutex> lock(m_order_shards_mutex);
+            for (const auto& shard : m_shards) {
+                for (const auto& order : shard->order_manager->export_state().orders) {
+                    if (!is_terminal(order.status)) {
+                        m_order_shards[order.order_id] = shard->index;
+                    }
+                }
+            }
+        }
+        for (auto& shard : m_shards) {
+            publish_shard_state(*shard);
+            shard->worker = std::thread(&EngineCore::run_shard, this, std::ref(*shard));
+        }
+        spdlog::info("EngineCore event loop is starting with {} worker shards...", m_shards.size());
+    } else {
+        spdlog::info("EngineCore event loop is starting...");
+    }
     process_events();
+    if (sharded) {
+        // Workers finish what is already queued, then stop.
+        for (auto& shard : m_shards) {
+            Event shutdown_event;
+            shutdown_event.type = EventType::SYSTEM_SHUTDOWN;
+            push_event(shard->queue, std::move(shutdown_event), true);
+        }
+        for (auto& shard : m_shards) {
+            if (shard->worker.joinable()) {
+                shard->worker.join();
+            }
+            shard->queue.close();
+        }
+    }
+    m_strategies.stop();
+    // Nothing drains the queues any more; producers must not wait on them.
+    m_event_queue.close();
+    check_overload(m_event_queue, m_lane_stats);
+    if (LatencyStats::enabled()) {
+        StatsRegistry::instance().log_summary();
+    }
     m_scripting_interface.stop();
     spdlog::info("EngineCore has stopped.");
 }
@@ -60,92 +342,818 @@ void EngineCore::stop() {
 }
 
 void EngineCore::post_event(Event event) {
-    m_event_queue.push(std::move(event));
+    event.trace.stamp(LatencyStage::ENQUEUE);
+    if (event.type == EventType::TICK) {
+        // Routing and conflation both key on the id.
+        Tick& tick = std::get<Tick>(event.data);
+        if (tick.symbol_id == kInvalidSymbolId) {
+            tick.symbol_id = SymbolTable::instance().intern(tick.symbol);
+        }
+    }
+    const bool may_block = !t_on_event_loop;
+    if (m_shards.size() > 1 && route_to_shard(event, may_block)) {
+        return;
+    }
+    push_event(m_event_queue, std::move(event), may_block);
+}
+
+size_t EngineCore::shard_for_symbol(SymbolId symbol_id) const {
+    return symbol_id % m_shards.size();
+}
+
+size_t EngineCore::shard_for_order(uint64_t order_id, const std::string& symbol) {
+    {
+        std::lock_guard<std::mutex> lock(m_order_shards_mutex);
+        auto it = m_order_shards.find(order_id);
+        if (it != m_order_shards.end()) {
+            return it->second;
+        }
+    }
+    // Not placed by this engine: the symbol's shard owns its position.
+    return symbol.empty() ? 0 : shard_for_symbol(SymbolTable::instance().intern(symbol));
+}
+
+void EngineCore::forget_order_shard(uint64_t order_id) {
+    if (m_shards.size() == 1) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(m_order_shards_mutex);
+    m_order_shards.erase(order_id);
+}
+
+bool EngineCore::route_to_shard(Event& event, bool may_block) {
+    size_t shard = 0;
+    switch (event.type) {
+        case EventType::TICK:
+            shard = shard_for_symbol(std::get<Tick>(event.data).symbol_id);
+            break;
+        case EventType::ORDER_REQUEST: {
+            Order& order = std::get<Order>(event.data);
+            order.symbol_id = SymbolTable::instance().intern(order.symbol);
+            shard = shard_for_symbol(order.symbol_id);
+            break;
+        }
+        case EventType::HISTORICAL_DATA:
+            shard = shard_for_symbol(SymbolTable::instance().intern(std::get<Bar>(event.data).symbol));
+            break;
+        case EventType::EXECUTION_REPORT: {
+            const auto& report = std::get<ExecutionReport>(event.data);
+            shard = shard_for_order(report.order_id, report.symbol);
+            break;
+        }
+        case EventType::CANCEL_ORDER_REQUEST:
+            shard = shard_for_order(std::get<CancelRequest>(event.data).order_id, "");
+            break;
+        case EventType::MODIFY_ORDER_REQUEST:
+            shard = shard_for_order(std::get<ModifyRequest>(event.data).order_id, "");
+            break;
+        case EventType::CANCEL_ALL_REQUEST: {
+            const auto& request = std::get<CancelRequest>(event.data);
+            if (!request.symbol.empty()) {
+                shard = shard_for_symbol(SymbolTable::instance().intern(request.symbol));
+                break;
+            }
+            // Strategy-wide or everything: each shard cancels what it owns.
+            for (auto& target : m_shards) {
+                push_event(target->queue, event, may_block);
+            }
+            return true;
+        }
+        case EventType::RECONCILIATION: {
+            // Split the broker's view so each shard reconciles only what it owns.
+            const auto& snapshot = std::get<BrokerSnapshot>(event.data);
+            std::vector<BrokerSnapshot> slices(m_shards.size());
+            for (const auto& order : snapshot.open_orders) {
+                slices[shard_for_order(order.order_id, order.symbol)].open_orders.push_back(order);
+            }
+            for (const auto& execution : snapshot.executions) {
+                slices[shard_for_order(execution.order_id, execution.symbol)].executions.push_back(execution);
+            }
+            for (const auto& [symbol, position] : snapshot.positions) {
+                slices[shard_for_symbol(SymbolTable::instance().intern(symbol))].positions[symbol] = position;
+            }
+            for (uint64_t order_id : snapshot.unsent_orders) {
+                slices[shard_for_order(order_id, "")].unsent_orders.push_back(order_id);
+            }
+            for (auto& slice : slices) {
+                slice.requested_at = snapshot.requested_at;
+            }
+            m_reconcile_corrections = 0;
+            m_reconcile_pending = m_shards.size();
+            for (size_t i = 0; i < m_shards.size(); ++i) {
+                Event slice;
+                slice.type = EventType::RECONCILIATION;
+                slice.data = std::move(slices[i]);
+                slice.trace = event.trace;
+                push_event(m_shards[i]->queue, std::move(slice), may_block);
+            }
+            return true;
+        }
+        default:
+            return false;
+    }
+    push_event(m_shards[shard]->queue, std::move(event), may_block);
+    return true;
+}
+
+void EngineCore::publish_stats_if_due() {
+    auto now = std::chrono::steady_clock::now();
+    if (now < m_next_stats_publish) {
+        return;
+    }
+    m_next_stats_publish = now + m_stats_interval;
+    m_queue_depth->set(static_cast<int64_t>(m_event_queue.size()));
+    for (size_t lane = 0; lane < kEventLaneCount; ++lane) {
+        m_lane_stats.depth[lane]->set(static_cast<int64_t>(m_event_queue.size(lane)));
+    }
+    for (const auto& shard : m_shards) {
+        if (shard->queue_depth) {
+            shard->queue_depth->set(static_cast<int64_t>(shard->queue.size()));
+            for (size_t lane = 0; lane < kEventLaneCount; ++lane) {
+                shard->lane_stats.depth[lane]->set(static_cast<int64_t>(shard->queue.size(lane)));
+            }
+        }
+    }
+    PortfolioSnapshot portfolio = portfolio_snapshot();
+    m_portfolio_exposure->set(static_cast<int64_t>(std::llround(portfolio.gross_exposure)));
+    m_portfolio_open_orders->set(static_cast<int64_t>(portfolio.open_orders));
+    m_active_timers->set(static_cast<int64_t>(m_timers.size()));
+    auto stats = StatsRegistry::instance().snapshot();
+    m_queue_depth_max->set(0);
+    m_scripting_interface.publish_stats(stats.dump());
+}
+
+void EngineCore::run_timers() {
+    if (m_timers.size() != 0) {
+        m_timers.advance(static_cast<uint64_t>(wall_clock_ns()));
+    }
+}
+
+std::chrono::nanoseconds EngineCore::next_wait() const {
+    std::chrono::nanoseconds wait = m_stats_interval;
+    uint64_t until_timer = m_timers.ns_until_next(static_cast<uint64_t>(wall_clock_ns()));
+    if (until_timer < static_cast<uint64_t>(wait.count())) {
+        wait = std::chrono::nanoseconds(until_timer);
+    }
+    return wait;
+}
+
+void EngineCore::schedule_next_session_event(const std::string& exchange, int64_t after_ns) {
+    auto next = m_calendar.next_event(exchange, after_ns);
+    if (!next) {
+        spdlog::warn("No {} session event in the coming month; session events for it have stopped.", exchange);
+        return;
+    }
+    m_timers.schedule_at(static_cast<uint64_t>(next->time_ns), [this, event = *next](TimerId) {
+        spdlog::info("{} session event: {}", event.exchange, event.name);
+        m_scripting_interface.publish_session_event(event, wall_clock_ns());
+        schedule_next_session_event(event.exchange, event.time_ns);
+    });
+}
+
+void EngineCore::handle_timer_request(const TimerRequest& request) {
+    std::string key = request.strategy_id + "." + request.name;
+    auto it = m_strategy_timers.find(key);
+    if (it != m_strategy_timers.end()) {
+        m_timers.cancel(it->second);
+        m_strategy_timers.erase(it);
+    }
+    if (request.cancel) {
+        return;
+    }
+    constexpr int64_t kNsPerMs = 1000000;
+    const bool repeating = request.interval_ms > 0;
+    uint64_t deadline = static_cast<uint64_t>(wall_clock_ns() + request.delay_ms * kNsPerMs);
+    TimerId id = m_timers.schedule_at(
+        deadline,
+        [this, key, strategy_id = request.strategy_id, name = request.name, repeating](TimerId) {
+            if (!repeating) {
+                m_strategy_timers.erase(key);
+            }
+            m_scripting_interface.publish_timer(strategy_id, name, wall_clock_ns());
+        },
+        static_cast<uint64_t>(request.interval_ms * kNsPerMs));
+    m_strategy_timers[key] = id;
+}
+
+void EngineCore::check_overload_if_due() {
+    auto now = std::chrono::steady_clock::now();
+    if (now < m_next_overload_check) {
+        return;
+    }
+    m_next_overload_check = now + m_stats_interval;
+    check_overload(m_event_queue, m_lane_stats);
+    if (m_shards.size() > 1) {
+        for (auto& shard : m_shards) {
+            check_overload(shard->queue, shard->lane_stats);
+        }
+    }
+}
+
+// Runs on the control thread only, so the reported totals need no lock.
+void EngineCore::check_overload(const EventQueue& queue, LaneStats& lane_stats) {
+    for (size_t lane = 0; lane < kEventLaneCount; ++lane) {
+        LaneOverload current = queue.overload(lane);
+        LaneOverload& reported = lane_stats.reported[lane];
+        uint64_t dropped = current.dropped - reported.dropped;
+        uint64_t conflated = current.conflated - reported.conflated;
+        uint64_t rejected = current.rejected - reported.rejected;
+        uint64_t blocked = current.blocked - reported.blocked;
+        if (dropped + conflated + rejected + blocked == 0) {
+            continue;
+        }
+        reported = current;
+        lane_stats.dropped[lane]->add(dropped);
+        lane_stats.conflated[lane]->add(conflated);
+        lane_stats.rejected[lane]->add(rejected);
+        lane_stats.blocked[lane]->add(blocked);
+
+        nlohmann::json alert;
+        alert["type"] = "QUEUE_OVERLOAD";
+        alert["queue"] = lane_stats.prefix;
+        alert["lane"] = event_lane_to_string(static_cast<EventLane>(lane));
+        alert["capacity"] = queue.capacity(lane);
+        alert["depth"] = queue.size(lane);
+        alert["dropped"] = dropped;
+        alert["conflated"] = conflated;
+        alert["rejected"] = rejected;
+        alert["blocked"] = blocked;
+        spdlog::warn("Event queue overload on {} {}: dropped {}, conflated {}, rejected {}, blocked {}.",
+                     lane_stats.prefix, event_lane_to_string(static_cast<EventLane>(lane)),
+                     dropped, conflated, rejected, blocked);
+        m_scripting_interface.publish_alert(alert.dump());
+    }
+}
+
+// Each queue has its own LaneStats, so every wait histogram has one writer.
+void EngineCore::record_dequeue(const Event& event, const EventQueue& queue, LaneStats& lane_stats) {
+    m_event_counters[static_cast<size_t>(event.type)]->add();
+    m_queue_depth_max->update_max(static_cast<int64_t>(queue.size()) + 1);
+    uint64_t wait = event.trace.elapsed(LatencyStage::ENQUEUE, LatencyStage::DEQUEUE);
+    if (wait != 0) {
+        lane_stats.wait[static_cast<size_t>(event_lane(event.type))]->record(wait);
+    }
+}
+
+void EngineCore::run_shard(Shard& shard) {
+    t_on_event_loop = true;
+    s_current_shard = &shard;
+    pthread_setname_np(pthread_self(), ("shard-" + std::to_string(shard.index)).c_str());
+    spdlog::info("Shard {} worker started.", shard.index);
+    while (true) {
+        Event event;
+        shard.queue.wait_and_pop(event);
+        record_flight(event);
+        if (event.type == EventType::SYSTEM_SHUTDOWN) {
+            break;
+        }
+        event.trace.stamp(LatencyStage::DEQUEUE);
+        if (LatencyStats::enabled()) {
+            record_dequeue(event, shard.queue, shard.lane_stats);
+        }
+        handle_shard_event(event, shard);
+    }
+    // As in process_events: don't drop what was queued before the shutdown.
+    for (size_t remaining = shard.queue.size(); remaining > 0; --remaining) {
+        Event event;
+        if (!shard.queue.try_pop(event)) {
+            break;
+        }
+        if (event.type != EventType::SYSTEM_SHUTDOWN) {
+            handle_shard_event(event, shard);
+        }
+    }
+    spdlog::info("Shard {} worker stopped.", shard.index);
 }
 
 void EngineCore::process_events() {
+    // Single-threaded mode handles shard events inline; in sharded mode
+    // post_event routes them to the workers and they never arrive here.
+    Shard& inline_shard = *m_shards.front();
+    t_on_event_loop = true;
+    if (m_shards.size() == 1) {
+        s_current_shard = &inline_shard;
+    }
     while (m_is_running) {
         Event event;
-        m_event_queue.wait_and_pop(event);
-        switch (event.type) {
-            case EventType::TICK:
-                handle_tick_event(std::get<Tick>(event.data));
-                break;
-            
-            case EventType::SYSTEM_SHUTDOWN:
-                m_is_running = false;
-                break;
-            
-            case EventType::SUBSCRIBE_REQUEST: {
-                if (const auto* topic_ptr = std::get_if<std::string>(&event.data)) {
-                    if (m_gateway_client) {
-                        m_gateway_client->subscribe_to_market_data(*topic_ptr);
-                    } else {
-                        spdlog::warn("Received SUBSCRIBE_REQUEST but gateway client is not set.");
-                    }
-                }
-                break;
+        if (!m_event_queue.wait_and_pop_for(event, next_wait())) {
+            run_timers();
+            check_overload_if_due();
+            if (LatencyStats::enabled()) {
+                publish_stats_if_due();
             }
+            continue;
+        }
+        record_flight(event);
+        run_timers();
+        check_overload_if_due();
+        event.trace.stamp(LatencyStage::DEQUEUE);
+        if (LatencyStats::enabled()) {
+            record_dequeue(event, m_event_queue, m_lane_stats);
+            publish_stats_if_due();
+        }
+        dispatch(event, inline_shard);
+    }
+    // Starvation protection can serve the shutdown ahead of queued ticks;
+    // finish what was already queued rather than drop it.
+    for (size_t remaining = m_event_queue.size(); remaining > 0; --remaining) {
+        Event event;
+        if (!m_event_queue.try_pop(event)) {
+            break;
+        }
+        if (event.type != EventType::SYSTEM_SHUTDOWN) {
+            dispatch(event, inline_shard);
+        }
+    }
+}
 
-            case EventType::ORDER_REQUEST: {
-                Order order = std::get<Order>(event.data);
-                spdlog::info("EngineCore processing order request for {} {} {}", 
-                     side_to_string(order.side), order.quantity, order.symbol);
-
-                m_order_manager.add_new_order(order);
+void EngineCore::dispatch(Event& event, Shard& inline_shard) {
+    if (handle_shard_event(event, inline_shard)) {
+        return;
+    }
+    switch (event.type) {
+        case EventType::SYSTEM_SHUTDOWN:
+            m_is_running = false;
+            break;
 
-                ::Order ibkr_order = convert_to_ibkr_order(order);
-                ::Contract ibkr_contract = convert_to_ibkr_contract(order);
+        case EventType::SUBSCRIBE_REQUEST: {
+            if (const auto* request = std::get_if<SubscriptionRequest>(&event.data)) {
+                if (m_gateway_client) {
+                    m_gateway_client->subscribe_to_market_data(request->topic, request->subscriber);
+                } else {
+                    spdlog::warn("Received SUBSCRIBE_REQUEST but gateway client is not set.");
+                }
+            }
+            break;
+        }
 
+        case EventType::UNSUBSCRIBE_REQUEST: {
+            if (const auto* request = std::get_if<SubscriptionRequest>(&event.data)) {
                 if (m_gateway_client) {
-                    m_gateway_client->place_order(order.order_id, ibkr_contract, ibkr_order);
-                    spdlog::info("Order {} sent to the gateway.", order.order_id);
+                    m_gateway_client->unsubscribe_from_market_data(request->topic, request->subscriber);
                 } else {
-                    spdlog::warn("Gateway client is not available. Order not sent.");
+                    spdlog::warn("Received UNSUBSCRIBE_REQUEST but gateway client is not set.");
                 }
-                break;
             }
+            break;
+        }
 
-            case EventType::EXECUTION_REPORT: {
-                const auto& report = std::get<ExecutionReport>(event.data);
-                m_order_manager.update_order_status(report);
-                break;
+        case EventType::SEND_NEW_ORDER:
+            handle_send_new_order_event(std::get<Order>(event.data));
+            break;
+
+        case EventType::NEXT_VALID_ID: {
+            // Only moves the id counter the shards share, so this is safe
+            // while shard 0's worker uses the same OrderManager.
+            if (const auto* order_id_ptr = std::get_if<long long>(&event.data)) {
+                m_order_manager.set_next_order_id(*order_id_ptr);
             }
-            
-            case EventType::NEXT_VALID_ID: {
-                if (const auto* order_id_ptr = std::get_if<long long>(&event.data)) {
-                    m_order_manager.set_next_order_id(*order_id_ptr);
+            break;
+        }
+
+        case EventType::HISTORICAL_DATA_REQUEST: {
+            if (m_gateway_client) {
+                const auto& req = std::get<HistoricalDataRequest>(event.data);
+                spdlog::info("EngineCore forwarding history request for {}", req.symbol);
+                m_gateway_client->request_historical_data(req.symbol, req.end_date, req.duration, req.bar_size);
+            } else {
+                spdlog::warn("Gateway client not available for history request");
+            }
+            break;
+        }
+
+        case EventType::CONTRACT_RESOLVED: {
+            if (m_gateway_client) {
+                auto failed = m_gateway_client->on_contract_resolved(std::get<ContractResolution>(event.data));
+                for (const auto& failure : failed) {
+                    nlohmann::json alert;
+                    alert["type"] = "SUBSCRIPTION_FAILED";
+                    alert["topic"] = failure.topic;
+                    alert["subscribers"] = failure.subscribers;
+                    alert["reason"] = "contract could not be resolved";
+                    spdlog::warn("Subscription to {} failed: contract could not be resolved.", failure.topic);
+                    m_scripting_interface.publish_alert(alert.dump());
                 }
-                break;
             }
+            break;
+        }
 
-            case EventType::HISTORICAL_DATA_REQUEST: {
-                if (m_gateway_client) {
-                    const auto& req = std::get<HistoricalDataRequest>(event.data);
-                    spdlog::info("EngineCore forwarding history request for {}", req.symbol);
-                    m_gateway_client->request_historical_data(req.symbol, req.end_date, req.duration, req.bar_size);
-                } else {
-                    spdlog::warn("Gateway client not available for history request");
+        case EventType::TIMER_REQUEST:
+            handle_timer_request(std::get<TimerRequest>(event.data));
+            break;
+
+        case EventType::CONNECTION_STATE: {
+            const auto& status = std::get<ConnectionStatus>(event.data);
+            spdlog::info("Gateway connection {} (attempt {}, down {} ms) {}",
+                         connection_state_to_string(status.state), status.attempt, status.downtime_ms, status.detail);
+            m_scripting_interface.publish_connection_state(status);
+            if (m_gateway_client) {
+                m_gateway_client->on_connection_state(status);
+            }
+            break;
+        }
+
+        default:
+            spdlog::warn("Received unhandled event type.");
+            break;
+    }
+}
+
+bool EngineCore::handle_shard_event(Event& event, Shard& shard) {
+    OrderManager& order_manager = *shard.order_manager;
+    switch (event.type) {
+        case EventType::TICK:
+            handle_tick_event(std::get<Tick>(event.data), event.trace, shard);
+            return true;
+
+        case EventType::ORDER_REQUEST: {
+            event.trace.stamp(LatencyStage::HANDLE);
+            Order order = std::get<Order>(event.data);
+            place_order(order, event.trace, shard);
+            return true;
+        }
+
+        case EventType::CANCEL_ORDER_REQUEST: {
+            const auto& request = std::get<CancelRequest>(event.data);
+            if (order_manager.request_cancel(request.order_id, request.strategy_id)) {
+                publish_order_update(request.order_id, ExecutionReport{}, shard);
+                send_cancel(request.order_id, shard);
+            }
+            if (shard.journal) {
+                shard.journal->maybe_snapshot(order_manager);
+            }
+            return true;
+        }
+
+        case EventType::CANCEL_ALL_REQUEST: {
+            const auto& request = std::get<CancelRequest>(event.data);
+            for (uint64_t order_id : order_manager.request_mass_cancel(request.symbol, request.strategy_id)) {
+                publish_order_update(order_id, ExecutionReport{}, shard);
+                send_cancel(order_id, shard);
+            }
+            if (shard.journal) {
+                shard.journal->maybe_snapshot(order_manager);
+            }
+            return true;
+        }
+
+        case EventType::MODIFY_ORDER_REQUEST: {
+            const auto& request = std::get<ModifyRequest>(event.data);
+            // Checked as if the order were placed with the new terms, before
+            // anything changes, so a modify cannot get around the limits.
+            // A field left out keeps the value of a modify still in flight.
+            Order modified = order_manager.get_order(request.order_id);
+            modified.quantity = request.quantity.value_or(modified.pending_quantity.value_or(modified.quantity));
+            modified.price = request.price.value_or(modified.pending_price.value_or(modified.price));
+            std::string reject_reason;
+            if (!modified.symbol.empty() && !check_risk(modified, shard, reject_reason)) {
+                m_risk_rejects->add();
+                spdlog::warn("Rejected modify of order {}: {}", request.order_id, reject_reason);
+                return true;
+            }
+            if (!order_manager.request_modify(request.order_id, request.quantity, request.price,
+                                              request.strategy_id)) {
+                return true;
+            }
+            publish_order_update(request.order_id, ExecutionReport{}, shard);
+            // The order keeps its old terms until IB accepts; the broker gets the new ones.
+            const Order& order = modified;
+            if (shard.journal) {
+                shard.journal->append_modify(request.order_id, request.quantity, request.price,
+                                             [this, order](bool durable) {
+                                                 if (!durable) {
+                                                     reject_unjournaled(order.order_id, ReportType::MODIFY_REJECTED);
+                                                     return;
+                                                 }
+                                                 send_modify(order);
+                                             });
+                shard.journal->maybe_snapshot(order_manager);
+            } else {
+                send_modify(order);
+            }
+            return true;
+        }
+
+        case EventType::EXECUTION_REPORT: {
+            const auto& report = std::get<ExecutionReport>(event.data);
+            if (order_manager.update_order_status(report)) {
+                if (shard.journal) {
+                    shard.journal->append_report(report);
+                    shard.journal->maybe_snapshot(order_manager);
                 }
-                break;
+                publish_order_update(report.order_id, report, shard);
+                const Order order = order_manager.get_order(report.order_id);
+                if (is_terminal(order.status)) {
+                    forget_order_shard(order.order_id);
+                }
+                if (!order.symbol.empty()) {
+                    SymbolId symbol_id = order.symbol_id != kInvalidSymbolId
+                                             ? order.symbol_id
+                                             : SymbolTable::instance().intern(order.symbol);
+                    const bool filled = report.fill_quantity.raw() != 0;
+                    update_exposure(shard, symbol_id, order.symbol, filled ? &report.fill_price : nullptr, true);
+                }
+                publish_shard_state(shard);
             }
+            return true;
+        }
 
-            case EventType::HISTORICAL_DATA: {
-                const auto& bar = std::get<Bar>(event.data);
-                spdlog::info("History: {} [{}] C:{}", bar.symbol, bar.time, bar.close);
-                m_scripting_interface.publish_historical_data(bar);
-                break;
+        case EventType::RECONCILIATION: {
+            const auto& snapshot = std::get<BrokerSnapshot>(event.data);
+            std::vector<uint64_t> closed;
+            size_t corrections = order_manager.reconcile(snapshot, &closed);
+            for (uint64_t order_id : closed) {
+                forget_order_shard(order_id);
+            }
+            if (shard.journal) {
+                // Corrections are not individual records; capture them in a snapshot.
+                shard.journal->snapshot(order_manager);
+            }
+            for (const auto& [symbol, position] : snapshot.positions) {
+                update_exposure(shard, SymbolTable::instance().intern(symbol), symbol, nullptr, true);
+            }
+            publish_shard_state(shard);
+            m_reconcile_corrections.fetch_add(corrections);
+            // One RESYNCED for the whole engine, sent by the last shard to finish.
+            if (m_shards.size() == 1 || m_reconcile_pending.fetch_sub(1) == 1) {
+                ConnectionStatus status;
+                status.state = ConnectionState::RESYNCED;
+                status.detail = std::to_string(m_reconcile_corrections.exchange(0)) + " correction(s)";
+                m_scripting_interface.publish_connection_state(status);
             }
+            return true;
+        }
 
-            default:
-                spdlog::warn("Received unhandled event type.");
-                break;
+        case EventType::HISTORICAL_DATA: {
+            const auto& bar = std::get<Bar>(event.data);
+            if (bar.end_of_history) {
+                spdlog::info("History for {} complete.", bar.symbol);
+                m_scripting_interface.publish_history_end(bar.symbol);
+                return true;
+            }
+            spdlog::info("History: {} [{}] C:{}", bar.symbol, bar.time, bar.close.to_double());
+            m_scripting_interface.publish_historical_data(bar);
+            if (!m_strategies.empty()) {
+                m_strategies.on_bar(bar);
+            }
+            return true;
+        }
+
+        default:
+            return false;
+    }
+}
+
+// Limits come from the live config, so a reload applies from the next order.
+bool EngineCore::check_risk(const Order& order, Shard& shard, std::string& reason) const {
+    const EngineConfig& config = ConfigHandler::current();
+    if (order.quantity > Quantity::from_int(config.max_order_size)) {
+        reason = "quantity " + order.quantity.to_string() + " exceeds max_order_size " +
+                 std::to_string(config.max_order_size);
+        return false;
+    }
+    // Market orders are valued at the last mark, known only for held symbols.
+    Price price = order.price;
+    if (order.order_type != OrderType::LIMIT) {
+        auto it = shard.exposures.find(order.symbol_id);
+        price = it != shard.exposures.end() ? it->second.last_price : Price{};
+    }
+    if (price.raw() == 0) {
+        return true;
+    }
+    Quantity position = shard.order_manager->get_position(order.symbol);
+    // Fills are already in the position; only the rest of the order can add to it.
+    Quantity remaining = order.quantity - order.filled_quantity;
+    Quantity projected = order.side == Side::BUY ? position + remaining : position - remaining;
+    double value = std::abs(projected.to_double()) * price.to_double();
+    // An order that shrinks the position is always allowed, so a lowered limit never traps one.
+    if (value > config.max_position_value && std::abs(projected.to_double()) > std::abs(position.to_double())) {
+        reason = "position value " + std::to_string(value) + " would exceed max_position_value_usd " +
+                 std::to_string(config.max_position_value);
+        return false;
+    }
+    return true;
+}
+
+void EngineCore::place_order(Order& order, LatencyTrace& trace, Shard& shard) {
+    OrderManager& order_manager = *shard.order_manager;
+    spdlog::info("EngineCore processing order request for {} {} {}",
+                 side_to_string(order.side), order.quantity.to_string(), order.symbol);
+
+    if (order.symbol_id == kInvalidSymbolId) {
+        order.symbol_id = SymbolTable::instance().intern(order.symbol);
+    }
+    std::string reject_reason;
+    bool accepted = check_risk(order, shard, reject_reason);
+    if (accepted && shard.journal && shard.journal->failed()) {
+        // It could not be recovered after a crash, so it must not reach the broker.
+        accepted = false;
+        reject_reason = "order journal has failed";
+    }
+    if (!accepted) {
+        // Still gets an id, so the strategy sees the rejection on its EXECUTION topic.
+        order.status = OrderStatus::REJECTED;
+        m_risk_rejects->add();
+    }
+    order_manager.add_new_order(order);
+    if (accepted && m_shards.size() > 1) {
+        std::lock_guard<std::mutex> lock(m_order_shards_mutex);
+        m_order_shards[order.order_id] = shard.index;
+    }
+    if (!accepted) {
+        spdlog::warn("Rejected order {} for {}: {}", order.order_id, order.symbol, reject_reason);
+        publish_order_update(order.order_id, ExecutionReport{}, shard);
+        return;
+    }
+
+    if (shard.journal) {
+        // Sent from the journal's writer thread once the record is on disk.
+        shard.journal->append_order(order, [this, order, trace](bool durable) mutable {
+            if (!durable) {
+                reject_unjournaled(order.order_id, ReportType::STATUS, OrderStatus::REJECTED);
+                return;
+            }
+            send_new_order(order, trace);
+        });
+        shard.journal->maybe_snapshot(order_manager);
+    } else {
+        send_new_order(order, trace);
+    }
+    // Tells the strategy its order id (matched on correlation_id).
+    publish_order_update(order.order_id, ExecutionReport{}, shard);
+    publish_shard_state(shard);
+}
+
+uint64_t EngineCore::submit_strategy_order(Order& order) {
+    order.symbol_id = SymbolTable::instance().intern(order.symbol);
+    LatencyTrace trace;
+    trace.stamp(LatencyStage::INGEST);
+    Shard* shard = s_current_shard;
+    if (shard && (m_shards.size() == 1 || shard_for_symbol(order.symbol_id) == shard->index)) {
+        trace.stamp(LatencyStage::HANDLE);
+        place_order(order, trace, *shard);
+        return order.order_id;
+    }
+    Event event;
+    event.type = EventType::ORDER_REQUEST;
+    event.data = order;
+    event.trace = trace;
+    post_event(std::move(event));
+    return 0;
+}
+
+bool EngineCore::cancel_strategy_order(uint64_t order_id, const std::string& strategy_id) {
+    Shard* shard = s_current_shard;
+    if (shard && (m_shards.size() == 1 || shard_for_order(order_id, "") == shard->index)) {
+        if (!shard->order_manager->request_cancel(order_id, strategy_id)) {
+            return false;
+        }
+        publish_order_update(order_id, ExecutionReport{}, *shard);
+        send_cancel(order_id, *shard);
+        return true;
+    }
+    CancelRequest request;
+    request.order_id = order_id;
+    request.strategy_id = strategy_id;
+    Event event;
+    event.type = EventType::CANCEL_ORDER_REQUEST;
+    event.data = request;
+    post_event(std::move(event));
+    return true;
+}
+
+void EngineCore::handle_send_new_order_event(Order& order) {
+    if (!m_gateway_client) {
+        spdlog::warn("Gateway client is not available. Order {} not sent.", order.order_id);
+        return;
+    }
+    m_gateway_client->place_order(order.order_id, convert_to_ibkr_contract(order), convert_to_ibkr_order(order));
+    spdlog::info("Order {} sent to the gateway.", order.order_id);
+}
+
+void EngineCore::publish_order_update(uint64_t order_id, const ExecutionReport& report, Shard& shard) {
+    Order order = shard.order_manager->get_order(order_id);
+    m_scripting_interface.publish_execution_report(
+        order, report, shard.order_manager->get_strategy_position(order.strategy_id, order.symbol));
+    if (!m_strategies.empty()) {
+        m_strategies.on_order_update(order, report);
+    }
+}
+
+// price is a new mark for the symbol (tick or fill); position_changed rereads
+// the shard's position. Keeps the shard's gross exposure current without
+// walking every symbol.
+void EngineCore::update_exposure(Shard& shard, SymbolId symbol_id, const std::string& symbol, const Price* price,
+                                 bool position_changed) {
+    auto it = shard.exposures.find(symbol_id);
+    if (position_changed) {
+        Quantity position = shard.order_manager->get_position(symbol);
+        if (it == shard.exposures.end()) {
+            if (position.raw() == 0) {
+                return;
+            }
+            it = shard.exposures.emplace(symbol_id, SymbolExposure{}).first;
+        }
+        it->second.position = position;
+    } else if (it == shard.exposures.end()) {
+        return;
+    }
+    SymbolExposure& entry = it->second;
+    if (price) {
+        entry.last_price = *price;
+    }
+    double exposure = std::abs(entry.position.to_double()) * entry.last_price.to_double();
+    shard.gross_exposure += exposure - entry.exposure;
+    entry.exposure = exposure;
+    shard.published_exposure.store(shard.gross_exposure, std::memory_order_relaxed);
+}
+
+void EngineCore::publish_shard_state(Shard& shard) {
+    shard.published_open_orders.store(shard.order_manager->open_order_count(), std::memory_order_relaxed);
+    shard.published_exposure.store(shard.gross_exposure, std::memory_order_relaxed);
+}
+
+// May run on the journal writer thread: only touches thread-safe senders.
+void EngineCore::send_new_order(const Order& order, LatencyTrace& trace) {
+    ::Order ibkr_order = convert_to_ibkr_order(order);
+    ::Contract ibkr_contract = convert_to_ibkr_contract(order);
+    trace.stamp(LatencyStage::SERIALIZE);
+
+    if (m_gateway_client) {
+        m_gateway_client->place_order(order.order_id, ibkr_contract, ibkr_order);
+        trace.stamp(LatencyStage::SEND);
+        StatsRegistry::instance().record_trace(LatencyPath::ORDER, trace);
+        spdlog::info("Order {} sent to the gateway.", order.order_id);
+    } else if (m_execution_handler) {
+        Order copy = order;
+        m_execution_handler->place_order(copy);
+        trace.stamp(LatencyStage::SEND);
+        StatsRegistry::instance().record_trace(LatencyPath::ORDER, trace);
+    } else {
+        spdlog::warn("Gateway client is not available. Order not sent.");
+    }
+}
+
+void EngineCore::send_modify(const Order& order) {
+    if (!m_gateway_client) {
+        spdlog::warn("Gateway client is not available. Modify of order {} not sent.", order.order_id);
+        return;
+    }
+    m_gateway_client->modify_order(order.order_id, convert_to_ibkr_contract(order), convert_to_ibkr_order(order));
+}
+
+void EngineCore::send_cancel(uint64_t order_id, Shard& shard) {
+    auto send = [this, order_id](bool sent) {
+        if (!sent) {
+            // The order never went out either; nothing to cancel at the broker.
+            reject_unjournaled(order_id, ReportType::STATUS, OrderStatus::CANCELED);
+            return;
+        }
+        if (!m_gateway_client) {
+            spdlog::warn("Gateway client is not available. Cancel of order {} not sent.", order_id);
+            return;
         }
+        m_gateway_client->cancel_order(static_cast<OrderId>(order_id));
+    };
+    if (shard.journal) {
+        // Not gated on the fsync (a cancel lost in a crash is re-derived on
+        // reconcile), but held back if the order itself is still waiting on one.
+        shard.journal->append_cancel(order_id, send);
+        return;
     }
+    send(true);
 }
 
-void EngineCore::handle_tick_event(const Tick& tick) {
-    m_scripting_interface.publish_tick(tick);
+// Journal writer thread: a request whose record never reached disk was not
+// sent, so answer it locally. An order closes as REJECTED, or CANCELED if a
+// cancel was held behind it (PENDING_CANCEL cannot become REJECTED); a modify
+// drops its pending terms.
+void EngineCore::reject_unjournaled(uint64_t order_id, ReportType type, OrderStatus status) {
+    spdlog::error("Request for order {} not sent: the order journal has failed.", order_id);
+    ExecutionReport report;
+    report.order_id = order_id;
+    report.type = type;
+    report.new_status = status;
+    Event event;
+    event.type = EventType::EXECUTION_REPORT;
+    event.data = report;
+    post_event(std::move(event));
+}
+
+void EngineCore::handle_tick_event(const Tick& tick, LatencyTrace& trace, Shard& shard) {
+    trace.stamp(LatencyStage::HANDLE);
+    // In-process strategies first: their orders should not wait on the publish.
+    if (!m_strategies.empty()) {
+        m_strategies.on_tick(tick);
+    }
+    m_scripting_interface.publish_tick(tick, &trace);
+    StatsRegistry::instance().record_trace(LatencyPath::TICK, trace);
+    // Only symbols with a position are marked, so most ticks skip the lookup.
+    if (!shard.exposures.empty()) {
+        SymbolId symbol_id = tick.symbol_id != kInvalidSymbolId ? tick.symbol_id
+                                                                : SymbolTable::instance().intern(tick.symbol);
+        update_exposure(shard, symbol_id, tick.symbol, &tick.price, false);
+    }
 }
 
 } // namespace TradingEngine
@@ -0,0 +1,31 @@
+#include "FixedPoint.hpp"
+
+namespace TradingEngine {
+
+TickSizeTable& TickSizeTable::instance() {
+    static TickSizeTable table;
+    return table;
+}
+
+Price TickSizeTable::tick_size(const std::string& symbol) const {
+    auto it = m_ticks.find(symbol);
+    if (it != m_ticks.end()) {
+        return it->second;
+    }
+    return m_default_tick;
+}
+
+bool TickSizeTable::is_on_tick(const std::string& symbol, Price price) const {
+    Price tick = tick_size(symbol);
+    return tick.is_zero() || price.raw() % tick.raw() == 0;
+}
+
+Price TickSizeTable::round_to_tick(const std::string& symbol, Price price) const {
+    Price tick = tick_size(symbol);
+    if (tick.is_zero()) {
+        return price;
+    }
+    return Price::from_raw(static_cast<int64_t>(divide_rounded(price.raw(), tick.raw())) * tick.raw());
+}
+
+}
@@ -0,0 +1,302 @@
+#include "FlightRecorder.hpp"
+#include "SymbolTable.hpp"
+#include "LogHandler.hpp"
+#include <cerrno>
+#include <csignal>
+#include <ctime>
+#include <fcntl.h>
+#include <filesystem>
+#include <pthread.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace TradingEngine {
+
+struct FlightRecorder::Registry {
+    std::array<std::atomic<Ring*>, kMaxThreads> rings{};
+    std::atomic<size_t> ring_count{0};
+    size_t capacity = 4096;
+    char directory[256] = {};
+    uint64_t start_ticks = 0;
+    uint64_t start_ns = 0;  // monotonic, paired with start_ticks
+    std::atomic<bool> dumping{false};
+    std::atomic<bool> overflow_logged{false};
+};
+
+namespace {
+
+constexpr size_t kAltStackSize = 64 * 1024;
+constexpr int kCrashSignals[] = {SIGSEGV, SIGBUS, SIGFPE, SIGILL, SIGABRT};
+
+uint64_t clock_ns(clockid_t clock) {
+    timespec ts;
+    clock_gettime(clock, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ull + static_cast<uint64_t>(ts.tv_nsec);
+}
+
+// write(2) until done; the only output call used, so the dump is signal-safe.
+bool write_all(int fd, const void* data, size_t size) {
+    const char* p = static_cast<const char*>(data);
+    while (size > 0) {
+        ssize_t n = ::write(fd, p, size);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        p += n;
+        size -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+// Bounded string building without the heap.
+void append(char* buffer, size_t size, size_t& length, const char* text) {
+    while (*text && length + 1 < size) {
+        buffer[length++] = *text++;
+    }
+    buffer[length] = '\0';
+}
+
+void append_number(char* buffer, size_t size, size_t& length, uint64_t value) {
+    char digits[24];
+    size_t count = 0;
+    do {
+        digits[count++] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    } while (value > 0);
+    char text[24];
+    for (size_t i = 0; i < count; ++i) {
+        text[i] = digits[count - 1 - i];
+    }
+    text[count] = '\0';
+    append(buffer, size, length, text);
+}
+
+void crash_handler(int signal) {
+    FlightRecorder::dump_from_signal(signal);
+    // SA_RESETHAND restored the default action.
+    std::raise(signal);
+}
+
+}
+
+FlightRecorder::Registry& FlightRecorder::registry() {
+    static Registry registry;
+    return registry;
+}
+
+bool FlightRecorder::enable(const std::string& directory, size_t records_per_thread) {
+    Registry& reg = registry();
+    if (enabled()) {
+        spdlog::warn("Flight recorder is already enabled.");
+        return true;
+    }
+    if (directory.empty() || directory.size() >= sizeof(reg.directory) || records_per_thread == 0) {
+        spdlog::error("Flight recorder needs a directory (under {} chars) and a positive record count.",
+                      sizeof(reg.directory));
+        return false;
+    }
+    std::error_code ec;
+    std::filesystem::create_directories(directory, ec);
+    if (ec) {
+        spdlog::error("Cannot create flight recorder directory {}: {}", directory, ec.message());
+        return false;
+    }
+    size_t capacity = 1;
+    while (capacity < records_per_thread) capacity <<= 1;
+    reg.capacity = capacity;
+    std::memcpy(reg.directory, directory.c_str(), directory.size() + 1);
+    reg.start_ticks = ticks();
+    reg.start_ns = clock_ns(CLOCK_MONOTONIC);
+    s_enabled = true;
+    spdlog::info("Flight recorder on: {} records per thread, dumps to {}.", capacity, directory);
+    return true;
+}
+
+FlightRecorder::Ring* FlightRecorder::attach() {
+    // Hands the ring back when the thread exits, and stops the thread from
+    // recording (or attaching again) from later thread_local destructors.
+    struct Owner {
+        Ring* ring = nullptr;
+        char* alt_stack = nullptr;  // installed by attach(); freed with the thread
+        bool exited = false;
+        ~Owner() {
+            exited = true;
+            t_ring = nullptr;
+            if (ring) {
+                ring->in_use.store(false, std::memory_order_release);
+            }
+            if (alt_stack) {
+                // Only ours to remove if it is still the installed one; and
+                // sigaltstack refuses while a handler runs on it, so then keep it.
+                stack_t current{};
+                stack_t off{};
+                off.ss_flags = SS_DISABLE;
+                if (sigaltstack(nullptr, &current) == 0 && current.ss_sp == alt_stack &&
+                    sigaltstack(&off, nullptr) == 0) {
+                    delete[] alt_stack;
+                }
+                alt_stack = nullptr;
+            }
+        }
+    };
+    static thread_local Owner owner;
+    if (owner.exited) {
+        return nullptr;
+    }
+    Registry& reg = registry();
+    Ring* ring = nullptr;
+    size_t count = std::min(reg.ring_count.load(std::memory_order_acquire), kMaxThreads);
+    for (size_t i = 0; i < count && !ring; ++i) {
+        Ring* candidate = reg.rings[i].load(std::memory_order_acquire);
+        bool idle = false;
+        if (candidate && candidate->in_use.compare_exchange_strong(idle, true, std::memory_order_acq_rel)) {
+            // The previous thread's records are not this one's.
+            candidate->start.store(candidate->head.load(std::memory_order_relaxed), std::memory_order_release);
+            ring = candidate;
+        }
+    }
+    if (!ring) {
+        size_t index = reg.ring_count.fetch_add(1, std::memory_order_acq_rel);
+        if (index >= kMaxThreads) {
+            if (!reg.overflow_logged.exchange(true)) {
+                spdlog::warn("Flight recorder: more than {} threads; the rest are not recorded.", kMaxThreads);
+            }
+            owner.exited = true;
+            return nullptr;
+        }
+        ring = new Ring();
+        ring->records = new FlightRecord[reg.capacity]();
+        ring->mask = reg.capacity - 1;
+        ring->in_use.store(true, std::memory_order_relaxed);
+        reg.rings[index].store(ring, std::memory_order_release);
+    }
+    pthread_getname_np(pthread_self(), ring->thread_name, sizeof(ring->thread_name));
+    ring->thread_id = static_cast<uint32_t>(::syscall(SYS_gettid));
+    // A crash from a stack overflow needs somewhere else to run the handler.
+    stack_t current{};
+    if (!owner.alt_stack && sigaltstack(nullptr, &current) == 0 && (current.ss_flags & SS_DISABLE)) {
+        stack_t alt{};
+        owner.alt_stack = new char[kAltStackSize];
+        alt.ss_sp = owner.alt_stack;
+        alt.ss_size = kAltStackSize;
+        if (sigaltstack(&alt, nullptr) != 0) {
+            delete[] owner.alt_stack;
+            owner.alt_stack = nullptr;
+        }
+    }
+    owner.ring = ring;
+    t_ring = ring;
+    return ring;
+}
+
+void FlightRecorder::install_crash_handlers() {
+    struct sigaction action{};
+    action.sa_handler = crash_handler;
+    sigemptyset(&action.sa_mask);
+    action.sa_flags = SA_ONSTACK | SA_RESETHAND;
+    for (int signal : kCrashSignals) {
+        sigaction(signal, &action, nullptr);
+    }
+}
+
+bool FlightRecorder::dump_from_signal(int signal) {
+    char path[512];
+    return write_dump(signal, path, sizeof(path));
+}
+
+std::string FlightRecorder::dump() {
+    char path[512];
+    if (!write_dump(0, path, sizeof(path))) {
+        spdlog::error("Flight recorder dump failed.");
+        return "";
+    }
+    spdlog::info("Flight recorder dumped to {}", path);
+    return path;
+}
+
+bool FlightRecorder::write_dump(int signal, char* path, size_t path_size) {
+    if (!enabled()) {
+        return false;
+    }
+    Registry& reg = registry();
+    // One dump at a time; a crash during a dump keeps the one in progress.
+    if (reg.dumping.exchange(true, std::memory_order_acquire)) {
+        return false;
+    }
+    const uint64_t wall_ns = clock_ns(CLOCK_REALTIME);
+    size_t length = 0;
+    path[0] = '\0';
+    append(path, path_size, length, reg.directory);
+    append(path, path_size, length, "/flight-");
+    append_number(path, path_size, length, wall_ns / 1000000ull);
+    append(path, path_size, length, "-");
+    append_number(path, path_size, length, static_cast<uint64_t>(signal));
+    append(path, path_size, length, ".rec");
+    int fd = ::open(path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        reg.dumping.store(false, std::memory_order_release);
+        return false;
+    }
+
+    Ring* rings[kMaxThreads];
+    uint32_t ring_count = 0;
+    size_t registered = std::min(reg.ring_count.load(std::memory_order_acquire), kMaxThreads);
+    for (size_t i = 0; i < registered; ++i) {
+        if (Ring* ring = reg.rings[i].load(std::memory_order_acquire)) {
+            rings[ring_count++] = ring;
+        }
+    }
+    const SymbolTable& symbols = SymbolTable::instance();
+
+    FlightDumpHeader header{};
+    std::memcpy(header.magic, kFlightDumpMagic, sizeof(header.magic));
+    header.version = kFlightDumpVersion;
+    header.signal = signal;
+    header.wall_ns = wall_ns;
+    header.ticks = ticks();
+    const uint64_t elapsed_ticks = header.ticks - reg.start_ticks;
+    const uint64_t elapsed_ns = clock_ns(CLOCK_MONOTONIC) - reg.start_ns;
+    header.ns_per_tick = elapsed_ticks > 0 && elapsed_ns > 0
+                             ? static_cast<double>(elapsed_ns) / static_cast<double>(elapsed_ticks)
+                             : 1.0;
+    header.symbol_count = static_cast<uint32_t>(symbols.size());
+    header.ring_count = ring_count;
+    bool ok = write_all(fd, &header, sizeof(header));
+    for (uint32_t id = 1; ok && id <= header.symbol_count; ++id) {
+        const std::string& name = symbols.name(id);
+        uint16_t len = static_cast<uint16_t>(std::min<size_t>(name.size(), UINT16_MAX));
+        ok = write_all(fd, &len, sizeof(len)) && write_all(fd, name.data(), len);
+    }
+    for (uint32_t i = 0; ok && i < ring_count; ++i) {
+        const Ring& ring = *rings[i];
+        const uint64_t capacity = ring.mask + 1;
+        const uint64_t head = ring.head.load(std::memory_order_acquire);
+        const uint64_t start = ring.start.load(std::memory_order_acquire);
+        const uint64_t first = std::max(start, head > capacity ? head - capacity : 0);
+        FlightRingHeader ring_header{};
+        std::memcpy(ring_header.thread_name, ring.thread_name, sizeof(ring_header.thread_name));
+        ring_header.thread_id = ring.thread_id;
+        ring_header.capacity = static_cast<uint32_t>(capacity);
+        ring_header.first_sequence = first;
+        ring_header.record_count = head - first;
+        ok = write_all(fd, &ring_header, sizeof(ring_header));
+        // At most two contiguous runs: up to the end of the array, then from its start.
+        for (uint64_t sequence = first; ok && sequence < head;) {
+            uint64_t index = sequence & ring.mask;
+            uint64_t run = std::min(head - sequence, capacity - index);
+            ok = write_all(fd, &ring.records[index], run * sizeof(FlightRecord));
+            sequence += run;
+        }
+        const uint64_t head_after = ring.head.load(std::memory_order_acquire);
+        ok = ok && write_all(fd, &head_after, sizeof(head_after));
+    }
+    ::fsync(fd);
+    ::close(fd);
+    reg.dumping.store(false, std::memory_order_release);
+    return ok;
+}
+
+}
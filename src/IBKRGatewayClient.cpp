@@ -1,8 +1,13 @@
 #include "IBKRGatewayClient.hpp"
 #include "LogHandler.hpp"
+#include "BinaryLog.hpp"
+#include "FlightRecorder.hpp"
 #include "EngineCore.hpp"
 #include "Event.hpp"
+#include "IBKRConverters.hpp"
+#include "OrderLifecycle.hpp"
 #include "Order.h"
+#include "OrderCancel.h"
 #include "Contract.h"
 #include "Decimal.h"
 #include "Execution.h"
@@ -15,7 +20,18 @@ IBKRGatewayClient::IBKRGatewayClient(EngineCore* engine_core, const std::string&
       m_client(std::make_unique<EClientSocket>(this, &m_signal)),
       m_signal(1000),
       m_next_ticker_id(2000),
-      m_is_connected(false) {}
+      m_is_connected(false),
+      m_lines_in_use(StatsRegistry::instance().gauge("market_data.lines_in_use")),
+      m_line_limit(StatsRegistry::instance().gauge("market_data.line_limit")),
+      m_outbound(std::make_unique<OutboundScheduler>()),
+      m_connected_gauge(StatsRegistry::instance().gauge("gateway.connected")),
+      m_reconnects(StatsRegistry::instance().counter("gateway.reconnects")) {
+    m_ticker_symbols = std::make_unique<std::atomic<SymbolId>[]>(kTickerSlots);
+    for (size_t i = 0; i < kTickerSlots; ++i) {
+        m_ticker_symbols[i].store(kInvalidSymbolId, std::memory_order_relaxed);
+    }
+    update_line_gauges();
+}
 
 IBKRGatewayClient::~IBKRGatewayClient() {
     disconnect();
@@ -26,40 +42,371 @@ void IBKRGatewayClient::set_engine_core(EngineCore* engine_core) {
 }
 
 void IBKRGatewayClient::connect() {
+    if (!m_supervisor) {
+        ReconnectSupervisor::Callbacks callbacks;
+        callbacks.teardown = [this] { close_session(); };
+        callbacks.reconnect = [this](int) { return open_session(); };
+        callbacks.on_state = [this](const ConnectionStatus& status) { post_connection_state(status); };
+        m_supervisor = std::make_unique<ReconnectSupervisor>(m_reconnect_config, std::move(callbacks));
+    }
+    m_supervisor->start();
+    ConnectionStatus status;
+    status.state = ConnectionState::CONNECTING;
+    post_connection_state(status);
+    if (!open_session()) {
+        // Keep retrying in the background rather than giving up at startup.
+        m_supervisor->notify_connection_lost("initial connection failed");
+        return;
+    }
+    status.state = ConnectionState::CONNECTED;
+    post_connection_state(status);
+    spdlog::info("IBKR connection established and acknowledged.");
+}
+
+void IBKRGatewayClient::set_reconnect_config(const ReconnectSupervisor::Config& config,
+                                             std::chrono::milliseconds connect_timeout) {
+    m_reconnect_config = config;
+    m_connect_timeout = connect_timeout;
+}
+
+bool IBKRGatewayClient::open_session() {
     spdlog::info("Connecting to IBKR TWS/Gateway at {}:{}...", m_host, m_port);
-    m_is_connected = m_client->eConnect(m_host.c_str(), m_port, m_client_id);
-    if (!m_is_connected) {
+    std::future<void> future;
+    {
+        std::lock_guard<std::mutex> lock(m_connection_mutex);
+        m_connection_promise = std::promise<void>();
+        m_connection_resolved = false;
+        future = m_connection_promise.get_future();
+    }
+    m_is_connection_acknowledged = false;
+    m_closing = false;
+    if (!m_client->eConnect(m_host.c_str(), m_port, m_client_id)) {
         spdlog::error("Failed to initiate IBKR connection.");
+        return false;
     }
+    m_is_connected = true;
+    m_outbound->start();
     m_reader = std::make_unique<EReader>(m_client.get(), &m_signal);
     m_reader_thread = std::thread(&IBKRGatewayClient::process_messages, this);
-    m_reader->start();
-    auto future = m_connection_promise.get_future();
+    if (!m_direct_reader) {
+        m_reader->start();
+    }
     spdlog::info("Waiting for connection confirmation from server...");
-    if (future.wait_for(std::chrono::seconds(10)) == std::future_status::timeout) {
+    if (future.wait_for(m_connect_timeout) == std::future_status::timeout) {
         spdlog::error("IBKR connection timeout.");
-        disconnect();
+        return false;
     }
-    if (!m_is_connection_acknowledged) {
-        disconnect();
+    return m_is_connection_acknowledged;
+}
+
+void IBKRGatewayClient::close_session() {
+    m_closing = true;
+    m_is_connected = false;
+    m_outbound->stop();
+    {
+        // stop() discarded them.
+        std::lock_guard<std::mutex> lock(m_queued_orders_mutex);
+        for (const auto& [order_id, count] : m_queued_orders) {
+            m_unsent_orders.push_back(static_cast<uint64_t>(order_id));
+        }
+        m_queued_orders.clear();
+    }
+    {
+        // Reconciliation adopts whatever quantity IB is working.
+        std::lock_guard<std::mutex> lock(m_modifies_mutex);
+        m_modifies.clear();
+    }
+    // Join our reader before closing the socket it may be reading from.
+    m_signal.issueSignal();
+    if (m_reader_thread.joinable()) {
+        m_reader_thread.join();
+    }
+    m_client->eDisconnect();
+    if (m_reader) {
+        m_client->registerEReader(nullptr);
+        m_reader.reset();
+    }
+}
+
+void IBKRGatewayClient::resolve_connection(bool acknowledged) {
+    std::lock_guard<std::mutex> lock(m_connection_mutex);
+    if (m_connection_resolved) {
+        return;
+    }
+    m_is_connection_acknowledged = acknowledged;
+    m_connection_resolved = true;
+    m_connection_promise.set_value();
+}
+
+void IBKRGatewayClient::post_connection_state(const ConnectionStatus& status) {
+    if (status.state == ConnectionState::CONNECTED) {
+        m_connected_gauge.set(1);
+        if (status.attempt > 0) {
+            m_reconnects.add();
+        }
+    } else if (status.state == ConnectionState::DISCONNECTED) {
+        m_connected_gauge.set(0);
+    }
+    Event event;
+    event.type = EventType::CONNECTION_STATE;
+    event.data = status;
+    if (m_engine_core) {
+        m_engine_core->post_event(event);
     }
-    spdlog::info("IBKR connection established and acknowledged.");
 }
 
-void IBKRGatewayClient::subscribe_to_market_data(const std::string& topic) {
-    size_t last_dot = topic.find_last_of('.');
-    if (last_dot == std::string::npos) {
+void IBKRGatewayClient::on_connection_state(const ConnectionStatus& status) {
+    if (status.state == ConnectionState::CONNECTED && status.resync) {
+        resynchronize();
+    }
+}
+
+void IBKRGatewayClient::resynchronize() {
+    // Requests in flight on the old socket are gone: re-issue contract lookups...
+    std::vector<SymbolId> unresolved;
+    {
+        std::lock_guard<std::mutex> lock(m_contract_request_mutex);
+        m_contract_requests.clear();
+        m_contract_results.clear();
+    }
+    for (const auto& [symbol_id, actions] : m_pending_contract_actions) {
+        unresolved.push_back(symbol_id);
+    }
+    for (SymbolId symbol_id : unresolved) {
+        request_contract_details(symbol_id);
+    }
+    // ...reopen every stream under a fresh ticker id...
+    auto streams = m_subscriptions.active_streams();
+    for (const auto& [symbol, data_type] : streams) {
+        long old_request = m_subscriptions.request_id(symbol, data_type);
+        if (old_request != SubscriptionManager::kNoRequest) {
+            m_ticker_symbols[static_cast<size_t>(old_request) % kTickerSlots].store(kInvalidSymbolId, std::memory_order_release);
+            m_subscriptions.bind_request(symbol, data_type, SubscriptionManager::kNoRequest);
+        }
+        open_stream(symbol, data_type);
+    }
+    spdlog::info("Resync: replayed {} market data stream(s), {} pending contract lookup(s).",
+                 streams.size(), unresolved.size());
+    // ...and ask the broker what happened to our orders meanwhile.
+    request_reconciliation();
+}
+
+void IBKRGatewayClient::request_reconciliation() {
+    int executions_request = static_cast<int>(m_next_ticker_id++);
+    {
+        std::lock_guard<std::mutex> lock(m_reconcile_mutex);
+        m_reconcile = Reconciliation{};
+        m_reconcile.active = true;
+        m_reconcile.executions_request = executions_request;
+    }
+    ExecutionFilter filter;
+    filter.m_clientId = m_client_id;
+    m_outbound->submit(OutboundPriority::NEW_ORDER, [this] {
+        {
+            std::lock_guard<std::mutex> lock(m_reconcile_mutex);
+            m_reconcile.snapshot.requested_at = std::chrono::system_clock::now();
+        }
+        m_client->reqOpenOrders();
+    });
+    m_outbound->submit(OutboundPriority::NEW_ORDER, [this, executions_request, filter] {
+        m_client->reqExecutions(executions_request, filter);
+    });
+    m_outbound->submit(OutboundPriority::NEW_ORDER, [this] { m_client->reqPositions(); });
+}
+
+void IBKRGatewayClient::finish_reconciliation_locked() {
+    if (!m_reconcile.active || !m_reconcile.orders_done || !m_reconcile.executions_done ||
+        !m_reconcile.positions_done) {
+        return;
+    }
+    m_reconcile.active = false;
+    {
+        std::lock_guard<std::mutex> lock(m_queued_orders_mutex);
+        m_reconcile.snapshot.unsent_orders.swap(m_unsent_orders);
+    }
+    Event event;
+    event.type = EventType::RECONCILIATION;
+    event.data = std::move(m_reconcile.snapshot);
+    if (m_engine_core) {
+        m_engine_core->post_event(event);
+    }
+}
+
+bool IBKRGatewayClient::split_topic(const std::string& topic, std::string& data_type, std::string& symbol) {
+    size_t dot = topic.find('.');
+    if (dot == std::string::npos || dot == 0 || dot + 1 == topic.size()) {
         spdlog::error("Invalid subscription topic format: {}", topic);
+        return false;
+    }
+    data_type = topic.substr(0, dot);
+    symbol = topic.substr(dot + 1);
+    if (data_type != "TICK") {
+        spdlog::error("Unsupported market data type '{}' in topic {}", data_type, topic);
+        return false;
+    }
+    return true;
+}
+
+void IBKRGatewayClient::subscribe_to_market_data(const std::string& topic, const std::string& subscriber) {
+    std::string data_type, symbol;
+    if (!split_topic(topic, data_type, symbol)) {
         return;
     }
-    std::string symbol = topic.substr(last_dot + 1);
-    Contract contract;
-    contract.symbol = symbol;
-    contract.secType = "STK";
-    contract.exchange = "SMART";
-    contract.currency = "USD";
-    TickerId new_id = m_next_ticker_id++;
-    request_market_data(new_id, contract);
+    auto change = m_subscriptions.subscribe(symbol, data_type, subscriber);
+    if (change != SubscriptionManager::Change::FIRST_SUBSCRIBER) {
+        if (change == SubscriptionManager::Change::NONE) {
+            spdlog::info("{} already streaming; {} subscriber(s) now share it.", topic,
+                         m_subscriptions.subscriber_count(symbol, data_type));
+        }
+        return;
+    }
+    update_line_gauges();
+    open_stream(symbol, data_type);
+}
+
+void IBKRGatewayClient::open_stream(const std::string& symbol, const std::string& data_type) {
+    with_contract(symbol, [this, symbol, data_type](const Contract& contract) {
+        // Everyone may have unsubscribed while the contract was being resolved.
+        if (m_subscriptions.subscriber_count(symbol, data_type) == 0 ||
+            m_subscriptions.request_id(symbol, data_type) != SubscriptionManager::kNoRequest) {
+            return;
+        }
+        TickerId new_id = allocate_ticker_id();
+        if (new_id < 0) {
+            spdlog::error("No free ticker slot for {}.{}; not requesting market data.", data_type, symbol);
+            return;
+        }
+        m_subscriptions.bind_request(symbol, data_type, new_id);
+        request_market_data(new_id, contract);
+    });
+}
+
+TickerId IBKRGatewayClient::allocate_ticker_id() {
+    for (size_t attempt = 0; attempt < kTickerSlots; ++attempt) {
+        TickerId id = m_next_ticker_id++;
+        if (ticker_symbol(id) == kInvalidSymbolId) {
+            return id;
+        }
+    }
+    return -1;
+}
+
+void IBKRGatewayClient::unsubscribe_from_market_data(const std::string& topic, const std::string& subscriber) {
+    std::string data_type, symbol;
+    if (!split_topic(topic, data_type, symbol)) {
+        return;
+    }
+    long request_id = m_subscriptions.request_id(symbol, data_type);
+    auto change = m_subscriptions.unsubscribe(symbol, data_type, subscriber);
+    if (change == SubscriptionManager::Change::NOT_SUBSCRIBED) {
+        spdlog::warn("UNSUBSCRIBE for {} without a matching subscription.", topic);
+        return;
+    }
+    if (change != SubscriptionManager::Change::LAST_UNSUBSCRIBED) {
+        return;
+    }
+    update_line_gauges();
+    if (request_id != SubscriptionManager::kNoRequest) {
+        spdlog::info("Cancelling market data for {} (TickerId {})", topic, request_id);
+        m_ticker_symbols[static_cast<size_t>(request_id) % kTickerSlots].store(kInvalidSymbolId, std::memory_order_release);
+        m_outbound->submit(OutboundPriority::SUBSCRIPTION, [this, request_id] { m_client->cancelMktData(request_id); });
+    }
+}
+
+void IBKRGatewayClient::set_direct_reader(bool direct) {
+    m_direct_reader = direct;
+}
+
+void IBKRGatewayClient::set_outbound_config(const OutboundScheduler::Config& config) {
+    // Only before connect(); the scheduler thread owns the socket once started.
+    m_outbound = std::make_unique<OutboundScheduler>(config);
+}
+
+void IBKRGatewayClient::set_market_data_line_limit(size_t line_limit) {
+    m_subscriptions.set_line_limit(line_limit);
+    update_line_gauges();
+}
+
+void IBKRGatewayClient::update_line_gauges() {
+    m_lines_in_use.set(static_cast<int64_t>(m_subscriptions.lines_in_use()));
+    m_line_limit.set(static_cast<int64_t>(m_subscriptions.line_limit()));
+}
+
+void IBKRGatewayClient::with_contract(const std::string& symbol, ContractAction action) {
+    SymbolId symbol_id = SymbolTable::instance().intern(symbol);
+    if (const ContractInfo* info = ContractCache::instance().lookup(symbol_id)) {
+        action(convert_to_ibkr_contract(*info));
+        return;
+    }
+    if (symbol_id == kInvalidSymbolId) {
+        action(convert_to_ibkr_contract(symbol));
+        return;
+    }
+    auto& pending = m_pending_contract_actions[symbol_id];
+    pending.push_back(std::move(action));
+    if (pending.size() > 1) {
+        return;  // already being resolved
+    }
+    request_contract_details(symbol_id);
+}
+
+void IBKRGatewayClient::request_contract_details(SymbolId symbol_id) {
+    const std::string& symbol = SymbolTable::instance().name(symbol_id);
+    int req_id = static_cast<int>(m_next_ticker_id++);
+    {
+        std::lock_guard<std::mutex> lock(m_contract_request_mutex);
+        m_contract_requests[req_id] = symbol_id;
+    }
+    spdlog::info("Resolving contract for {} (ReqId {})", symbol, req_id);
+    m_outbound->submit(OutboundPriority::SUBSCRIPTION, [this, req_id, contract = convert_to_ibkr_contract(symbol)] {
+        m_client->reqContractDetails(req_id, contract);
+    });
+}
+
+std::vector<IBKRGatewayClient::FailedSubscription> IBKRGatewayClient::on_contract_resolved(
+    const ContractResolution& resolution) {
+    std::vector<FailedSubscription> failed;
+    auto it = m_pending_contract_actions.find(resolution.symbol_id);
+    if (it == m_pending_contract_actions.end()) {
+        return failed;
+    }
+    std::vector<ContractAction> actions = std::move(it->second);
+    m_pending_contract_actions.erase(it);
+    const std::string& symbol = SymbolTable::instance().name(resolution.symbol_id);
+    const ContractInfo* info = ContractCache::instance().lookup(resolution.symbol_id);
+    if (!resolution.resolved || !info) {
+        spdlog::error("Could not resolve contract for {}; dropping {} pending request(s).", symbol, actions.size());
+        // Streams still waiting on this contract would otherwise hold their
+        // line and swallow every later SUBSCRIBE as "already streaming".
+        for (const auto& [stream_symbol, data_type] : m_subscriptions.active_streams()) {
+            if (stream_symbol != symbol ||
+                m_subscriptions.request_id(stream_symbol, data_type) != SubscriptionManager::kNoRequest) {
+                continue;
+            }
+            FailedSubscription failure;
+            failure.topic = data_type + '.' + stream_symbol;
+            failure.subscribers = m_subscriptions.drop_stream(stream_symbol, data_type);
+            failed.push_back(std::move(failure));
+        }
+        if (!failed.empty()) {
+            update_line_gauges();
+        }
+        return failed;
+    }
+    ::Contract contract = convert_to_ibkr_contract(*info);
+    for (auto& action : actions) {
+        action(contract);
+    }
+    return failed;
+}
+
+void IBKRGatewayClient::post_contract_resolution(SymbolId symbol_id, bool resolved) {
+    Event event;
+    event.type = EventType::CONTRACT_RESOLVED;
+    event.data = ContractResolution{symbol_id, resolved};
+    if (m_engine_core) {
+        m_engine_core->post_event(event);
+    }
 }
 
 void IBKRGatewayClient::nextValidId(OrderId orderId) {
@@ -73,43 +420,124 @@ void IBKRGatewayClient::nextValidId(OrderId orderId) {
     }
 
     m_next_valid_id = orderId;
-    m_is_connection_acknowledged = true;
-    m_connection_promise.set_value();
+    resolve_connection(true);
     spdlog::info("Setting market data type to Delayed (3).");
-    m_client->reqMarketDataType(3);
+    m_outbound->submit(OutboundPriority::SUBSCRIPTION, [this] { m_client->reqMarketDataType(3); });
 }
 
 void IBKRGatewayClient::disconnect() {
-    if (!m_is_connected && !m_client->isConnected())
-        return;
-    m_is_connected = false;
-    m_client->eDisconnect();
-    m_signal.issueSignal();
-    if (m_reader_thread.joinable()) {
-        m_reader_thread.join();
+    if (m_supervisor) {
+        m_supervisor->stop();
     }
+    if (!m_is_connected && !m_client->isConnected() && !m_reader_thread.joinable())
+        return;
+    close_session();
+    m_connected_gauge.set(0);
     spdlog::info("Disconnected from IBKR.");
 }
 
 void IBKRGatewayClient::request_market_data(TickerId tickerId, const Contract& contract) {
-    m_ticker_id_to_symbol[tickerId] = contract.symbol;
+    m_ticker_symbols[static_cast<size_t>(tickerId) % kTickerSlots].store(
+        SymbolTable::instance().intern(contract.symbol), std::memory_order_release);
     spdlog::info("Requesting market data for {} (TickerId {})", contract.symbol, tickerId);
-    m_client->reqMktData(tickerId, contract, "", false, false, TagValueListSPtr());
+    m_outbound->submit(OutboundPriority::SUBSCRIPTION, [this, tickerId, contract] {
+        m_client->reqMktData(tickerId, contract, "", false, false, TagValueListSPtr());
+    });
 }
 
 void IBKRGatewayClient::place_order(OrderId orderId, const Contract& contract, const ::Order& order) {
     spdlog::info("Placing order with id {}", orderId);
-    m_client->placeOrder(orderId, contract, order);
+    {
+        std::lock_guard<std::mutex> lock(m_queued_orders_mutex);
+        ++m_queued_orders[orderId];
+    }
+    bool queued = m_outbound->submit(OutboundPriority::NEW_ORDER, [this, orderId, contract, order] {
+        forget_queued_order(orderId);
+        FlightRecorder::record(FlightKind::GATEWAY_OUT, static_cast<uint8_t>(FlightGatewayMessage::PLACE_ORDER),
+                               SymbolTable::instance().find(contract.symbol), static_cast<uint64_t>(orderId),
+                               static_cast<uint64_t>(convert_from_ibkr_decimal(order.totalQuantity).raw()));
+        m_client->placeOrder(orderId, contract, order);
+    });
+    if (!queued) {
+        forget_queued_order(orderId);
+        {
+            // Reconciliation after the reconnect marks it cancelled.
+            std::lock_guard<std::mutex> lock(m_queued_orders_mutex);
+            m_unsent_orders.push_back(static_cast<uint64_t>(orderId));
+        }
+        spdlog::error("Order {} not sent: gateway is disconnected.", orderId);
+    }
+}
+
+void IBKRGatewayClient::modify_order(OrderId orderId, const Contract& contract, const ::Order& order) {
+    ModifyTerms terms;
+    terms.quantity = convert_from_ibkr_decimal(order.totalQuantity);
+    terms.has_price = order.orderType == "LMT";
+    if (terms.has_price) {
+        terms.price = Price::from_double(order.lmtPrice);
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_modifies_mutex);
+        m_modifies[orderId] = terms;
+    }
+    place_order(orderId, contract, order);
+}
+
+void IBKRGatewayClient::forget_queued_order(OrderId orderId) {
+    std::lock_guard<std::mutex> lock(m_queued_orders_mutex);
+    auto it = m_queued_orders.find(orderId);
+    if (it != m_queued_orders.end() && --it->second == 0) {
+        m_queued_orders.erase(it);
+    }
+}
+
+void IBKRGatewayClient::cancel_order(OrderId orderId) {
+    spdlog::info("Cancelling order {}", orderId);
+    OutboundPriority priority = OutboundPriority::CANCEL;
+    {
+        // The scheduler is one thread, so once the placeOrder has left this
+        // set it has been sent, and the cancel may jump the queue.
+        std::lock_guard<std::mutex> lock(m_queued_orders_mutex);
+        if (m_queued_orders.count(orderId)) {
+            priority = OutboundPriority::NEW_ORDER;
+        }
+    }
+    bool queued = m_outbound->submit(priority, [this, orderId] {
+        FlightRecorder::record(FlightKind::GATEWAY_OUT, static_cast<uint8_t>(FlightGatewayMessage::CANCEL_ORDER), 0,
+                               static_cast<uint64_t>(orderId));
+        m_client->cancelOrder(orderId, OrderCancel());
+    });
+    if (!queued) {
+        spdlog::error("Cancel for order {} not sent: gateway is disconnected.", orderId);
+    }
+}
+
+void IBKRGatewayClient::post_execution_report(const ExecutionReport& report) {
+    Event report_event;
+    report_event.type = EventType::EXECUTION_REPORT;
+    report_event.data = report;
+    if (m_engine_core) {
+        m_engine_core->post_event(report_event);
+    }
 }
 
 void IBKRGatewayClient::process_messages() {
-    spdlog::info("Reader thread started.");
+    pthread_setname_np(pthread_self(), "gw_reader");
+    spdlog::info("Reader thread started ({} mode).", m_direct_reader ? "direct" : "threaded");
     while (m_is_connected && m_client->isConnected()) {
-        m_reader->processMsgs();
+        if (m_direct_reader) {
+            // Blocks in epoll; the timeout only bounds how long close_session() waits.
+            m_reader->processMsgsDirect(kDirectReaderTimeoutMs);
+        } else {
+            m_signal.waitForSignal();
+            m_reader->processMsgs();
+        }
     }
-    if (m_is_connected) {
+    if (!m_closing) {
+        // Tearing down from here would join this thread; the supervisor does it.
         spdlog::warn("Connection to IBKR was lost.");
-        disconnect();
+        m_is_connected = false;
+        m_supervisor->notify_connection_lost("socket closed");
     }
     spdlog::info("Reader thread finished.");
 }
@@ -118,15 +546,20 @@ void IBKRGatewayClient::tickPrice(TickerId tickerId, TickType field, double pric
     if (price <= 0.0)
         return;
     if (field == TickType::LAST || field == TickType::DELAYED_LAST) {
-        if (m_ticker_id_to_symbol.find(tickerId) == m_ticker_id_to_symbol.end()) {
-            spdlog::warn("Received tick for unknown TickerId: {}", tickerId);
+        SymbolId symbol_id = ticker_symbol(tickerId);
+        if (symbol_id == kInvalidSymbolId) {
+            TE_LOG_RATE_LIMITED(spdlog::level::warn, 5, "Received tick for unknown TickerId: {}", tickerId);
             return;
         }
+        FlightRecorder::record(FlightKind::GATEWAY_IN, static_cast<uint8_t>(FlightGatewayMessage::TICK_PRICE),
+                               symbol_id, static_cast<uint64_t>(Price::from_double(price).raw()));
+        Event tick_event;
+        tick_event.trace.stamp(LatencyStage::INGEST);
         Tick tick;
-        tick.symbol = m_ticker_id_to_symbol[tickerId];
-        tick.price = price;
+        tick.symbol = SymbolTable::instance().name(symbol_id);
+        tick.symbol_id = symbol_id;
+        tick.price = Price::from_double(price);
         tick.timestamp = std::chrono::system_clock::now();
-        Event tick_event;
         tick_event.type = EventType::TICK;
         tick_event.data = tick;
         if (m_engine_core) {
@@ -137,17 +570,65 @@ void IBKRGatewayClient::tickPrice(TickerId tickerId, TickType field, double pric
 
 void IBKRGatewayClient::tickSize(TickerId tickerId, TickType field, Decimal size) {
     if (field == TickType::LAST_SIZE || field == TickType::DELAYED_LAST_SIZE) {
-        if (m_ticker_id_to_symbol.count(tickerId)) {
-            spdlog::info("Tick Size for {}: {}", m_ticker_id_to_symbol[tickerId], DecimalFunctions::decimalToString(size));
+        SymbolId symbol_id = ticker_symbol(tickerId);
+        if (symbol_id != kInvalidSymbolId) {
+            TE_BINLOG(spdlog::level::info, "Tick Size for {}: {}", SymbolTable::instance().name(symbol_id),
+                      convert_from_ibkr_decimal(size).to_double());
         }
     }
 }
 
 void IBKRGatewayClient::error(int id, int errorCode, const std::string& errorString, const std::string&) {
+    FlightRecorder::record(FlightKind::GATEWAY_IN, static_cast<uint8_t>(FlightGatewayMessage::ERROR), 0,
+                           static_cast<uint64_t>(static_cast<int64_t>(id)), static_cast<uint64_t>(errorCode));
     spdlog::error("IBKR Error. ID: {}, Code: {}, Message: {}", id, errorCode, errorString);
+    if (id >= 0) {
+        SymbolId failed_symbol = kInvalidSymbolId;
+        {
+            std::lock_guard<std::mutex> lock(m_contract_request_mutex);
+            auto it = m_contract_requests.find(id);
+            if (it != m_contract_requests.end()) {
+                failed_symbol = it->second;
+                m_contract_requests.erase(it);
+                m_contract_results.erase(id);
+            }
+        }
+        if (failed_symbol != kInvalidSymbolId) {
+            post_contract_resolution(failed_symbol, false);
+        }
+    }
     if (errorCode == 502 || errorCode == 504 || errorCode == 522) {
-        m_is_connection_acknowledged = false;
-        m_connection_promise.set_value();
+        resolve_connection(false);
+    }
+    // 104: filled, cannot modify; 105: modify does not match the order; 161:
+    // not in a cancellable state; 201: rejected; 10148: cannot be cancelled.
+    // A modify in flight is what they refer to; otherwise 161/10148 answer a
+    // cancel. If the order is actually done, its terminal status follows in orderStatus.
+    if (id > 0 && (errorCode == 104 || errorCode == 105 || errorCode == 161 || errorCode == 201 ||
+                   errorCode == 10148)) {
+        bool modify_rejected = false;
+        {
+            std::lock_guard<std::mutex> lock(m_modifies_mutex);
+            modify_rejected = m_modifies.erase(static_cast<OrderId>(id)) > 0;
+        }
+        ExecutionReport report;
+        report.order_id = static_cast<uint64_t>(id);
+        if (modify_rejected) {
+            report.type = ReportType::MODIFY_REJECTED;
+            post_execution_report(report);
+        } else if (errorCode == 161 || errorCode == 10148) {
+            report.type = ReportType::CANCEL_REJECTED;
+            post_execution_report(report);
+        }
+    }
+    // TWS lost (1100) or regained (1101 data lost, 1102 data kept) its link to IB.
+    // The socket stays up, so only 1101 needs subscriptions replayed.
+    if (errorCode == 1100 || errorCode == 1101 || errorCode == 1102) {
+        ConnectionStatus status;
+        status.state = errorCode == 1100 ? ConnectionState::DISCONNECTED : ConnectionState::CONNECTED;
+        status.resync = errorCode == 1101;
+        status.detail = errorString;
+        post_connection_state(status);
     }
 }
 
@@ -157,53 +638,203 @@ void IBKRGatewayClient::orderStatus(OrderId orderId, const std::string& status,
                                     const std::string& whyHeld, double mktCapPrice) {
 
     spdlog::info("Order Status. Id: {}, Status: {}, Filled: {}, Remaining: {}, AvgFillPrice: {}",
-                 orderId, status, DecimalFunctions::decimalToString(filled),
-                 DecimalFunctions::decimalToString(remaining), avgFillPrice);
+                 orderId, status, convert_from_ibkr_decimal(filled).to_string(),
+                 convert_from_ibkr_decimal(remaining).to_string(), avgFillPrice);
 
+    // Quantities come from execDetails; the cumulative figures here would
+    // double count, so this only carries the status.
     ExecutionReport report;
     report.order_id = orderId;
-    report.fill_quantity = 0; 
-    report.fill_price = avgFillPrice;
-
-    Event report_event;
-    report_event.type = EventType::EXECUTION_REPORT;
-    report_event.data = report;
-    if (m_engine_core) {
-        m_engine_core->post_event(report_event);
+    if (!order_status_from_ibkr(status, report.new_status)) {
+        spdlog::warn("Ignoring unknown IB order status '{}' for order {}", status, orderId);
+        return;
+    }
+    FlightRecorder::record(FlightKind::GATEWAY_IN, static_cast<uint8_t>(FlightGatewayMessage::ORDER_STATUS), 0,
+                           static_cast<uint64_t>(orderId), static_cast<uint64_t>(report.new_status));
+    if (is_terminal(report.new_status)) {
+        std::lock_guard<std::mutex> lock(m_modifies_mutex);
+        m_modifies.erase(orderId);
     }
+    post_execution_report(report);
 }
 
 void IBKRGatewayClient::execDetails(int reqId, const Contract& contract, const Execution& execution) {
+    FlightRecorder::record(FlightKind::GATEWAY_IN, static_cast<uint8_t>(FlightGatewayMessage::EXECUTION),
+                           SymbolTable::instance().find(contract.symbol), static_cast<uint64_t>(execution.orderId),
+                           static_cast<uint64_t>(convert_from_ibkr_decimal(execution.shares).raw()));
     spdlog::info("Execution Details. OrderId: {}, Symbol: {}, Side: {}, Quantity: {}, Price: {}", 
                  execution.orderId, contract.symbol, execution.side, 
-                 DecimalFunctions::decimalToString(execution.shares), execution.price);
+                 convert_from_ibkr_decimal(execution.shares).to_string(), execution.price);
+    {
+        std::lock_guard<std::mutex> lock(m_reconcile_mutex);
+        if (m_reconcile.active && reqId == m_reconcile.executions_request) {
+            BrokerExecution broker_execution;
+            broker_execution.exec_id = execution.execId;
+            broker_execution.order_id = static_cast<uint64_t>(execution.orderId);
+            broker_execution.symbol = contract.symbol;
+            broker_execution.side = execution.side == "SLD" ? Side::SELL : Side::BUY;
+            broker_execution.quantity = convert_from_ibkr_decimal(execution.shares);
+            broker_execution.price = Price::from_double(execution.price);
+            m_reconcile.snapshot.executions.push_back(std::move(broker_execution));
+            return;
+        }
+    }
+    // Live fill: execution.shares is this execution only, so fills can be
+    // summed. OrderManager drops repeats of the same execId.
+    ExecutionReport report;
+    report.type = ReportType::FILL;
+    report.order_id = static_cast<uint64_t>(execution.orderId);
+    report.exec_id = execution.execId;
+    report.symbol = contract.symbol;
+    report.fill_quantity = convert_from_ibkr_decimal(execution.shares);
+    report.fill_price = Price::from_double(execution.price);
+    post_execution_report(report);
+}
+
+void IBKRGatewayClient::execDetailsEnd(int reqId) {
+    std::lock_guard<std::mutex> lock(m_reconcile_mutex);
+    if (m_reconcile.active && reqId == m_reconcile.executions_request) {
+        m_reconcile.executions_done = true;
+        finish_reconciliation_locked();
+    }
+}
+
+void IBKRGatewayClient::openOrder(OrderId orderId, const ::Contract& contract, const ::Order& order, const ::OrderState&) {
+    const Quantity quantity = convert_from_ibkr_decimal(order.totalQuantity);
+    {
+        std::lock_guard<std::mutex> lock(m_reconcile_mutex);
+        if (m_reconcile.active && !m_reconcile.orders_done) {
+            BrokerOrder broker_order;
+            broker_order.order_id = static_cast<uint64_t>(orderId);
+            broker_order.symbol = contract.symbol;
+            broker_order.quantity = quantity;
+            broker_order.filled_quantity = convert_from_ibkr_decimal(order.filledQuantity);
+            m_reconcile.snapshot.open_orders.push_back(std::move(broker_order));
+            return;
+        }
+    }
+    // IB echoes an accepted cancel-replace as openOrder with the new terms.
+    ExecutionReport report;
+    {
+        std::lock_guard<std::mutex> lock(m_modifies_mutex);
+        auto it = m_modifies.find(orderId);
+        if (it == m_modifies.end() || it->second.quantity != quantity ||
+            (it->second.has_price && it->second.price != Price::from_double(order.lmtPrice))) {
+            return;
+        }
+        report.order_quantity = quantity;
+        report.order_price = it->second.price;
+        m_modifies.erase(it);
+    }
+    report.type = ReportType::MODIFIED;
+    report.order_id = static_cast<uint64_t>(orderId);
+    report.symbol = contract.symbol;
+    post_execution_report(report);
+}
+
+void IBKRGatewayClient::openOrderEnd() {
+    std::lock_guard<std::mutex> lock(m_reconcile_mutex);
+    if (m_reconcile.active && !m_reconcile.orders_done) {
+        m_reconcile.orders_done = true;
+        finish_reconciliation_locked();
+    }
+}
+
+void IBKRGatewayClient::position(const std::string&, const Contract& contract, Decimal pos, double) {
+    std::lock_guard<std::mutex> lock(m_reconcile_mutex);
+    if (m_reconcile.active && !m_reconcile.positions_done) {
+        m_reconcile.snapshot.positions[contract.symbol] += convert_from_ibkr_decimal(pos);
+    }
+}
+
+void IBKRGatewayClient::positionEnd() {
+    {
+        std::lock_guard<std::mutex> lock(m_reconcile_mutex);
+        if (!m_reconcile.active || m_reconcile.positions_done) {
+            return;
+        }
+        m_reconcile.positions_done = true;
+        finish_reconciliation_locked();
+    }
+    // reqPositions keeps streaming updates; one snapshot is all we need.
+    m_outbound->submit(OutboundPriority::SUBSCRIPTION, [this] { m_client->cancelPositions(); });
 }
 
 
 void IBKRGatewayClient::request_historical_data(const std::string& symbol, const std::string& end_date_time, const std::string& duration, const std::string& bar_size) {
-    Contract contract;
-    contract.symbol = symbol;
-    contract.secType = "STK";
-    contract.exchange = "SMART";
-    contract.currency = "USD";
-    
-    long reqId = m_next_valid_order_id++; 
-    m_reqId_to_symbol_map[reqId] = symbol;
+    with_contract(symbol, [this, symbol, end_date_time, duration, bar_size](const Contract& contract) {
+        long reqId = m_next_valid_order_id++; 
+        m_reqId_to_symbol_map[reqId] = symbol;
+
+        m_outbound->submit(OutboundPriority::HISTORY, [this, reqId, contract, end_date_time, duration, bar_size] {
+            m_client->reqHistoricalData(reqId, contract, end_date_time, duration, bar_size, "TRADES", 1, 1, false, TagValueListSPtr());
+        });
+    });
+}
+
+void IBKRGatewayClient::contractDetails(int reqId, const ContractDetails& details) {
+    std::lock_guard<std::mutex> lock(m_contract_request_mutex);
+    auto it = m_contract_requests.find(reqId);
+    if (it == m_contract_requests.end()) {
+        return;
+    }
+    if (m_contract_results.count(reqId)) {
+        spdlog::warn("Contract for {} is ambiguous; keeping conId {} and ignoring conId {} ({})",
+                     details.contract.symbol, m_contract_results[reqId].con_id,
+                     details.contract.conId, details.contract.primaryExchange);
+        return;
+    }
+    ContractInfo info;
+    info.symbol_id = it->second;
+    info.symbol = SymbolTable::instance().name(it->second);
+    info.con_id = details.contract.conId;
+    info.sec_type = details.contract.secType;
+    info.exchange = details.contract.exchange;
+    info.primary_exchange = details.contract.primaryExchange;
+    info.currency = details.contract.currency;
+    info.min_tick = Price::from_double(details.minTick);
+    info.time_zone = details.timeZoneId;
+    info.trading_hours = details.tradingHours;
+    info.resolved_at = std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    m_contract_results.emplace(reqId, std::move(info));
+}
 
-    m_client->reqHistoricalData(reqId, contract, end_date_time, duration, bar_size, "TRADES", 1, 1, false, TagValueListSPtr());
+void IBKRGatewayClient::contractDetailsEnd(int reqId) {
+    SymbolId symbol_id = kInvalidSymbolId;
+    bool resolved = false;
+    {
+        std::lock_guard<std::mutex> lock(m_contract_request_mutex);
+        auto it = m_contract_requests.find(reqId);
+        if (it == m_contract_requests.end()) {
+            return;
+        }
+        symbol_id = it->second;
+        m_contract_requests.erase(it);
+        auto result = m_contract_results.find(reqId);
+        if (result != m_contract_results.end()) {
+            spdlog::info("Resolved {} to conId {} ({})", result->second.symbol, result->second.con_id,
+                         result->second.primary_exchange);
+            ContractCache::instance().store(result->second);
+            m_contract_results.erase(result);
+            resolved = true;
+        }
+    }
+    post_contract_resolution(symbol_id, resolved);
 }
 
 void IBKRGatewayClient::historicalData(TickerId reqId, const ::Bar& bar) {
-     spdlog::info("Historical Data. ReqId: {}, Date: {}, Open: {}, Close: {}", reqId, bar.time, bar.open, bar.close);
+     TE_BINLOG(spdlog::level::info, "Historical Data. ReqId: {}, Open: {}, High: {}, Low: {}, Close: {}",
+               reqId, bar.open, bar.high, bar.low, bar.close);
      
      // Convert to internal format
      TradingEngine::Bar engine_bar;
      engine_bar.time = bar.time;
-     engine_bar.open = bar.open;
-     engine_bar.high = bar.high;
-     engine_bar.low = bar.low;
-     engine_bar.close = bar.close;
-     engine_bar.volume = bar.volume;
+     engine_bar.open = Price::from_double(bar.open);
+     engine_bar.high = Price::from_double(bar.high);
+     engine_bar.low = Price::from_double(bar.low);
+     engine_bar.close = Price::from_double(bar.close);
+     engine_bar.volume = convert_from_ibkr_decimal(bar.volume);
      
      if(m_reqId_to_symbol_map.count(reqId)) {
         engine_bar.symbol = m_reqId_to_symbol_map[reqId];
@@ -220,24 +851,34 @@ void IBKRGatewayClient::historicalData(TickerId reqId, const ::Bar& bar) {
 void IBKRGatewayClient::historicalDataUpdate(TickerId reqId, const ::Bar& bar) {
 }
 
-void IBKRGatewayClient::openOrder(OrderId, const ::Contract&, const ::Order&, const ::OrderState&) {}
+// Same event and shard as the bars, so strategies see it after the last one.
+void IBKRGatewayClient::historicalDataEnd(int reqId, const std::string&, const std::string&) {
+    TradingEngine::Bar end;
+    end.end_of_history = true;
+    if (m_reqId_to_symbol_map.count(reqId)) {
+        end.symbol = m_reqId_to_symbol_map[reqId];
+    }
+    Event event;
+    event.type = EventType::HISTORICAL_DATA;
+    event.data = end;
+    if (m_engine_core) {
+        m_engine_core->post_event(event);
+    }
+}
+
 void IBKRGatewayClient::pnlSingle(int, Decimal, double, double, double, double) {}
 void IBKRGatewayClient::completedOrder(const ::Contract&, const ::Order&, const ::OrderState&) {}
 void IBKRGatewayClient::tickOptionComputation(TickerId, TickType, int, double, double, double, double, double, double, double, double) {}
 void IBKRGatewayClient::tickGeneric(TickerId, TickType, double) {}
 void IBKRGatewayClient::tickString(TickerId, TickType, const std::string&) {}
 void IBKRGatewayClient::tickEFP(TickerId, TickType, double, const std::string&, double, int, const std::string&, double, double) {}
-void IBKRGatewayClient::openOrderEnd() {}
 void IBKRGatewayClient::winError(const std::string& str, int lastError) { spdlog::error("IBKR WinError. Error: {}, Message: {}", lastError, str); }
 void IBKRGatewayClient::connectionClosed() { spdlog::warn("IBKR connection closed."); m_is_connected = false; m_signal.issueSignal(); }
 void IBKRGatewayClient::updateAccountValue(const std::string&, const std::string&, const std::string&, const std::string&) {}
 void IBKRGatewayClient::updatePortfolio(const Contract&, Decimal, double, double, double, double, double, const std::string&) {}
 void IBKRGatewayClient::updateAccountTime(const std::string&) {}
 void IBKRGatewayClient::accountDownloadEnd(const std::string&) {}
-void IBKRGatewayClient::contractDetails(int, const ContractDetails&) {}
 void IBKRGatewayClient::bondContractDetails(int, const ContractDetails&) {}
-void IBKRGatewayClient::contractDetailsEnd(int) {}
-void IBKRGatewayClient::execDetailsEnd(int) {}
 void IBKRGatewayClient::updateMktDepth(TickerId, int, int, int, double, Decimal) {}
 void IBKRGatewayClient::updateMktDepthL2(TickerId, int, const std::string&, int, int, double, Decimal, bool) {}
 void IBKRGatewayClient::updateNewsBulletin(int, int, const std::string&, const std::string&) {}
@@ -253,8 +894,6 @@ void IBKRGatewayClient::deltaNeutralValidation(int, const DeltaNeutralContract&)
 void IBKRGatewayClient::tickSnapshotEnd(int) {}
 void IBKRGatewayClient::marketDataType(TickerId, int) {}
 void IBKRGatewayClient::commissionReport(const CommissionReport&) {}
-void IBKRGatewayClient::position(const std::string&, const Contract&, Decimal, double) {}
-void IBKRGatewayClient::positionEnd() {}
 void IBKRGatewayClient::accountSummary(int, const std::string&, const std::string&, const std::string&, const std::string&) {}
 void IBKRGatewayClient::accountSummaryEnd(int) {}
 void IBKRGatewayClient::verifyMessageAPI(const std::string&) {}
@@ -273,7 +912,6 @@ void IBKRGatewayClient::securityDefinitionOptionalParameterEnd(int) {}
 void IBKRGatewayClient::softDollarTiers(int, const std::vector<SoftDollarTier>&) {}
 void IBKRGatewayClient::familyCodes(const std::vector<FamilyCode>&) {}
 void IBKRGatewayClient::symbolSamples(int, const std::vector<ContractDescription>&) {}
-void IBKRGatewayClient::historicalDataEnd(int, const std::string&, const std::string&) {}
 void IBKRGatewayClient::mktDepthExchanges(const std::vector<DepthMktDataDescription>&) {}
 void IBKRGatewayClient::tickNews(int, time_t, const std::string&, const std::string&, const std::string&, const std::string&) {}
 void IBKRGatewayClient::smartComponents(int, const SmartComponentsMap&) {}
@@ -1,4 +1,5 @@
 #include "IBKRMarketDataHandler.hpp"
+#include "IBKRConverters.hpp"
 #include "LogHandler.hpp"
 #include "EngineCore.hpp"
 #include "Event.hpp"
@@ -44,7 +45,7 @@ void IBKRMarketDataHandler::tickPrice(TickerId tickerId, TickType, double price,
 }
 
 void IBKRMarketDataHandler::tickSize(TickerId tickerId, TickType, Decimal size) {
-    spdlog::info("IBKR Tick Size. TickerId: {}, Size: {}", tickerId, DecimalFunctions::decimalToString(size));
+    spdlog::info("IBKR Tick Size. TickerId: {}, Size: {}", tickerId, TradingEngine::convert_from_ibkr_decimal(size).to_string());
 }
 
 void IBKRMarketDataHandler::nextValidId(OrderId orderId) {
@@ -59,11 +60,11 @@ void IBKRMarketDataHandler::error(int id, int errorCode, const std::string& erro
 void IBKRMarketDataHandler::historicalData(TickerId reqId, const ::Bar& bar) {
     TradingEngine::Bar engine_bar;
     engine_bar.time = bar.time;
-    engine_bar.open = bar.open;
-    engine_bar.high = bar.high;
-    engine_bar.low = bar.low;
-    engine_bar.close = bar.close;
-    engine_bar.volume = bar.volume;
+    engine_bar.open = TradingEngine::Price::from_double(bar.open);
+    engine_bar.high = TradingEngine::Price::from_double(bar.high);
+    engine_bar.low = TradingEngine::Price::from_double(bar.low);
+    engine_bar.close = TradingEngine::Price::from_double(bar.close);
+    engine_bar.volume = TradingEngine::convert_from_ibkr_decimal(bar.volume);
     if(m_reqId_to_symbol_map.count(reqId)){
          engine_bar.symbol = m_reqId_to_symbol_map[reqId]; 
     }
@@ -0,0 +1,53 @@
+#include "LastValueCache.hpp"
+
+namespace TradingEngine {
+
+LastValueCache::LastValueCache() : m_ticks(new TickSlot[SymbolTable::kMaxSymbols + 1]) {}
+
+bool LastValueCache::last_tick(SymbolId id, Tick& out) const {
+    if (id == kInvalidSymbolId || id > SymbolTable::kMaxSymbols) {
+        return false;
+    }
+    const TickSlot& slot = m_ticks[id];
+    int64_t price = 0;
+    int64_t size = 0;
+    int64_t timestamp = 0;
+    uint64_t before = 0;
+    uint64_t after = 0;
+    do {
+        before = slot.sequence.load(std::memory_order_acquire);
+        if (before == 0) {
+            return false;
+        }
+        price = slot.price.load(std::memory_order_relaxed);
+        size = slot.size.load(std::memory_order_relaxed);
+        timestamp = slot.timestamp.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        after = slot.sequence.load(std::memory_order_relaxed);
+    } while ((before & 1) || before != after);
+
+    out.symbol = SymbolTable::instance().name(id);
+    out.symbol_id = id;
+    out.price = Price::from_raw(price);
+    out.size = Quantity::from_raw(size);
+    out.timestamp = std::chrono::system_clock::time_point(std::chrono::system_clock::duration(timestamp));
+    return true;
+}
+
+void LastValueCache::record_bar(const Bar& bar) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_bars[bar.symbol] = bar;
+}
+
+void LastValueCache::record_order(uint64_t order_id, const std::string& topic, std::string payload, bool open) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!open) {
+        m_orders.erase(order_id);
+        return;
+    }
+    OpenOrder& order = m_orders[order_id];
+    order.topic = topic;
+    order.payload = std::move(payload);
+}
+
+}
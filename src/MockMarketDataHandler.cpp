@@ -1,6 +1,7 @@
 #include "MockMarketDataHandler.hpp"
 #include "EngineCore.hpp"
 #include "LogHandler.hpp"
+#include "BinaryLog.hpp"
 #include "Event.hpp"
 #include "Tick.hpp"
 #include <fstream>
@@ -44,6 +45,22 @@ void MockMarketDataHandler::disconnect() {
     spdlog::info("MockMarketDataHandler disconnected.");
 }
 
+bool MockMarketDataHandler::parse_tick_line(const std::string& line, Tick& tick) {
+    std::stringstream ss(line);
+    std::string symbol, price_str, size_str;
+    if (!(std::getline(ss, symbol, ',') && std::getline(ss, price_str, ',') && std::getline(ss, size_str))) {
+        return false;
+    }
+    if (!size_str.empty() && size_str.back() == '\r') {
+        size_str.pop_back();
+    }
+    tick.symbol = symbol;
+    if (!Price::parse(price_str, tick.price) || !Quantity::parse(size_str, tick.size)) {
+        return false;
+    }
+    return true;
+}
+
 void MockMarketDataHandler::process_data_feed() {
     std::ifstream data_file(m_csv_path);
     if (!data_file.is_open()) {
@@ -53,23 +70,20 @@ void MockMarketDataHandler::process_data_feed() {
     }
     std::string line;
     while (m_is_running && std::getline(data_file, line)) {
-        std::stringstream ss(line);
-        std::string symbol, price_str, size_str;
-        if (std::getline(ss, symbol, ',') && std::getline(ss, price_str, ',') && std::getline(ss, size_str)) {
-            try {
-                Tick tick;
-                tick.symbol = symbol;
-                tick.price = std::stod(price_str);
-                tick.size = std::stoull(size_str);
-                tick.timestamp = std::chrono::system_clock::now();
-                Event tick_event;
-                tick_event.type = EventType::TICK;
-                tick_event.data = tick;
-                m_engine_core->post_event(tick_event);
-		spdlog::info("Tick Posted");
-            } catch (const std::invalid_argument& e) {
-                spdlog::error("Could not parse line in CSV: {}", line);
-            }
+        if (line.empty()) {
+            continue;
+        }
+        Event tick_event;
+        tick_event.trace.stamp(LatencyStage::INGEST);
+        Tick tick;
+        if (parse_tick_line(line, tick)) {
+            tick.timestamp = std::chrono::system_clock::now();
+            tick_event.type = EventType::TICK;
+            tick_event.data = tick;
+            TE_BINLOG(spdlog::level::debug, "Tick Posted. Symbol: {}, Price: {}", tick.symbol, tick.price.to_double());
+            m_engine_core->post_event(tick_event);
+        } else {
+            spdlog::error("Could not parse line in CSV: {}", line);
         }
 	//If your strategy needs time to process ticks, modify the below
        // std::this_thread::sleep_for(std::chrono::milliseconds(500));
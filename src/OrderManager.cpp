@@ -1,5 +1,7 @@
 #include "OrderManager.hpp"
+#include "OrderLifecycle.hpp"
 #include "LogHandler.hpp"
+#include <algorithm>
 
 namespace TradingEngine {
 
@@ -7,39 +9,410 @@ OrderManager::OrderManager() : m_next_order_id(1) {}
 
 
 
-void OrderManager::update_order_status(const ExecutionReport& report) {
+bool OrderManager::update_order_status(const ExecutionReport& report) {
     auto it = m_orders.find(report.order_id);
     if (it == m_orders.end()) {
         spdlog::error("Received execution report for unknown order ID: {}", report.order_id);
-        return;
+        return false;
     }
     Order& order = it->second;
-    order.status = report.new_status;
-    double old_total_value = order.avg_fill_price * order.filled_quantity;
-    double new_fill_value = report.fill_price * report.fill_quantity;
-    order.filled_quantity += report.fill_quantity;
-    if (order.filled_quantity > 0) {
-        order.avg_fill_price = (old_total_value + new_fill_value) / order.filled_quantity;
-    }
-    double& position = m_positions[order.symbol];
+    if (order.acknowledged_at == std::chrono::system_clock::time_point{}) {
+        order.acknowledged_at = report.execution_timestamp;
+    }
+    bool changed = false;
+    switch (report.type) {
+        case ReportType::FILL: {
+            if (!report.exec_id.empty() && !m_exec_ids.insert(report.exec_id).second) {
+                spdlog::debug("Ignoring duplicate execution {} for order {}", report.exec_id, order.order_id);
+                return false;
+            }
+            apply_fill(order, report.fill_quantity, report.fill_price);
+            transition(order, order.filled_quantity >= order.quantity ? OrderStatus::FILLED
+                                                                      : OrderStatus::PARTIALLY_FILLED);
+            changed = true;
+            break;
+        }
+        case ReportType::STATUS:
+            if (report.fill_quantity > Quantity{}) {
+                apply_fill(order, report.fill_quantity, report.fill_price);
+                changed = true;
+            }
+            changed = transition(order, report.new_status) || changed;
+            break;
+        case ReportType::CANCEL_REJECTED:
+            if (order.status == OrderStatus::PENDING_CANCEL) {
+                spdlog::warn("Cancel for order {} rejected; it is still working.", order.order_id);
+                force_status(order, order.filled_quantity > Quantity{} ? OrderStatus::PARTIALLY_FILLED
+                                                                       : OrderStatus::CONFIRMED);
+                changed = true;
+            }
+            break;
+        case ReportType::MODIFIED:
+            if (is_terminal(order.status)) {
+                break;
+            }
+            // The broker's terms, not the pending ones: a later modify may be in flight.
+            if (report.order_quantity > Quantity{}) {
+                order.quantity = report.order_quantity;
+            }
+            if (order.order_type == OrderType::LIMIT && report.order_price.raw() != 0) {
+                order.price = report.order_price;
+            }
+            if (order.pending_quantity && *order.pending_quantity == order.quantity) {
+                order.pending_quantity.reset();
+            }
+            if (order.pending_price && *order.pending_price == order.price) {
+                order.pending_price.reset();
+            }
+            changed = true;
+            break;
+        case ReportType::MODIFY_REJECTED:
+            if (order.pending_quantity || order.pending_price) {
+                spdlog::warn("Modify of order {} rejected; it keeps {} @ {}.", order.order_id,
+                             order.quantity.to_string(), order.price.to_string());
+                order.pending_quantity.reset();
+                order.pending_price.reset();
+                changed = true;
+            }
+            break;
+    }
+    if (changed) {
+        spdlog::info("Updated order {}. New status: {}. New position for {}: {}",
+                     order.order_id, status_to_string(order.status), order.symbol, get_position(order.symbol).to_string());
+    }
+    return changed;
+}
+
+void OrderManager::apply_fill(Order& order, Quantity quantity, Price price) {
+    Notional total_value = notional(order.avg_fill_price, order.filled_quantity) + notional(price, quantity);
+    order.filled_quantity += quantity;
+    if (order.filled_quantity > Quantity{}) {
+        order.avg_fill_price = average_price(total_value, order.filled_quantity);
+    }
+    Quantity& position = m_positions[order.symbol];
     if (order.side == Side::BUY) {
-        position += report.fill_quantity;
+        position += quantity;
     } else {
-        position -= report.fill_quantity;
+        position -= quantity;
+    }
+    apply_strategy_fill(order, quantity, price);
+}
+
+void OrderManager::apply_strategy_fill(const Order& order, Quantity quantity, Price price) {
+    StrategyPosition& book = m_strategy_positions[order.strategy_id][order.symbol];
+    Quantity signed_quantity = order.side == Side::BUY ? quantity : -quantity;
+    Notional cost = notional(book.avg_price, book.position);
+    bool reducing = !book.position.is_zero() && ((book.position > Quantity{}) != (signed_quantity > Quantity{}));
+    if (reducing) {
+        Quantity held = book.position > Quantity{} ? book.position : -book.position;
+        Quantity closing = quantity < held ? quantity : held;
+        Quantity signed_closing = signed_quantity > Quantity{} ? closing : -closing;
+        // Cost of the part being closed, at the position's average price.
+        Notional closed_cost = divide_rounded(cost * closing.raw(), held.raw());
+        book.realized_pnl += -notional(price, signed_closing) - closed_cost;
+        cost -= closed_cost;
+        book.position += signed_closing;
+        signed_quantity -= signed_closing;
+    }
+    // Whatever is left opens or adds to a position in the fill's direction.
+    cost += notional(price, signed_quantity);
+    book.position += signed_quantity;
+    book.avg_price = average_price(cost, book.position);
+}
+
+bool OrderManager::owned_by(const Order& order, const std::string& strategy_id) const {
+    if (strategy_id.empty() || order.strategy_id == strategy_id) {
+        return true;
+    }
+    spdlog::error("Strategy {} may not act on order {} owned by {}", strategy_id, order.order_id, order.strategy_id);
+    return false;
+}
+
+bool OrderManager::transition(Order& order, OrderStatus status) {
+    if (status == order.status) {
+        return false;
+    }
+    if (!can_transition(order.status, status)) {
+        spdlog::debug("Order {}: ignoring {} -> {}", order.order_id, status_to_string(order.status),
+                      status_to_string(status));
+        return false;
+    }
+    force_status(order, status);
+    return true;
+}
+
+void OrderManager::force_status(Order& order, OrderStatus status) {
+    bool was_open = !is_terminal(order.status);
+    order.status = status;
+    if (was_open && is_terminal(status)) {
+        // Nothing left to modify.
+        order.pending_quantity.reset();
+        order.pending_price.reset();
+        unindex_open(order);
+    } else if (!was_open && !is_terminal(status)) {
+        index_open(order);
+    }
+}
+
+void OrderManager::index_open(const Order& order) {
+    m_open_orders.insert(order.order_id);
+    m_open_by_symbol[order.symbol].insert(order.order_id);
+    if (!order.strategy_id.empty()) {
+        m_open_by_strategy[order.strategy_id].insert(order.order_id);
+    }
+}
+
+void OrderManager::unindex_open(const Order& order) {
+    m_open_orders.erase(order.order_id);
+    auto erase_from = [&order](auto& index, const std::string& key) {
+        auto it = index.find(key);
+        if (it == index.end()) {
+            return;
+        }
+        it->second.erase(order.order_id);
+        if (it->second.empty()) {
+            index.erase(it);
+        }
+    };
+    erase_from(m_open_by_symbol, order.symbol);
+    if (!order.strategy_id.empty()) {
+        erase_from(m_open_by_strategy, order.strategy_id);
     }
-    spdlog::info("Updated order {}. New status: {}. New position for {}: {}",
-                 order.order_id, status_to_string(order.status), order.symbol, position);
 }
 
+bool OrderManager::request_cancel(uint64_t order_id, const std::string& strategy_id) {
+    auto it = m_orders.find(order_id);
+    if (it == m_orders.end()) {
+        spdlog::error("Cancel requested for unknown order ID: {}", order_id);
+        return false;
+    }
+    Order& order = it->second;
+    if (!owned_by(order, strategy_id)) {
+        return false;
+    }
+    if (!transition(order, OrderStatus::PENDING_CANCEL)) {
+        spdlog::warn("Order {} is {}; not cancelling.", order_id, status_to_string(order.status));
+        return false;
+    }
+    spdlog::info("Cancel requested for order {}", order_id);
+    return true;
+}
+
+bool OrderManager::request_modify(uint64_t order_id, std::optional<Quantity> quantity, std::optional<Price> price,
+                                  const std::string& strategy_id) {
+    auto it = m_orders.find(order_id);
+    if (it == m_orders.end()) {
+        spdlog::error("Modify requested for unknown order ID: {}", order_id);
+        return false;
+    }
+    Order& order = it->second;
+    if (!owned_by(order, strategy_id)) {
+        return false;
+    }
+    if (is_terminal(order.status) || order.status == OrderStatus::PENDING_CANCEL) {
+        spdlog::warn("Order {} is {}; not modifying.", order_id, status_to_string(order.status));
+        return false;
+    }
+    if (quantity && *quantity <= order.filled_quantity) {
+        spdlog::error("Rejected modify of order {}: quantity {} does not exceed filled {}", order_id,
+                      quantity->to_string(), order.filled_quantity.to_string());
+        return false;
+    }
+    if (price && order.order_type != OrderType::LIMIT) {
+        spdlog::error("Rejected modify of order {}: only limit orders have a price.", order_id);
+        return false;
+    }
+    if (quantity) {
+        order.pending_quantity = *quantity;
+    }
+    if (price) {
+        order.pending_price = *price;
+    }
+    spdlog::info("Modify requested for order {}: {} @ {}", order_id,
+                 order.pending_quantity.value_or(order.quantity).to_string(),
+                 order.pending_price.value_or(order.price).to_string());
+    return true;
+}
+
+std::vector<uint64_t> OrderManager::request_mass_cancel(const std::string& symbol, const std::string& strategy_id) {
+    const std::unordered_set<uint64_t>* candidates = &m_open_orders;
+    if (!symbol.empty() || !strategy_id.empty()) {
+        const auto& index = symbol.empty() ? m_open_by_strategy : m_open_by_symbol;
+        auto it = index.find(symbol.empty() ? strategy_id : symbol);
+        if (it == index.end()) {
+            return {};
+        }
+        candidates = &it->second;
+    }
+    std::vector<uint64_t> cancelled;
+    for (uint64_t order_id : *candidates) {
+        Order& order = m_orders.at(order_id);
+        if (!strategy_id.empty() && order.strategy_id != strategy_id) {
+            continue;
+        }
+        // PENDING_CANCEL is not terminal, so the index is not modified here.
+        if (transition(order, OrderStatus::PENDING_CANCEL)) {
+            cancelled.push_back(order_id);
+        }
+    }
+    std::sort(cancelled.begin(), cancelled.end());
+    spdlog::info("Mass cancel (symbol '{}', strategy '{}'): {} order(s).", symbol, strategy_id, cancelled.size());
+    return cancelled;
+}
+
+size_t OrderManager::reconcile(const BrokerSnapshot& snapshot, std::vector<uint64_t>* closed) {
+    struct Fills {
+        Quantity quantity;
+        Notional value = 0;
+    };
+    std::unordered_map<uint64_t, Fills> broker_fills;
+    for (const auto& execution : snapshot.executions) {
+        // A live execDetails for the same execution must not count again.
+        m_exec_ids.insert(execution.exec_id);
+        Fills& fills = broker_fills[execution.order_id];
+        fills.quantity += execution.quantity;
+        fills.value += notional(execution.price, execution.quantity);
+    }
+    std::unordered_map<uint64_t, const BrokerOrder*> working;
+    for (const auto& open_order : snapshot.open_orders) {
+        working[open_order.order_id] = &open_order;
+    }
+    const std::unordered_set<uint64_t> unsent(snapshot.unsent_orders.begin(), snapshot.unsent_orders.end());
+    // Missing from the open orders proves an order is gone only if the broker
+    // knew it when they were requested, or never received it at all. Anything
+    // else may still be queued in the journal or the scheduler.
+    auto gone = [&](const Order& order) {
+        if (order.acknowledged_at == std::chrono::system_clock::time_point{}) {
+            return unsent.count(order.order_id) > 0;
+        }
+        return order.acknowledged_at < snapshot.requested_at;
+    };
+
+    size_t corrections = 0;
+    for (auto& [id, order] : m_orders) {
+        auto fills = broker_fills.find(id);
+        if (fills != broker_fills.end() && fills->second.quantity > order.filled_quantity) {
+            Quantity missed = fills->second.quantity - order.filled_quantity;
+            spdlog::warn("Reconcile: order {} missed fills of {} {}", id, missed.to_string(), order.symbol);
+            apply_strategy_fill(order, missed,
+                                average_price(fills->second.value - notional(order.avg_fill_price, order.filled_quantity), missed));
+            order.filled_quantity = fills->second.quantity;
+            order.avg_fill_price = average_price(fills->second.value, order.filled_quantity);
+            Quantity& position = m_positions[order.symbol];
+            position = order.side == Side::BUY ? position + missed : position - missed;
+            ++corrections;
+        }
+        OrderStatus status = order.status;
+        auto broker_order = working.find(id);
+        if (broker_order != working.end()) {
+            // Whatever modify was in flight, the broker's quantity is the one working.
+            const Quantity broker_quantity = broker_order->second->quantity;
+            if (broker_quantity > Quantity{} && broker_quantity != order.quantity) {
+                spdlog::warn("Reconcile: order {} quantity {} -> {}", id, order.quantity.to_string(),
+                             broker_quantity.to_string());
+                order.quantity = broker_quantity;
+                ++corrections;
+            }
+            order.pending_quantity.reset();
+            order.pending_price.reset();
+            // Still working; a cancel in flight stays pending until the broker answers it.
+            if (status != OrderStatus::PENDING_CANCEL) {
+                status = order.filled_quantity > Quantity{} ? OrderStatus::PARTIALLY_FILLED : OrderStatus::CONFIRMED;
+            }
+        } else if (order.filled_quantity >= order.quantity && order.quantity > Quantity{}) {
+            status = OrderStatus::FILLED;
+        } else if (!is_terminal(status) && gone(order)) {
+            // Not working at the broker and not filled.
+            status = OrderStatus::CANCELED;
+        }
+        if (status != order.status) {
+            spdlog::warn("Reconcile: order {} {} -> {}", id, status_to_string(order.status), status_to_string(status));
+            force_status(order, status);
+            ++corrections;
+            if (closed && is_terminal(status)) {
+                closed->push_back(id);
+            }
+        }
+    }
+
+    for (auto& [symbol, position] : m_positions) {
+        if (!snapshot.positions.count(symbol) && position != Quantity{}) {
+            spdlog::warn("Reconcile: broker reports no position in {}; had {}", symbol, position.to_string());
+            position = Quantity{};
+            ++corrections;
+        }
+    }
+    for (const auto& [symbol, broker_position] : snapshot.positions) {
+        Quantity& position = m_positions[symbol];
+        if (position != broker_position) {
+            spdlog::warn("Reconcile: position in {} {} -> {}", symbol, position.to_string(), broker_position.to_string());
+            position = broker_position;
+            ++corrections;
+        }
+    }
+    spdlog::info("Reconciled {} order(s) against {} open order(s), {} execution(s), {} position(s): {} correction(s).",
+                 m_orders.size(), snapshot.open_orders.size(), snapshot.executions.size(),
+                 snapshot.positions.size(), corrections);
+    return corrections;
+}
 
 uint64_t OrderManager::add_new_order(Order& order) {
-    uint64_t id = m_next_order_id++; 
+    uint64_t id = m_ids->fetch_add(1);
     order.order_id = id;
+    if (order.strategy_id.empty()) {
+        order.strategy_id = kDefaultStrategyId;
+    }
     m_orders[id] = order;
+    if (!is_terminal(order.status)) {
+        index_open(order);
+    }
     spdlog::info("New order added with ID: {}", id);
     return id;
 }
 
+void OrderManager::restore_order(const Order& order) {
+    auto it = m_orders.find(order.order_id);
+    if (it != m_orders.end() && !is_terminal(it->second.status)) {
+        unindex_open(it->second);
+    }
+    Order& stored = m_orders[order.order_id] = order;
+    if (stored.acknowledged_at == std::chrono::system_clock::time_point{}) {
+        // From an earlier run: it reached the broker then or never will.
+        stored.acknowledged_at = stored.creation_timestamp;
+    }
+    if (!is_terminal(stored.status)) {
+        index_open(stored);
+    }
+    raise_next_order_id(order.order_id + 1);
+}
+
+OrderManagerState OrderManager::export_state() const {
+    OrderManagerState state;
+    state.next_order_id = m_ids->load();
+    state.orders.reserve(m_orders.size());
+    for (const auto& [id, order] : m_orders) {
+        state.orders.push_back(order);
+    }
+    state.positions = m_positions;
+    state.strategy_positions = m_strategy_positions;
+    state.exec_ids.assign(m_exec_ids.begin(), m_exec_ids.end());
+    return state;
+}
+
+void OrderManager::import_state(OrderManagerState state) {
+    m_orders.clear();
+    m_open_orders.clear();
+    m_open_by_symbol.clear();
+    m_open_by_strategy.clear();
+    raise_next_order_id(state.next_order_id);
+    for (const auto& order : state.orders) {
+        restore_order(order);
+    }
+    m_positions = std::move(state.positions);
+    m_strategy_positions = std::move(state.strategy_positions);
+    m_exec_ids = std::unordered_set<std::string>(state.exec_ids.begin(), state.exec_ids.end());
+}
+
 Order OrderManager::get_order(uint64_t order_id) const {
     auto it = m_orders.find(order_id);
     if (it != m_orders.end()) {
@@ -49,16 +422,63 @@ Order OrderManager::get_order(uint64_t order_id) const {
 }
 
 void OrderManager::set_next_order_id(uint64_t id) {
+    if (!raise_next_order_id(id)) {
+        // Orders recovered from the journal already use the ids below; never hand them out twice.
+        spdlog::info("Ignoring next valid ID {}; IDs below {} are already in use.", id, m_ids->load());
+        return;
+    }
     spdlog::info("OrderManager's next valid ID set to: {}", id);
-    m_next_order_id = id;
 }
 
-double OrderManager::get_position(const std::string& symbol) const {
+void OrderManager::share_order_ids(OrderManager& owner) {
+    owner.raise_next_order_id(m_ids->load());
+    m_ids = owner.m_ids;
+}
+
+bool OrderManager::raise_next_order_id(uint64_t id) {
+    uint64_t current = m_ids->load();
+    while (current < id) {
+        if (m_ids->compare_exchange_weak(current, id)) {
+            return true;
+        }
+    }
+    return current == id;
+}
+
+size_t OrderManager::open_order_count(const std::string& symbol) const {
+    if (symbol.empty()) {
+        return m_open_orders.size();
+    }
+    auto it = m_open_by_symbol.find(symbol);
+    return it == m_open_by_symbol.end() ? 0 : it->second.size();
+}
+
+StrategyPosition OrderManager::get_strategy_position(const std::string& strategy_id, const std::string& symbol) const {
+    auto strategy = m_strategy_positions.find(strategy_id);
+    if (strategy == m_strategy_positions.end()) {
+        return StrategyPosition{};
+    }
+    auto it = strategy->second.find(symbol);
+    return it == strategy->second.end() ? StrategyPosition{} : it->second;
+}
+
+Notional OrderManager::get_strategy_realized_pnl(const std::string& strategy_id) const {
+    Notional total = 0;
+    auto strategy = m_strategy_positions.find(strategy_id);
+    if (strategy != m_strategy_positions.end()) {
+        for (const auto& [symbol, book] : strategy->second) {
+            total += book.realized_pnl;
+        }
+    }
+    return total;
+}
+
+Quantity OrderManager::get_position(const std::string& symbol) const {
     auto it = m_positions.find(symbol);
     if (it != m_positions.end()) {
         return it->second;
     }
-    return 0.0;
+    return Quantity{};
 }
 
 }
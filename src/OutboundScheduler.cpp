@@ -0,0 +1,211 @@
+#include "OutboundScheduler.hpp"
+#include "LogHandler.hpp"
+#include <algorithm>
+#include <pthread.h>
+#include <string>
+
+namespace TradingEngine {
+
+const char* outbound_priority_to_string(OutboundPriority priority) {
+    switch (priority) {
+        case OutboundPriority::CANCEL:
+            return "cancel";
+        case OutboundPriority::NEW_ORDER:
+            return "new_order";
+        case OutboundPriority::SUBSCRIPTION:
+            return "subscription";
+        case OutboundPriority::HISTORY:
+            return "history";
+        default:
+            return "unknown";
+    }
+}
+
+TokenBucket::TokenBucket(double rate_per_second, double burst)
+    : m_rate_per_ns(rate_per_second / 1e9), m_burst(burst), m_tokens(burst) {}
+
+void TokenBucket::refill(uint64_t now_ns) {
+    if (m_last_ns == 0) {
+        m_last_ns = now_ns;
+        return;
+    }
+    if (now_ns > m_last_ns) {
+        m_tokens = std::min(m_burst, m_tokens + static_cast<double>(now_ns - m_last_ns) * m_rate_per_ns);
+        m_last_ns = now_ns;
+    }
+}
+
+bool TokenBucket::try_consume(uint64_t now_ns, double reserve) {
+    refill(now_ns);
+    if (m_tokens - 1.0 < reserve) {
+        return false;
+    }
+    m_tokens -= 1.0;
+    return true;
+}
+
+uint64_t TokenBucket::wait_ns(uint64_t now_ns, double reserve) {
+    refill(now_ns);
+    double missing = reserve + 1.0 - m_tokens;
+    if (missing <= 0.0) {
+        return 0;
+    }
+    return static_cast<uint64_t>(missing / m_rate_per_ns) + 1;
+}
+
+OutboundScheduler::OutboundScheduler(Config config)
+    : m_config(config),
+      m_bucket(config.messages_per_second, config.burst),
+      m_sent(StatsRegistry::instance().counter("outbound.sent")),
+      m_throttled(StatsRegistry::instance().counter("outbound.throttled")) {
+    auto& stats = StatsRegistry::instance();
+    for (size_t i = 0; i < kOutboundPriorityCount; ++i) {
+        std::string name = outbound_priority_to_string(static_cast<OutboundPriority>(i));
+        m_depth[i] = &stats.gauge("outbound.queue_depth." + name);
+        m_wait[i] = &stats.histogram("outbound.wait_ns." + name);
+    }
+}
+
+OutboundScheduler::~OutboundScheduler() {
+    stop();
+}
+
+void OutboundScheduler::start() {
+    if (m_running.exchange(true)) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_closed = false;
+    }
+    m_thread = std::thread(&OutboundScheduler::run, this);
+    spdlog::info("Outbound scheduler started ({} msg/s, burst {}).", m_config.messages_per_second, m_config.burst);
+}
+
+void OutboundScheduler::stop() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_running = false;
+        m_closed = true;
+    }
+    m_cv.notify_all();
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    size_t dropped = 0;
+    for (auto& queue : m_queues) {
+        dropped += queue.size();
+        queue.clear();
+    }
+    if (dropped > 0) {
+        spdlog::warn("Outbound scheduler stopped with {} unsent request(s).", dropped);
+    }
+    update_depth_gauges_locked();
+}
+
+bool OutboundScheduler::submit(OutboundPriority priority, std::function<void()> send) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_closed) {
+            return false;
+        }
+        m_queues[static_cast<size_t>(priority)].push_back(Request{std::move(send), monotonic_ns()});
+        ++m_submissions;
+        update_depth_gauges_locked();
+    }
+    m_cv.notify_one();
+    return true;
+}
+
+size_t OutboundScheduler::pending(OutboundPriority priority) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_queues[static_cast<size_t>(priority)].size();
+}
+
+size_t OutboundScheduler::pending() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    size_t total = 0;
+    for (const auto& queue : m_queues) total += queue.size();
+    return total;
+}
+
+uint64_t OutboundScheduler::dispatch_ready(uint64_t now_ns) {
+    while (true) {
+        Request request;
+        size_t chosen = kOutboundPriorityCount;
+        uint64_t wait = UINT64_MAX;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for (size_t p = 0; p < kOutboundPriorityCount; ++p) {
+                auto& queue = m_queues[p];
+                if (queue.empty()) {
+                    continue;
+                }
+                bool low_priority = p >= static_cast<size_t>(OutboundPriority::SUBSCRIPTION);
+                double reserve = low_priority ? m_config.low_priority_reserve : 0.0;
+                if (p == static_cast<size_t>(OutboundPriority::HISTORY) && now_ns < m_next_history_ns) {
+                    wait = std::min(wait, m_next_history_ns - now_ns);
+                    continue;
+                }
+                if (!m_bucket.try_consume(now_ns, reserve)) {
+                    // Lower classes need at least as many tokens, so stop here.
+                    wait = std::min(wait, m_bucket.wait_ns(now_ns, reserve));
+                    m_throttled.add();
+                    break;
+                }
+                request = std::move(queue.front());
+                queue.pop_front();
+                chosen = p;
+                if (p == static_cast<size_t>(OutboundPriority::HISTORY)) {
+                    m_next_history_ns = now_ns + static_cast<uint64_t>(
+                        std::chrono::duration_cast<std::chrono::nanoseconds>(m_config.history_spacing).count());
+                }
+                break;
+            }
+            update_depth_gauges_locked();
+        }
+        if (chosen == kOutboundPriorityCount) {
+            return wait == UINT64_MAX ? 0 : wait;
+        }
+        m_wait[chosen]->record(now_ns > request.enqueued_ns ? now_ns - request.enqueued_ns : 0);
+        m_sent.add();
+        request.send();
+    }
+}
+
+void OutboundScheduler::run() {
+    pthread_setname_np(pthread_self(), "gw_outbound");
+    while (true) {
+        uint64_t seen;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_cv.wait(lock, [this] {
+                if (!m_running) return true;
+                for (const auto& queue : m_queues) {
+                    if (!queue.empty()) return true;
+                }
+                return false;
+            });
+            if (!m_running) {
+                break;
+            }
+            seen = m_submissions;
+        }
+        uint64_t wait = dispatch_ready(monotonic_ns());
+        if (wait > 0) {
+            // A new submission may be sendable sooner (e.g. an order behind spaced-out history).
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_cv.wait_for(lock, std::chrono::nanoseconds(wait),
+                          [this, seen] { return !m_running || m_submissions != seen; });
+        }
+    }
+}
+
+void OutboundScheduler::update_depth_gauges_locked() {
+    for (size_t i = 0; i < kOutboundPriorityCount; ++i) {
+        m_depth[i]->set(static_cast<int64_t>(m_queues[i].size()));
+    }
+}
+
+}
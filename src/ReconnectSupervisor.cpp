@@ -0,0 +1,138 @@
+#include "ReconnectSupervisor.hpp"
+#include "LogHandler.hpp"
+#include <algorithm>
+
+namespace TradingEngine {
+
+const char* connection_state_to_string(ConnectionState state) {
+    switch (state) {
+        case ConnectionState::CONNECTING:
+            return "CONNECTING";
+        case ConnectionState::CONNECTED:
+            return "CONNECTED";
+        case ConnectionState::DISCONNECTED:
+            return "DISCONNECTED";
+        case ConnectionState::RECONNECTING:
+            return "RECONNECTING";
+        case ConnectionState::RESYNCED:
+            return "RESYNCED";
+        default:
+            return "UNKNOWN";
+    }
+}
+
+ReconnectBackoff::ReconnectBackoff(std::chrono::milliseconds initial, std::chrono::milliseconds max)
+    : m_initial(initial), m_max(std::max(initial, max)), m_next(initial) {}
+
+std::chrono::milliseconds ReconnectBackoff::next_delay() {
+    auto delay = m_next;
+    m_next = std::min(m_max, m_next * 2);
+    return delay;
+}
+
+ReconnectSupervisor::ReconnectSupervisor(Config config, Callbacks callbacks)
+    : m_config(config), m_callbacks(std::move(callbacks)) {}
+
+ReconnectSupervisor::~ReconnectSupervisor() {
+    stop();
+}
+
+void ReconnectSupervisor::start() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_thread.joinable()) {
+        return;
+    }
+    m_stopping = false;
+    m_thread = std::thread(&ReconnectSupervisor::run, this);
+}
+
+void ReconnectSupervisor::stop() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_cv.notify_all();
+    if (m_thread.joinable() && m_thread.get_id() != std::this_thread::get_id()) {
+        m_thread.join();
+    }
+}
+
+void ReconnectSupervisor::notify_connection_lost(const std::string& reason) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_lost || m_stopping) {
+            return;
+        }
+        m_lost = true;
+        m_reason = reason;
+    }
+    m_cv.notify_all();
+}
+
+void ReconnectSupervisor::report(ConnectionState state, int attempt, int64_t downtime_ms, const std::string& detail) {
+    if (!m_callbacks.on_state) {
+        return;
+    }
+    ConnectionStatus status;
+    status.state = state;
+    status.attempt = attempt;
+    status.resync = state == ConnectionState::CONNECTED;
+    status.downtime_ms = downtime_ms;
+    status.detail = detail;
+    m_callbacks.on_state(status);
+}
+
+void ReconnectSupervisor::run() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+        m_cv.wait(lock, [this] { return m_stopping || m_lost; });
+        if (m_stopping) {
+            break;
+        }
+        std::string reason = m_reason;
+        m_reconnecting = true;
+        lock.unlock();
+
+        auto lost_at = std::chrono::steady_clock::now();
+        auto elapsed_ms = [lost_at] {
+            return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - lost_at).count();
+        };
+        spdlog::warn("Connection lost ({}); reconnecting.", reason);
+        m_callbacks.teardown();
+        report(ConnectionState::DISCONNECTED, 0, 0, reason);
+
+        ReconnectBackoff backoff(m_config.initial_delay, m_config.max_delay);
+        bool connected = false;
+        for (int attempt = 1;; ++attempt) {
+            {
+                // The previous session is torn down, so any loss reported
+                // from here on belongs to the session being opened.
+                std::lock_guard<std::mutex> guard(m_mutex);
+                if (m_stopping) break;
+                m_lost = false;
+            }
+            report(ConnectionState::RECONNECTING, attempt, elapsed_ms(), reason);
+            if (m_callbacks.reconnect(attempt)) {
+                spdlog::info("Reconnected after {} ms ({} attempt(s)).", elapsed_ms(), attempt);
+                report(ConnectionState::CONNECTED, attempt, elapsed_ms(), reason);
+                connected = true;
+                break;
+            }
+            m_callbacks.teardown();
+            auto delay = backoff.next_delay();
+            spdlog::warn("Reconnect attempt {} failed; retrying in {} ms.", attempt, delay.count());
+            std::unique_lock<std::mutex> wait_lock(m_mutex);
+            if (m_cv.wait_for(wait_lock, delay, [this] { return m_stopping; })) {
+                break;
+            }
+        }
+        if (!connected) {
+            spdlog::info("Reconnect abandoned: supervisor stopping.");
+        }
+
+        lock.lock();
+        m_reconnecting = false;
+    }
+}
+
+}
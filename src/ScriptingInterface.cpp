@@ -3,19 +3,105 @@
 #include "LogHandler.hpp"
 #include "Event.hpp"
 #include "Order.hpp"
+#include "OrderLifecycle.hpp"
+#include "FlightRecorder.hpp"
 #include <nlohmann/json.hpp>
+#include <algorithm>
+#include <chrono>
 #include <stdexcept>
+#include <vector>
+#include <pthread.h>
 
 namespace TradingEngine {
 
+namespace {
+
+// Whole quantities stay JSON integers so the wire format is unchanged for share counts.
+nlohmann::json quantity_to_json(Quantity quantity) {
+    if (quantity.is_integral()) {
+        return quantity.integral_part();
+    }
+    return quantity.to_double();
+}
+
+// One CREATE_ORDER payload (or one entry of a CREATE_ORDER_BATCH). Logs and
+// returns false if the order is malformed, so the rest of a batch still goes.
+bool parse_order(const nlohmann::json& payload, Order& order) {
+    try {
+        order.strategy_id = payload.value("strategy_id", "");
+        if (order.strategy_id.find('.') != std::string::npos) {
+            spdlog::error("Rejected CREATE_ORDER: strategy_id '{}' may not contain '.'", order.strategy_id);
+            return false;
+        }
+        order.symbol = payload.at("symbol").get<std::string>();
+        order.symbol_id = SymbolTable::instance().intern(order.symbol);
+        order.quantity = Quantity::from_double(payload.at("quantity").get<double>());
+
+        std::string side_str = payload.at("side").get<std::string>();
+        if (side_str == "BUY") order.side = Side::BUY;
+        else if (side_str == "SELL") order.side = Side::SELL;
+
+        std::string type_str = payload.at("order_type").get<std::string>();
+        if (type_str == "MARKET") order.order_type = OrderType::MARKET;
+        else if (type_str == "LIMIT") {
+            order.order_type = OrderType::LIMIT;
+            order.price = Price::from_double(payload.value("limit_price", 0.0));
+            const auto& ticks = TickSizeTable::instance();
+            if (!ticks.is_on_tick(order.symbol, order.price)) {
+                spdlog::error("Rejected CREATE_ORDER for {}: limit price {} is not a multiple of tick size {}",
+                              order.symbol, order.price.to_string(), ticks.tick_size(order.symbol).to_string());
+                return false;
+            }
+        }
+        return true;
+    } catch (const nlohmann::json::exception& e) {
+        spdlog::error("Failed to parse order: {}", e.what());
+        return false;
+    }
+}
+
+std::string serialize_bar(const Bar& bar, bool snapshot) {
+    nlohmann::json payload_json;
+    payload_json["symbol"] = bar.symbol;
+    payload_json["time"] = bar.time;
+    payload_json["open"] = bar.open.to_double();
+    payload_json["high"] = bar.high.to_double();
+    payload_json["low"] = bar.low.to_double();
+    payload_json["close"] = bar.close.to_double();
+    payload_json["volume"] = quantity_to_json(bar.volume);
+    if (snapshot) {
+        payload_json["snapshot"] = true;
+    }
+    return payload_json.dump();
+}
+
+// Whether a subscription to prefix can match some topic starting with family.
+bool may_match(std::string_view prefix, std::string_view family) {
+    size_t length = std::min(prefix.size(), family.size());
+    return prefix.substr(0, length) == family.substr(0, length);
+}
+
+bool starts_with(std::string_view text, std::string_view prefix) {
+    return text.substr(0, prefix.size()) == prefix;
+}
+
+}
+
 ScriptingInterface::ScriptingInterface(EngineCore& engine_core, const std::string& data_pub_endpoint, const std::string& command_sub_endpoint)
     : m_engine_core(engine_core),
       m_context(1),
-      m_data_publisher(m_context, ZMQ_PUB),
+      m_data_publisher(m_context, ZMQ_XPUB),
+      m_unsubscribed_skips(&StatsRegistry::instance().counter("publish.unsubscribed_skips")),
+      m_snapshot_messages(&StatsRegistry::instance().counter("publish.snapshot_messages")),
       m_command_subscriber(m_context, ZMQ_SUB),
       m_data_pub_endpoint(data_pub_endpoint),
       m_command_sub_endpoint(command_sub_endpoint),
-      m_is_running(false) {}
+      m_is_running(false) {
+    m_subscriptions.on_change([](const std::string& prefix, int count) {
+        spdlog::info("Data channel subscribers to '{}': {}", prefix, count);
+        StatsRegistry::instance().gauge("subscribers." + (prefix.empty() ? std::string("*") : prefix)).set(count);
+    });
+}
 
 ScriptingInterface::~ScriptingInterface() {
     if (m_is_running) {
@@ -27,6 +113,9 @@ ScriptingInterface::~ScriptingInterface() {
 void ScriptingInterface::start() {
     m_is_running = true;
     spdlog::info("ScriptingInterface starting...");
+    // Every subscribe and unsubscribe, not just each prefix's first and last,
+    // so subscribers can be counted.
+    m_data_publisher.set(zmq::sockopt::xpub_verboser, 1);
     m_data_publisher.bind(m_data_pub_endpoint);
     m_command_subscriber.bind(m_command_sub_endpoint);
     spdlog::info("Data publisher bound to {}", m_data_pub_endpoint);
@@ -43,48 +132,228 @@ void ScriptingInterface::stop() {
     spdlog::info("ScriptingInterface stopped.");
 }
 
-void ScriptingInterface::publish_tick(const Tick& tick) {
-    std::string topic = "TICK." + tick.symbol;
+std::string ScriptingInterface::serialize_tick(const Tick& tick, bool snapshot) {
     nlohmann::json payload_json;
     payload_json["timestamp"] = std::to_string(tick.timestamp.time_since_epoch().count());
     payload_json["data"]["symbol"] = tick.symbol;
-    payload_json["data"]["price"] = tick.price;
-    payload_json["data"]["size"] = tick.size;
-    std::string payload_str = payload_json.dump();
+    payload_json["data"]["price"] = tick.price.to_double();
+    payload_json["data"]["size"] = quantity_to_json(tick.size);
+    if (snapshot) {
+        payload_json["snapshot"] = true;
+    }
+    return payload_json.dump();
+}
+
+void ScriptingInterface::publish_tick(const Tick& tick, LatencyTrace* trace) {
+    // Before the subscriber check, so a subscription that arrives after the
+    // check still finds this tick in its snapshot.
+    m_last_values.record_tick(tick);
+    if (!m_subscriptions.has_subscriber(TopicFamily::TICK, tick.symbol_id, tick.symbol)) {
+        m_unsubscribed_skips->add();
+        return;
+    }
+    std::string topic = "TICK." + tick.symbol;
+    std::string payload_str = serialize_tick(tick);
+    if (trace) trace->stamp(LatencyStage::SERIALIZE);
+    send(topic, payload_str);
+    if (trace) trace->stamp(LatencyStage::SEND);
+}
+
+// Worker shards publish concurrently; ZMQ sockets are not thread-safe, so
+// only the send itself is serialized, not the formatting.
+void ScriptingInterface::send(const std::string& topic, const std::string& payload) {
+    std::lock_guard<std::mutex> lock(m_publish_mutex);
+    send_locked(topic, payload);
+}
+
+void ScriptingInterface::send_locked(const std::string& topic, const std::string& payload) {
     m_data_publisher.send(zmq::buffer(topic), zmq::send_flags::sndmore);
-    m_data_publisher.send(zmq::buffer(payload_str), zmq::send_flags::none);
+    m_data_publisher.send(zmq::buffer(payload), zmq::send_flags::none);
+}
+
+void ScriptingInterface::drain_subscriptions() {
+    std::lock_guard<std::mutex> lock(m_publish_mutex);
+    zmq::message_t message;
+    while (m_data_publisher.recv(message, zmq::recv_flags::dontwait)) {
+        std::string_view view = message.to_string_view();
+        if (m_subscriptions.apply(view) && view[0] == 1) {
+            send_snapshot(view.substr(1));
+        }
+    }
+}
+
+// XPUB cannot address one subscriber, so existing subscribers to the same
+// topics see the snapshot too; it is marked so they can tell it from news.
+void ScriptingInterface::send_snapshot(std::string_view prefix) {
+    uint64_t sent = 0;
+    if (may_match(prefix, "TICK.")) {
+        const SymbolTable& symbols = SymbolTable::instance();
+        Tick tick;
+        for (SymbolId id = 1; id <= symbols.size(); ++id) {
+            if (!m_last_values.last_tick(id, tick)) {
+                continue;
+            }
+            std::string topic = "TICK." + tick.symbol;
+            if (starts_with(topic, prefix)) {
+                send_locked(topic, serialize_tick(tick, true));
+                ++sent;
+            }
+        }
+    }
+    if (may_match(prefix, "HISTORY.")) {
+        m_last_values.for_each_bar([&](const Bar& bar) {
+            std::string topic = "HISTORY." + bar.symbol;
+            if (starts_with(topic, prefix)) {
+                send_locked(topic, serialize_bar(bar, true));
+                ++sent;
+            }
+        });
+    }
+    if (may_match(prefix, "EXECUTION.")) {
+        m_last_values.for_each_open_order([&](const std::string& topic, const std::string& payload) {
+            if (starts_with(topic, prefix)) {
+                send_locked(topic, payload);
+                ++sent;
+            }
+        });
+    }
+    if (sent > 0) {
+        m_snapshot_messages->add(sent);
+        spdlog::info("Sent {} snapshot message(s) to a new subscriber to '{}'.", sent, prefix);
+    }
+}
+
+void ScriptingInterface::publish_stats(const std::string& payload) {
+    static const std::string topic = "STATS";
+    send(topic, payload);
+}
+
+void ScriptingInterface::publish_alert(const std::string& payload) {
+    static const std::string topic = "ALERT";
+    send(topic, payload);
+}
+
+void ScriptingInterface::publish_timer(const std::string& strategy_id, const std::string& name, int64_t fired_ns) {
+    std::string topic = "TIMER." + strategy_id;
+    nlohmann::json payload_json;
+    payload_json["name"] = name;
+    payload_json["fired_ns"] = fired_ns;
+    send(topic, payload_json.dump());
+}
+
+void ScriptingInterface::publish_session_event(const SessionEvent& event, int64_t fired_ns) {
+    std::string topic = "SESSION." + event.exchange;
+    nlohmann::json payload_json;
+    payload_json["exchange"] = event.exchange;
+    payload_json["type"] = session_event_type_to_string(event.type);
+    payload_json["event"] = event.name;
+    payload_json["scheduled_ns"] = event.time_ns;
+    payload_json["fired_ns"] = fired_ns;
+    send(topic, payload_json.dump());
+}
+
+void ScriptingInterface::publish_execution_report(const Order& order, const ExecutionReport& report,
+                                                  const StrategyPosition& position) {
+    std::string topic = "EXECUTION." + order.strategy_id + "." + std::to_string(order.order_id);
+    nlohmann::json payload_json;
+    payload_json["timestamp"] = std::to_string(report.execution_timestamp.time_since_epoch().count());
+    auto& data = payload_json["data"];
+    data["order_id"] = order.order_id;
+    data["correlation_id"] = order.correlation_id;
+    data["strategy_id"] = order.strategy_id;
+    data["symbol"] = order.symbol;
+    data["side"] = side_to_string(order.side);
+    data["status"] = status_to_string(order.status);
+    data["quantity"] = quantity_to_json(order.quantity);
+    data["filled_quantity"] = quantity_to_json(order.filled_quantity);
+    data["avg_fill_price"] = order.avg_fill_price.to_double();
+    if (report.type == ReportType::FILL) {
+        data["exec_id"] = report.exec_id;
+        data["fill_quantity"] = quantity_to_json(report.fill_quantity);
+        data["fill_price"] = report.fill_price.to_double();
+    } else {
+        data["fill_quantity"] = quantity_to_json(report.fill_quantity);
+    }
+    data["strategy_position"] = quantity_to_json(position.position);
+    data["strategy_realized_pnl"] = notional_to_double(position.realized_pnl);
+    std::string payload_str = payload_json.dump();
+
+    // Cached before the send, like ticks, so a snapshot is never older than
+    // a report its subscriber missed. A working order is replayed as its
+    // current state rather than its last report, so a fill is never seen twice.
+    const bool open = !is_terminal(order.status);
+    if (open) {
+        data.erase("exec_id");
+        data.erase("fill_price");
+        data["fill_quantity"] = 0;
+        payload_json["snapshot"] = true;
+    }
+    m_last_values.record_order(order.order_id, topic, open ? payload_json.dump() : std::string(), open);
+    send(topic, payload_str);
+}
+
+void ScriptingInterface::publish_connection_state(const ConnectionStatus& status) {
+    static const std::string topic = "CONNECTION";
+    nlohmann::json payload_json;
+    payload_json["state"] = connection_state_to_string(status.state);
+    payload_json["attempt"] = status.attempt;
+    payload_json["downtime_ms"] = status.downtime_ms;
+    payload_json["detail"] = status.detail;
+    std::string payload_str = payload_json.dump();
+    send(topic, payload_str);
 }
 
 // Implement the new publishing method
 void ScriptingInterface::publish_historical_data(const Bar& bar) {
-    std::string topic = "HISTORY." + bar.symbol;
+    m_last_values.record_bar(bar);
+    if (!m_subscriptions.has_subscriber(TopicFamily::HISTORY, SymbolTable::instance().find(bar.symbol), bar.symbol)) {
+        m_unsubscribed_skips->add();
+        return;
+    }
+    send("HISTORY." + bar.symbol, serialize_bar(bar, false));
+}
+
+void ScriptingInterface::publish_history_end(const std::string& symbol) {
+    std::string topic = "HISTORY_END." + symbol;
     nlohmann::json payload_json;
-    payload_json["symbol"] = bar.symbol;
-    payload_json["time"] = bar.time;
-    payload_json["open"] = bar.open;
-    payload_json["high"] = bar.high;
-    payload_json["low"] = bar.low;
-    payload_json["close"] = bar.close;
-    payload_json["volume"] = bar.volume;
+    payload_json["symbol"] = symbol;
+    send(topic, payload_json.dump());
+}
 
-    std::string payload_str = payload_json.dump();
-    m_data_publisher.send(zmq::buffer(topic), zmq::send_flags::sndmore);
-    m_data_publisher.send(zmq::buffer(payload_str), zmq::send_flags::none);
+void ScriptingInterface::publish_pong(const std::string& client_id, uint64_t nonce) {
+    std::string topic = "PONG." + client_id;
+    nlohmann::json payload_json;
+    payload_json["client_id"] = client_id;
+    payload_json["nonce"] = nonce;
+    payload_json["engine_ns"] = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    send(topic, payload_json.dump());
 }
 
 void ScriptingInterface::listen_for_commands() {
+    pthread_setname_np(pthread_self(), "scripting");
     bool is_mock_mode = (m_engine_core.get_mode() == "mock");
 
+    zmq::pollitem_t items[] = {{static_cast<void*>(m_command_subscriber), 0, ZMQ_POLLIN, 0}};
     while (m_is_running) {
+        // The XPUB socket is shared with the publishers, so it is drained
+        // under their lock rather than polled; the timeout bounds how late a
+        // new subscription is seen (and how long stop() waits).
+        drain_subscriptions();
+        zmq::poll(items, 1, std::chrono::milliseconds(10));
+        if (!(items[0].revents & ZMQ_POLLIN)) {
+            continue;
+        }
+
         zmq::message_t topic_msg;
         auto result = m_command_subscriber.recv(topic_msg, zmq::recv_flags::dontwait);
         
         if (!result.has_value()) {
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
             continue;
         }
 
         std::string topic = topic_msg.to_string();
+        FlightRecorder::record_text(FlightKind::COMMAND, topic);
 
         if (is_mock_mode && topic == "MOCK") {
             spdlog::info("Start signal received, beginning data feed");
@@ -92,6 +361,34 @@ void ScriptingInterface::listen_for_commands() {
             continue; 
         }
 
+        if (topic == "PING") {
+            // Answered on the data channel, so a PONG proves both directions are connected.
+            zmq::message_t payload_msg;
+            m_command_subscriber.recv(payload_msg, zmq::recv_flags::none);
+            try {
+                auto payload = nlohmann::json::parse(payload_msg.to_string());
+                publish_pong(payload.at("client_id").get<std::string>(), payload.value("nonce", uint64_t{0}));
+            } catch (const nlohmann::json::exception& e) {
+                spdlog::error("Failed to parse PING: {}", e.what());
+            }
+            continue;
+        }
+
+        if (topic == "DUMP_FLIGHT_RECORDER") {
+            // Payload, if any, is ignored.
+            if (topic_msg.more()) {
+                zmq::message_t payload_msg;
+                m_command_subscriber.recv(payload_msg, zmq::recv_flags::none);
+            }
+            std::string path = FlightRecorder::dump();
+            nlohmann::json alert;
+            alert["type"] = "FLIGHT_RECORDER_DUMP";
+            alert["ok"] = !path.empty();
+            alert["path"] = path;
+            publish_alert(alert.dump());
+            continue;
+        }
+
         if (topic == "REQUEST_HISTORY") {
              zmq::message_t payload_msg;
              auto res = m_command_subscriber.recv(payload_msg, zmq::recv_flags::none);
@@ -121,56 +418,122 @@ void ScriptingInterface::listen_for_commands() {
                  }
              }
         }
-        else if (topic == "SUBSCRIBE") {
+        else if (topic == "SUBSCRIBE" || topic == "UNSUBSCRIBE") {
             zmq::message_t payload_msg;
             m_command_subscriber.recv(payload_msg, zmq::recv_flags::none);
             try {
                 auto payload = nlohmann::json::parse(payload_msg.to_string());
-                std::string data_topic = payload.at("topic");
+                SubscriptionRequest request;
+                request.topic = payload.at("topic").get<std::string>();
+                request.subscriber = payload.value("subscriber", "");
                 Event sub_event;
-                sub_event.type = EventType::SUBSCRIBE_REQUEST;
-                sub_event.data = data_topic;
+                sub_event.type = topic == "SUBSCRIBE" ? EventType::SUBSCRIBE_REQUEST : EventType::UNSUBSCRIBE_REQUEST;
+                sub_event.data = request;
                 m_engine_core.post_event(sub_event);
-                spdlog::info("Received SUBSCRIBE request for topic: {}", data_topic);
+                spdlog::info("Received {} request for topic: {}", topic, request.topic);
             } catch (const std::exception& e) {
-                spdlog::error("Could not parse SUBSCRIBE payload: {}", e.what());
+                spdlog::error("Could not parse {} payload: {}", topic, e.what());
+            }
+        }
+        else if (topic == "CANCEL_ORDER" || topic == "CANCEL_ALL" || topic == "MODIFY_ORDER") {
+            zmq::message_t payload_msg;
+            m_command_subscriber.recv(payload_msg, zmq::recv_flags::none);
+            try {
+                auto json_data = nlohmann::json::parse(payload_msg.to_string());
+                auto payload = json_data.contains("payload") ? json_data["payload"] : json_data;
+                Event order_event;
+                if (topic == "MODIFY_ORDER") {
+                    ModifyRequest request;
+                    request.order_id = payload.at("order_id").get<uint64_t>();
+                    request.strategy_id = payload.value("strategy_id", "");
+                    if (payload.contains("quantity")) {
+                        request.quantity = Quantity::from_double(payload["quantity"].get<double>());
+                    }
+                    if (payload.contains("limit_price")) {
+                        request.price = Price::from_double(payload["limit_price"].get<double>());
+                    }
+                    order_event.type = EventType::MODIFY_ORDER_REQUEST;
+                    order_event.data = request;
+                } else {
+                    CancelRequest request;
+                    request.strategy_id = payload.value("strategy_id", "");
+                    if (topic == "CANCEL_ORDER") {
+                        request.order_id = payload.at("order_id").get<uint64_t>();
+                        order_event.type = EventType::CANCEL_ORDER_REQUEST;
+                    } else {
+                        request.symbol = payload.value("symbol", "");
+                        order_event.type = EventType::CANCEL_ALL_REQUEST;
+                    }
+                    order_event.data = request;
+                }
+                m_engine_core.post_event(order_event);
+                spdlog::info("Posted {} request.", topic);
+            } catch (const nlohmann::json::exception& e) {
+                spdlog::error("Failed to parse {}: {}", topic, e.what());
             }
         }
-        else if (topic == "CREATE_ORDER") {
+        else if (topic == "TIMER") {
+            zmq::message_t payload_msg;
+            m_command_subscriber.recv(payload_msg, zmq::recv_flags::none);
+            try {
+                auto payload = nlohmann::json::parse(payload_msg.to_string());
+                TimerRequest request;
+                request.strategy_id = payload.at("strategy_id").get<std::string>();
+                request.name = payload.at("name").get<std::string>();
+                request.cancel = payload.value("cancel", false);
+                request.interval_ms = payload.value("interval_ms", int64_t{0});
+                request.delay_ms = payload.value("delay_ms", request.interval_ms);
+                if (request.strategy_id.empty() || request.strategy_id.find('.') != std::string::npos ||
+                    request.delay_ms < 0 || request.interval_ms < 0) {
+                    spdlog::error("Rejected TIMER '{}': needs a strategy_id without '.' and non-negative times.",
+                                  request.name);
+                    continue;
+                }
+                Event timer_event;
+                timer_event.type = EventType::TIMER_REQUEST;
+                timer_event.data = request;
+                m_engine_core.post_event(timer_event);
+            } catch (const nlohmann::json::exception& e) {
+                spdlog::error("Failed to parse TIMER: {}", e.what());
+            }
+        }
+        else if (topic == "CREATE_ORDER" || topic == "CREATE_ORDER_BATCH") {
+            LatencyTrace trace;
+            trace.stamp(LatencyStage::INGEST);
             zmq::message_t payload_msg;
             auto payload_result = m_command_subscriber.recv(payload_msg, zmq::recv_flags::none);
             if (!payload_result.has_value()) {
-                spdlog::error("Received CREATE_ORDER topic without a payload.");
+                spdlog::error("Received {} topic without a payload.", topic);
                 continue;
             }
             try {
                 std::string payload_str = payload_msg.to_string();
-                spdlog::debug("Received CREATE_ORDER payload: {}", payload_str);
+                spdlog::debug("Received {} payload: {}", topic, payload_str);
                 auto json_data = nlohmann::json::parse(payload_str);
                 auto payload = json_data.contains("payload") ? json_data["payload"] : json_data;
-
-                Order order;
-                order.symbol = payload["symbol"].get<std::string>();
-                order.quantity = payload["quantity"].get<double>();
-                
-                std::string side_str = payload["side"].get<std::string>();
-                if (side_str == "BUY") order.side = Side::BUY;
-                else if (side_str == "SELL") order.side = Side::SELL;
-                
-                std::string type_str = payload["order_type"].get<std::string>();
-                if (type_str == "MARKET") order.order_type = OrderType::MARKET;
-                else if (type_str == "LIMIT") {
-                    order.order_type = OrderType::LIMIT;
-                    order.price = payload.value("limit_price", 0.0);
+                const std::string correlation_id = json_data.value("correlation_id", "");
+                // A batch is one message, so its orders reach the event loop back to back.
+                std::vector<nlohmann::json> orders;
+                if (topic == "CREATE_ORDER") {
+                    orders.push_back(std::move(payload));
+                } else {
+                    orders = payload.at("orders").get<std::vector<nlohmann::json>>();
+                }
+                for (const auto& order_json : orders) {
+                    Order order;
+                    order.correlation_id = order_json.value("correlation_id", correlation_id);
+                    if (!parse_order(order_json, order)) {
+                        continue;
+                    }
+                    Event order_event;
+                    order_event.type = EventType::ORDER_REQUEST;
+                    order_event.data = order;
+                    order_event.trace = trace;
+                    m_engine_core.post_event(order_event);
+                    spdlog::info("Posted ORDER_REQUEST for {}", order.symbol);
                 }
-
-                Event order_event;
-                order_event.type = EventType::ORDER_REQUEST;
-                order_event.data = order;
-                m_engine_core.post_event(order_event);
-                spdlog::info("Posted ORDER_REQUEST for {}", order.symbol);
             } catch (const nlohmann::json::exception& e) {
-                spdlog::error("Failed to parse CREATE_ORDER: {}", e.what());
+                spdlog::error("Failed to parse {}: {}", topic, e.what());
             }
         }
     }
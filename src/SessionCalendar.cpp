@@ -0,0 +1,257 @@
+#include "SessionCalendar.hpp"
+#include "LogHandler.hpp"
+#include <algorithm>
+#include <cstdio>
+
+namespace TradingEngine {
+
+namespace {
+
+constexpr int64_t kNsPerMinute = 60'000'000'000;
+constexpr int kMinutesPerDay = 24 * 60;
+constexpr int kLookaheadDays = 31;
+
+// 0 = Sunday; 1970-01-01 was a Thursday.
+int weekday(int32_t day) {
+    int wd = (day + 4) % 7;
+    return wd < 0 ? wd + 7 : wd;
+}
+
+int32_t nth_sunday(int year, unsigned month, int n) {
+    int32_t first = SessionCalendar::days_from_civil(year, month, 1);
+    return first + (7 - weekday(first)) % 7 + 7 * (n - 1);
+}
+
+int32_t last_sunday(int year, unsigned month) {
+    int32_t last = SessionCalendar::days_from_civil(month == 12 ? year + 1 : year, month == 12 ? 1 : month + 1, 1) - 1;
+    return last - weekday(last);
+}
+
+// Howard Hinnant's civil_from_days, year only.
+int year_of(int32_t day) {
+    int64_t z = static_cast<int64_t>(day) + 719468;
+    int64_t era = (z >= 0 ? z : z - 146096) / 146097;
+    int64_t doe = z - era * 146097;
+    int64_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    int64_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    int64_t mp = (5 * doy + 2) / 153;
+    int64_t month = mp < 10 ? mp + 3 : mp - 9;
+    return static_cast<int>(yoe + era * 400 + (month <= 2 ? 1 : 0));
+}
+
+}
+
+const char* session_event_type_to_string(SessionEventType type) {
+    switch (type) {
+        case SessionEventType::OPEN:
+            return "OPEN";
+        case SessionEventType::CLOSE:
+            return "CLOSE";
+        case SessionEventType::AUCTION:
+            return "AUCTION";
+        default:
+            return "UNKNOWN";
+    }
+}
+
+int32_t SessionCalendar::days_from_civil(int year, unsigned month, unsigned day) {
+    year -= month <= 2 ? 1 : 0;
+    const int era = (year >= 0 ? year : year - 399) / 400;
+    const unsigned yoe = static_cast<unsigned>(year - era * 400);
+    const unsigned doy = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + static_cast<int32_t>(doe) - 719468;
+}
+
+bool SessionCalendar::parse_date(const std::string& text, int32_t& day) {
+    int year = 0;
+    unsigned month = 0;
+    unsigned dom = 0;
+    if (text.size() != 10 || std::sscanf(text.c_str(), "%4d-%2u-%2u", &year, &month, &dom) != 3 ||
+        month < 1 || month > 12 || dom < 1 || dom > 31) {
+        return false;
+    }
+    day = days_from_civil(year, month, dom);
+    return true;
+}
+
+bool SessionCalendar::parse_time(const std::string& text, int& minute) {
+    int hours = 0;
+    int minutes = 0;
+    if (text.size() != 5 || std::sscanf(text.c_str(), "%2d:%2d", &hours, &minutes) != 2 ||
+        hours < 0 || hours > 23 || minutes < 0 || minutes > 59) {
+        return false;
+    }
+    minute = hours * 60 + minutes;
+    return true;
+}
+
+// Sessions run in daytime, so the switch hour itself never matters; only
+// which side of the transition date the day falls on.
+int SessionCalendar::utc_offset_minutes(const ExchangeSession& session, int32_t day) {
+    bool summer = false;
+    const int year = year_of(day);
+    switch (session.dst) {
+        case DstRule::US:
+            summer = day >= nth_sunday(year, 3, 2) && day < nth_sunday(year, 11, 1);
+            break;
+        case DstRule::EU:
+            summer = day >= last_sunday(year, 3) && day < last_sunday(year, 10);
+            break;
+        case DstRule::NONE:
+            break;
+    }
+    return session.utc_offset_minutes + (summer ? 60 : 0);
+}
+
+bool SessionCalendar::load(const nlohmann::json& sessions) {
+    if (!sessions.is_object()) {
+        return sessions.is_null();
+    }
+    for (const auto& [name, entry] : sessions.items()) {
+        try {
+            ExchangeSession session;
+            session.name = name;
+            session.utc_offset_minutes = entry.value("utc_offset_minutes", 0);
+            std::string dst = entry.value("dst", "none");
+            if (dst == "us") session.dst = DstRule::US;
+            else if (dst == "eu") session.dst = DstRule::EU;
+            else if (dst != "none") {
+                spdlog::error("Session {}: unknown dst rule '{}'.", name, dst);
+                return false;
+            }
+            if (!parse_time(entry.value("open", "09:30"), session.open_minute) ||
+                !parse_time(entry.value("close", "16:00"), session.close_minute) ||
+                session.open_minute >= session.close_minute) {
+                spdlog::error("Session {}: open and close must be HH:MM with open before close.", name);
+                return false;
+            }
+            for (const auto& date : entry.value("holidays", std::vector<std::string>{})) {
+                int32_t day = 0;
+                if (!parse_date(date, day)) {
+                    spdlog::error("Session {}: bad holiday '{}'.", name, date);
+                    return false;
+                }
+                session.holidays.insert(day);
+            }
+            for (const auto& [date, close] : entry.value("early_closes", std::map<std::string, std::string>{})) {
+                int32_t day = 0;
+                int minute = 0;
+                if (!parse_date(date, day) || !parse_time(close, minute)) {
+                    spdlog::error("Session {}: bad early close '{}' -> '{}'.", name, date, close);
+                    return false;
+                }
+                session.early_closes[day] = minute;
+            }
+            if (entry.contains("auctions")) {
+                for (const auto& auction_json : entry.at("auctions")) {
+                    AuctionTime auction;
+                    auction.name = auction_json.at("name").get<std::string>();
+                    auction.relative_to_close = auction_json.value("relative_to", "open") == "close";
+                    auction.offset_minutes = auction_json.value("offset_minutes", 0);
+                    session.auctions.push_back(std::move(auction));
+                }
+            }
+            add_exchange(std::move(session));
+        } catch (const nlohmann::json::exception& e) {
+            spdlog::error("Session {}: {}", name, e.what());
+            return false;
+        }
+    }
+    return true;
+}
+
+void SessionCalendar::add_exchange(ExchangeSession session) {
+    m_exchanges.erase(std::remove_if(m_exchanges.begin(), m_exchanges.end(),
+                                     [&session](const ExchangeSession& existing) { return existing.name == session.name; }),
+                      m_exchanges.end());
+    m_exchanges.push_back(std::move(session));
+}
+
+std::vector<std::string> SessionCalendar::exchanges() const {
+    std::vector<std::string> names;
+    for (const auto& session : m_exchanges) {
+        names.push_back(session.name);
+    }
+    return names;
+}
+
+const ExchangeSession* SessionCalendar::find(const std::string& exchange) const {
+    for (const auto& session : m_exchanges) {
+        if (session.name == exchange) {
+            return &session;
+        }
+    }
+    return nullptr;
+}
+
+int32_t SessionCalendar::local_day(const ExchangeSession& session, int64_t utc_ns) {
+    int64_t minutes = utc_ns / kNsPerMinute + session.utc_offset_minutes;
+    int64_t day = minutes / kMinutesPerDay;
+    if (minutes % kMinutesPerDay < 0) {
+        --day;
+    }
+    return static_cast<int32_t>(day);
+}
+
+std::vector<SessionEvent> SessionCalendar::events_on(const ExchangeSession& session, int32_t day) const {
+    std::vector<SessionEvent> events;
+    const int wd = weekday(day);
+    if (wd == 0 || wd == 6 || session.holidays.count(day)) {
+        return events;
+    }
+    auto early = session.early_closes.find(day);
+    const int close_minute = early != session.early_closes.end() ? early->second : session.close_minute;
+    const int64_t midnight_utc_minutes = static_cast<int64_t>(day) * kMinutesPerDay - utc_offset_minutes(session, day);
+    auto at = [&](int minute) { return (midnight_utc_minutes + minute) * kNsPerMinute; };
+
+    events.push_back({session.name, SessionEventType::OPEN, "OPEN", at(session.open_minute)});
+    for (const auto& auction : session.auctions) {
+        int minute = (auction.relative_to_close ? close_minute : session.open_minute) + auction.offset_minutes;
+        events.push_back({session.name, SessionEventType::AUCTION, auction.name, at(minute)});
+    }
+    events.push_back({session.name, SessionEventType::CLOSE, "CLOSE", at(close_minute)});
+    std::stable_sort(events.begin(), events.end(),
+                     [](const SessionEvent& a, const SessionEvent& b) { return a.time_ns < b.time_ns; });
+    return events;
+}
+
+std::vector<SessionEvent> SessionCalendar::day_events(const std::string& exchange, int32_t day) const {
+    const ExchangeSession* session = find(exchange);
+    return session ? events_on(*session, day) : std::vector<SessionEvent>{};
+}
+
+bool SessionCalendar::is_open(const std::string& exchange, int64_t utc_ns) const {
+    const ExchangeSession* session = find(exchange);
+    if (!session) {
+        return false;
+    }
+    int64_t open_ns = -1;
+    for (const auto& event : events_on(*session, local_day(*session, utc_ns))) {
+        if (event.type == SessionEventType::OPEN) {
+            open_ns = event.time_ns;
+        } else if (event.type == SessionEventType::CLOSE) {
+            return open_ns >= 0 && utc_ns >= open_ns && utc_ns < event.time_ns;
+        }
+    }
+    return false;
+}
+
+std::optional<SessionEvent> SessionCalendar::next_event(const std::string& exchange, int64_t after_ns) const {
+    const ExchangeSession* session = find(exchange);
+    if (!session) {
+        return std::nullopt;
+    }
+    // Start a day early: in summer time the local date can lag the standard-time one.
+    int32_t first_day = local_day(*session, after_ns) - 1;
+    for (int32_t day = first_day; day <= first_day + kLookaheadDays; ++day) {
+        for (auto& event : events_on(*session, day)) {
+            if (event.time_ns > after_ns) {
+                return event;
+            }
+        }
+    }
+    return std::nullopt;
+}
+
+}
@@ -0,0 +1,233 @@
+#include "Stats.hpp"
+#include "LogHandler.hpp"
+#include <nlohmann/json.hpp>
+
+namespace TradingEngine {
+
+namespace {
+
+const char* path_name(size_t path) {
+    switch (static_cast<LatencyPath>(path)) {
+        case LatencyPath::TICK:
+            return "tick";
+        case LatencyPath::ORDER:
+            return "order";
+        default:
+            return "unknown";
+    }
+}
+
+// Segment i measures stage i-1 -> stage i; segment 0 is reused for the total.
+const char* segment_name(size_t segment) {
+    static const char* names[] = {
+        "total",
+        "ingest_to_enqueue",
+        "enqueue_to_dequeue",
+        "dequeue_to_handle",
+        "handle_to_serialize",
+        "serialize_to_send"
+    };
+    return segment < std::size(names) ? names[segment] : "unknown";
+}
+
+nlohmann::json histogram_to_json(const LatencyHistogram::Snapshot& snap) {
+    nlohmann::json out;
+    out["count"] = snap.count;
+    out["mean"] = snap.mean();
+    out["min"] = snap.count ? snap.min : 0;
+    out["p50"] = snap.percentile(50.0);
+    out["p90"] = snap.percentile(90.0);
+    out["p99"] = snap.percentile(99.0);
+    out["p999"] = snap.percentile(99.9);
+    out["max"] = snap.max;
+    return out;
+}
+
+}
+
+void LatencyHistogram::Snapshot::merge(const Snapshot& other) {
+    for (size_t i = 0; i < counts.size(); ++i) {
+        counts[i] += other.counts[i];
+    }
+    count += other.count;
+    sum += other.sum;
+    min = std::min(min, other.min);
+    max = std::max(max, other.max);
+}
+
+uint64_t LatencyHistogram::Snapshot::percentile(double pct) const {
+    if (count == 0) {
+        return 0;
+    }
+    uint64_t target = static_cast<uint64_t>(pct / 100.0 * static_cast<double>(count) + 0.5);
+    if (target == 0) target = 1;
+    uint64_t seen = 0;
+    for (int i = 0; i < kBucketCount; ++i) {
+        seen += counts[i];
+        if (seen >= target) {
+            return std::min(bucket_upper_bound(i), max);
+        }
+    }
+    return max;
+}
+
+uint64_t LatencyHistogram::bucket_upper_bound(int index) {
+    if (index < kSubBuckets) {
+        return static_cast<uint64_t>(index);
+    }
+    int shift = (index - kSubBuckets) / kSubBuckets;
+    uint64_t sub = static_cast<uint64_t>((index - kSubBuckets) % kSubBuckets) + kSubBuckets;
+    uint64_t lower = sub << shift;
+    return lower + ((uint64_t{1} << shift) - 1);
+}
+
+LatencyHistogram::Snapshot LatencyHistogram::snapshot() const {
+    Snapshot snap;
+    for (int i = 0; i < kBucketCount; ++i) {
+        snap.counts[i] = m_counts[i].load(std::memory_order_relaxed);
+    }
+    snap.count = m_count.load(std::memory_order_relaxed);
+    snap.sum = m_sum.load(std::memory_order_relaxed);
+    snap.min = m_min.load(std::memory_order_relaxed);
+    snap.max = m_max.load(std::memory_order_relaxed);
+    return snap;
+}
+
+StatsRegistry& StatsRegistry::instance() {
+    static StatsRegistry registry;
+    return registry;
+}
+
+Counter& StatsRegistry::counter(const std::string& name) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto& entry : m_counters) {
+        if (entry.name == name) return entry.value;
+    }
+    auto& entry = m_counters.emplace_back();
+    entry.name = name;
+    return entry.value;
+}
+
+Gauge& StatsRegistry::gauge(const std::string& name) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto& entry : m_gauges) {
+        if (entry.name == name) return entry.value;
+    }
+    auto& entry = m_gauges.emplace_back();
+    entry.name = name;
+    return entry.value;
+}
+
+LatencyHistogram& StatsRegistry::histogram(const std::string& name) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto& entry : m_histograms) {
+        if (entry.name == name) return entry.value;
+    }
+    auto& entry = m_histograms.emplace_back();
+    entry.name = name;
+    return entry.value;
+}
+
+StatsRegistry::ThreadHistograms& StatsRegistry::thread_histograms() {
+    thread_local ThreadHistograms* tls = nullptr;
+    if (!tls) {
+        auto owned = std::make_unique<ThreadHistograms>();
+        tls = owned.get();
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_thread_histograms.push_back(std::move(owned));
+    }
+    return *tls;
+}
+
+void StatsRegistry::record_trace(LatencyPath path, const LatencyTrace& trace) {
+#ifndef ENGINE_NO_LATENCY_STATS
+    if (!trace.complete()) {
+        return;
+    }
+    auto& segments = thread_histograms().segments[static_cast<size_t>(path)];
+    const auto& t = trace.stamps;
+    for (size_t i = 1; i < kLatencyStageCount; ++i) {
+        if (t[i] != 0 && t[i - 1] != 0 && t[i] >= t[i - 1]) {
+            segments[i].record(t[i] - t[i - 1]);
+        }
+    }
+    if (t.back() >= t.front()) {
+        segments[0].record(t.back() - t.front());
+    }
+#endif
+}
+
+LatencyHistogram::Snapshot StatsRegistry::merged_segment(size_t path, size_t segment) {
+    LatencyHistogram::Snapshot merged;
+    for (const auto& thread : m_thread_histograms) {
+        merged.merge(thread->segments[path][segment].snapshot());
+    }
+    return merged;
+}
+
+nlohmann::json StatsRegistry::snapshot() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    nlohmann::json out;
+
+    uint64_t now = monotonic_ns();
+    double elapsed_s = m_last_snapshot_ns ? static_cast<double>(now - m_last_snapshot_ns) / 1e9 : 0.0;
+    m_last_snapshot_ns = now;
+
+    for (size_t path = 0; path < kLatencyPathCount; ++path) {
+        for (size_t segment = 0; segment < kSegmentCount; ++segment) {
+            auto merged = merged_segment(path, segment);
+            if (merged.count > 0) {
+                out["latency_ns"][path_name(path)][segment_name(segment)] = histogram_to_json(merged);
+            }
+        }
+    }
+
+    m_last_counter_values.resize(m_counters.size(), 0);
+    size_t idx = 0;
+    for (const auto& entry : m_counters) {
+        uint64_t value = entry.value.value();
+        uint64_t delta = value - m_last_counter_values[idx];
+        m_last_counter_values[idx++] = value;
+        out["counters"][entry.name]["count"] = value;
+        out["counters"][entry.name]["rate_per_sec"] = elapsed_s > 0 ? delta / elapsed_s : 0.0;
+    }
+    for (const auto& entry : m_gauges) {
+        out["gauges"][entry.name] = entry.value.value();
+    }
+    for (const auto& entry : m_histograms) {
+        auto snap = entry.value.snapshot();
+        if (snap.count > 0) {
+            out["histograms"][entry.name] = histogram_to_json(snap);
+        }
+    }
+    out["threads"] = m_thread_histograms.size();
+    return out;
+}
+
+void StatsRegistry::log_summary() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (size_t path = 0; path < kLatencyPathCount; ++path) {
+        for (size_t segment = 0; segment < kSegmentCount; ++segment) {
+            auto merged = merged_segment(path, segment);
+            if (merged.count == 0) continue;
+            spdlog::info("Latency {}.{}: n={} p50={}ns p99={}ns p99.9={}ns max={}ns",
+                         path_name(path), segment_name(segment), merged.count,
+                         merged.percentile(50.0), merged.percentile(99.0),
+                         merged.percentile(99.9), merged.max);
+        }
+    }
+    for (const auto& entry : m_counters) {
+        spdlog::info("Counter {}: {}", entry.name, entry.value.value());
+    }
+    for (const auto& entry : m_gauges) {
+        spdlog::info("Gauge {}: {}", entry.name, entry.value.value());
+    }
+    for (const auto& entry : m_histograms) {
+        auto snap = entry.value.snapshot();
+        if (snap.count == 0) continue;
+        spdlog::info("Histogram {}: n={} p50={} p99={} max={}", entry.name, snap.count,
+                     snap.percentile(50.0), snap.percentile(99.0), snap.max);
+    }
+}
+
+}
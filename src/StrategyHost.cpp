@@ -0,0 +1,161 @@
+#include "StrategyHost.hpp"
+#include "LogHandler.hpp"
+#include <algorithm>
+#include <dlfcn.h>
+#include <exception>
+
+namespace TradingEngine {
+
+namespace {
+
+template <typename Fn>
+Fn lookup(void* handle, const char* name) {
+    return reinterpret_cast<Fn>(dlsym(handle, name));
+}
+
+}
+
+StrategyHost::~StrategyHost() {
+    stop();
+    // Strategies first: their code lives in the libraries.
+    for (auto& plugin : m_plugins) {
+        plugin->destroy(plugin->strategy);
+        plugin->strategy = nullptr;
+    }
+    for (auto& plugin : m_plugins) {
+        dlclose(plugin->handle);
+    }
+}
+
+bool StrategyHost::load(const StrategyPluginConfig& config, std::unique_ptr<StrategyContext> context) {
+    if (m_started) {
+        spdlog::error("Strategy plugin {} not loaded: plugins must be loaded before the engine starts.", config.id);
+        return false;
+    }
+    if (config.id.empty() || config.id.find('.') != std::string::npos || m_by_strategy_id.count(config.id)) {
+        spdlog::error("Strategy plugin id '{}' must be unique, non-empty and free of '.'.", config.id);
+        return false;
+    }
+    // RTLD_LOCAL keeps two plugins' symbols from resolving to each other.
+    void* handle = dlopen(config.library.c_str(), RTLD_NOW | RTLD_LOCAL);
+    if (!handle) {
+        spdlog::error("Cannot load strategy plugin {}: {}", config.id, dlerror());
+        return false;
+    }
+    auto api_version = lookup<StrategyApiVersionFn>(handle, "te_strategy_api_version");
+    auto create = lookup<CreateStrategyFn>(handle, "te_create_strategy");
+    auto destroy = lookup<DestroyStrategyFn>(handle, "te_destroy_strategy");
+    if (!api_version || !create || !destroy) {
+        spdlog::error("{} is not a strategy plugin (no TE_STRATEGY_PLUGIN exports).", config.library);
+        dlclose(handle);
+        return false;
+    }
+    if (api_version() != kStrategyApiVersion) {
+        spdlog::error("Strategy plugin {} was built for API version {}, the engine is at {}. Rebuild it.", config.id,
+                      api_version(), kStrategyApiVersion);
+        dlclose(handle);
+        return false;
+    }
+    Strategy* strategy = nullptr;
+    try {
+        strategy = create(config.params.c_str());
+    } catch (const std::exception& e) {
+        spdlog::error("Strategy plugin {} failed to start: {}", config.id, e.what());
+    }
+    if (!strategy) {
+        dlclose(handle);
+        return false;
+    }
+
+    auto plugin = std::make_unique<Plugin>();
+    plugin->config = config;
+    plugin->handle = handle;
+    plugin->strategy = strategy;
+    plugin->destroy = destroy;
+    plugin->context = std::move(context);
+    for (const auto& symbol : config.symbols) {
+        SymbolId id = SymbolTable::instance().intern(symbol);
+        if (id == kInvalidSymbolId) {
+            spdlog::warn("Symbol table full; strategy plugin {} will not see {}.", config.id, symbol);
+            continue;
+        }
+        if (id >= m_by_symbol.size()) {
+            m_by_symbol.resize(id + 1);
+        }
+        auto& plugins = m_by_symbol[id];
+        if (std::find(plugins.begin(), plugins.end(), plugin.get()) == plugins.end()) {
+            plugins.push_back(plugin.get());
+        }
+    }
+    m_by_strategy_id[config.id] = plugin.get();
+    m_plugins.push_back(std::move(plugin));
+    spdlog::info("Loaded strategy plugin {} from {} for {} symbol(s).", config.id, config.library,
+                 config.symbols.size());
+    return true;
+}
+
+std::vector<std::string> StrategyHost::symbols() const {
+    std::vector<std::string> symbols;
+    for (const auto& plugin : m_plugins) {
+        for (const auto& symbol : plugin->config.symbols) {
+            if (std::find(symbols.begin(), symbols.end(), symbol) == symbols.end()) {
+                symbols.push_back(symbol);
+            }
+        }
+    }
+    return symbols;
+}
+
+void StrategyHost::start() {
+    if (m_started) {
+        return;
+    }
+    m_started = true;
+    for (auto& plugin : m_plugins) {
+        StrategyContext& context = *plugin->context;
+        dispatch(*plugin, "on_start", [&context](Strategy& strategy) { strategy.on_start(context); });
+    }
+}
+
+void StrategyHost::stop() {
+    if (!m_started) {
+        return;
+    }
+    m_started = false;
+    for (auto& plugin : m_plugins) {
+        dispatch(*plugin, "on_stop", [](Strategy& strategy) { strategy.on_stop(); });
+    }
+}
+
+void StrategyHost::on_bar(const Bar& bar) {
+    SymbolId id = SymbolTable::instance().find(bar.symbol);
+    if (id < m_by_symbol.size()) {
+        for (Plugin* plugin : m_by_symbol[id]) {
+            dispatch(*plugin, "on_bar", [&bar](Strategy& strategy) { strategy.on_bar(bar); });
+        }
+    }
+}
+
+void StrategyHost::on_order_update(const Order& order, const ExecutionReport& report) {
+    auto it = m_by_strategy_id.find(order.strategy_id);
+    if (it != m_by_strategy_id.end()) {
+        dispatch(*it->second, "on_order_update",
+                 [&order, &report](Strategy& strategy) { strategy.on_order_update(order, report); });
+    }
+}
+
+bool StrategyHost::enabled(const std::string& strategy_id) const {
+    auto it = m_by_strategy_id.find(strategy_id);
+    return it != m_by_strategy_id.end() && !it->second->disabled.load(std::memory_order_relaxed);
+}
+
+void StrategyHost::disable(Plugin& plugin, const char* callback, const char* what) {
+    // Two shard threads may both catch a throw from the same plugin; log once.
+    if (plugin.disabled.exchange(true)) {
+        return;
+    }
+    spdlog::error("Strategy plugin {} threw from {}: {}. Disabled; its open orders are left working.",
+                  plugin.config.id, callback, what);
+}
+
+}
@@ -0,0 +1,98 @@
+#include "SubscriptionManager.hpp"
+#include "LogHandler.hpp"
+
+namespace TradingEngine {
+
+SubscriptionManager::Change SubscriptionManager::subscribe(const std::string& symbol, const std::string& data_type,
+                                                           const std::string& subscriber) {
+    auto it = m_streams.find(key(symbol, data_type));
+    if (it == m_streams.end()) {
+        if (m_streams.size() >= m_line_limit) {
+            spdlog::error("Market data line limit ({}) reached; rejecting {}.{}", m_line_limit, data_type, symbol);
+            return Change::LINE_LIMIT_REACHED;
+        }
+        Stream stream;
+        stream.symbol = symbol;
+        stream.data_type = data_type;
+        stream.references[subscriber] = 1;
+        m_streams.emplace(key(symbol, data_type), std::move(stream));
+        if (m_streams.size() * 10 >= m_line_limit * 9) {
+            spdlog::warn("Market data lines at {} of {}", m_streams.size(), m_line_limit);
+        }
+        return Change::FIRST_SUBSCRIBER;
+    }
+    size_t& count = it->second.references[subscriber];
+    if (subscriber.empty() || count == 0) {
+        ++count;
+    }
+    return Change::NONE;
+}
+
+SubscriptionManager::Change SubscriptionManager::unsubscribe(const std::string& symbol, const std::string& data_type,
+                                                             const std::string& subscriber) {
+    auto it = m_streams.find(key(symbol, data_type));
+    if (it == m_streams.end()) {
+        return Change::NOT_SUBSCRIBED;
+    }
+    auto& references = it->second.references;
+    auto ref = references.find(subscriber);
+    if (ref == references.end()) {
+        return Change::NOT_SUBSCRIBED;
+    }
+    if (--ref->second == 0) {
+        references.erase(ref);
+    }
+    if (!references.empty()) {
+        return Change::NONE;
+    }
+    m_streams.erase(it);
+    return Change::LAST_UNSUBSCRIBED;
+}
+
+std::vector<std::string> SubscriptionManager::drop_stream(const std::string& symbol, const std::string& data_type) {
+    std::vector<std::string> subscribers;
+    auto it = m_streams.find(key(symbol, data_type));
+    if (it == m_streams.end()) {
+        return subscribers;
+    }
+    for (const auto& [subscriber, count] : it->second.references) {
+        subscribers.push_back(subscriber);
+    }
+    m_streams.erase(it);
+    return subscribers;
+}
+
+void SubscriptionManager::bind_request(const std::string& symbol, const std::string& data_type, long request_id) {
+    auto it = m_streams.find(key(symbol, data_type));
+    if (it != m_streams.end()) {
+        it->second.request_id = request_id;
+    }
+}
+
+long SubscriptionManager::request_id(const std::string& symbol, const std::string& data_type) const {
+    auto it = m_streams.find(key(symbol, data_type));
+    return it != m_streams.end() ? it->second.request_id : kNoRequest;
+}
+
+size_t SubscriptionManager::subscriber_count(const std::string& symbol, const std::string& data_type) const {
+    auto it = m_streams.find(key(symbol, data_type));
+    if (it == m_streams.end()) {
+        return 0;
+    }
+    size_t total = 0;
+    for (const auto& [subscriber, count] : it->second.references) {
+        total += count;
+    }
+    return total;
+}
+
+std::vector<std::pair<std::string, std::string>> SubscriptionManager::active_streams() const {
+    std::vector<std::pair<std::string, std::string>> streams;
+    streams.reserve(m_streams.size());
+    for (const auto& [k, stream] : m_streams) {
+        streams.emplace_back(stream.symbol, stream.data_type);
+    }
+    return streams;
+}
+
+}
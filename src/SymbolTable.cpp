@@ -0,0 +1,44 @@
+#include "SymbolTable.hpp"
+#include "LogHandler.hpp"
+
+namespace TradingEngine {
+
+SymbolTable::SymbolTable() : m_names(std::make_unique<std::string[]>(kMaxSymbols + 1)) {}
+
+SymbolTable& SymbolTable::instance() {
+    static SymbolTable table;
+    return table;
+}
+
+SymbolId SymbolTable::intern(std::string_view symbol) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_ids.find(std::string(symbol));
+    if (it != m_ids.end()) {
+        return it->second;
+    }
+    size_t count = m_size.load(std::memory_order_relaxed);
+    if (count >= kMaxSymbols) {
+        spdlog::error("Symbol table is full ({} symbols); cannot intern {}", kMaxSymbols, symbol);
+        return kInvalidSymbolId;
+    }
+    SymbolId id = static_cast<SymbolId>(count + 1);
+    m_names[id] = std::string(symbol);
+    m_ids.emplace(m_names[id], id);
+    m_size.store(count + 1, std::memory_order_release);
+    return id;
+}
+
+SymbolId SymbolTable::find(std::string_view symbol) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_ids.find(std::string(symbol));
+    return it != m_ids.end() ? it->second : kInvalidSymbolId;
+}
+
+const std::string& SymbolTable::name(SymbolId id) const {
+    if (id == kInvalidSymbolId || id > size()) {
+        return m_names[kInvalidSymbolId];
+    }
+    return m_names[id];
+}
+
+}
@@ -0,0 +1,196 @@
+#include "TimerWheel.hpp"
+#include <algorithm>
+#include <utility>
+
+namespace TradingEngine {
+
+TimerWheel::TimerWheel(uint64_t now_ns, uint64_t tick_ns)
+    : m_tick_ns(tick_ns == 0 ? 1 : tick_ns), m_current(now_ns / m_tick_ns), m_nodes(kHeadCount) {
+    for (uint32_t head = 0; head < kHeadCount; ++head) {
+        m_nodes[head].prev = head;
+        m_nodes[head].next = head;
+    }
+}
+
+TimerId TimerWheel::make_id(uint32_t index) const {
+    return (static_cast<uint64_t>(m_nodes[index].generation) << 32) | index;
+}
+
+uint32_t TimerWheel::node_index(TimerId id) const {
+    uint32_t index = static_cast<uint32_t>(id);
+    if (index < kHeadCount || index >= m_nodes.size()) {
+        return kNone;
+    }
+    const Node& node = m_nodes[index];
+    if (!node.active || node.generation != static_cast<uint32_t>(id >> 32)) {
+        return kNone;
+    }
+    return index;
+}
+
+uint32_t TimerWheel::allocate() {
+    if (!m_free.empty()) {
+        uint32_t index = m_free.back();
+        m_free.pop_back();
+        return index;
+    }
+    m_nodes.emplace_back();
+    return static_cast<uint32_t>(m_nodes.size() - 1);
+}
+
+void TimerWheel::release(uint32_t index) {
+    Node& node = m_nodes[index];
+    node.active = false;
+    node.callback = nullptr;
+    ++node.generation;  // stale ids stop matching
+    m_free.push_back(index);
+    --m_active;
+}
+
+// Files the node under the level whose span covers its distance from now
+// (expires >= m_current; equal only while cascading, before the tick fires). A
+// timer beyond the top level is parked in the last slot it can reach and
+// refiled when that slot cascades.
+void TimerWheel::link(uint32_t index) {
+    Node& node = m_nodes[index];
+    uint64_t slot_tick = node.expires;
+    uint64_t delta = slot_tick - m_current;
+    size_t level = 0;
+    while (level + 1 < kLevels && delta >= (uint64_t{1} << ((level + 1) * kSlotBits))) {
+        ++level;
+    }
+    const uint64_t horizon = uint64_t{1} << (kLevels * kSlotBits);
+    if (delta >= horizon) {
+        slot_tick = m_current + horizon - 1;
+    }
+    uint32_t head = static_cast<uint32_t>(level * kSlots + ((slot_tick >> (level * kSlotBits)) & kSlotMask));
+    node.next = head;
+    node.prev = m_nodes[head].prev;
+    m_nodes[node.prev].next = index;
+    m_nodes[head].prev = index;
+}
+
+void TimerWheel::unlink(uint32_t index) {
+    Node& node = m_nodes[index];
+    m_nodes[node.prev].next = node.next;
+    m_nodes[node.next].prev = node.prev;
+    node.prev = node.next = kNone;
+}
+
+TimerId TimerWheel::schedule_at(uint64_t deadline_ns, Callback callback, uint64_t period_ns) {
+    uint32_t index = allocate();
+    Node& node = m_nodes[index];
+    node.active = true;
+    node.expires = (deadline_ns + m_tick_ns - 1) / m_tick_ns;
+    if (node.expires <= m_current) {
+        node.expires = m_current + 1;  // this tick has already been processed
+    }
+    node.period = period_ns == 0 ? 0 : (period_ns + m_tick_ns - 1) / m_tick_ns;
+    node.callback = std::move(callback);
+    ++m_active;
+    link(index);
+    return make_id(index);
+}
+
+bool TimerWheel::cancel(TimerId id) {
+    uint32_t index = node_index(id);
+    if (index == kNone) {
+        return false;
+    }
+    unlink(index);
+    release(index);
+    return true;
+}
+
+// Moves a higher-level slot's timers down now that they are within its span.
+void TimerWheel::cascade(size_t level) {
+    uint32_t head = static_cast<uint32_t>(level * kSlots + ((m_current >> (level * kSlotBits)) & kSlotMask));
+    while (!slot_empty(head)) {
+        uint32_t index = m_nodes[head].next;
+        unlink(index);
+        link(index);
+    }
+}
+
+size_t TimerWheel::fire_slot(uint32_t head, uint64_t target) {
+    size_t fired = 0;
+    while (!slot_empty(head)) {
+        uint32_t index = m_nodes[head].next;
+        unlink(index);
+        TimerId id = make_id(index);
+        // Taken out of the node: the callback may cancel its own timer, and
+        // scheduling may grow m_nodes.
+        Callback callback = std::move(m_nodes[index].callback);
+        if (m_nodes[index].period == 0) {
+            release(index);
+        } else {
+            Node& node = m_nodes[index];
+            node.expires += node.period;
+            if (node.expires <= target) {
+                // Fell behind (a stalled loop): skip the missed firings,
+                // staying on the original schedule.
+                node.expires += ((target - node.expires) / node.period + 1) * node.period;
+            }
+            link(index);
+        }
+        callback(id);
+        ++fired;
+        if (node_index(id) == index) {
+            m_nodes[index].callback = std::move(callback);
+        }
+    }
+    return fired;
+}
+
+// First tick after m_current at which a timer fires or a non-empty slot
+// cascades. Empty ticks and empty cascades in between can be skipped.
+uint64_t TimerWheel::next_tick() const {
+    uint64_t best = UINT64_MAX;
+    for (size_t level = 0; level < kLevels; ++level) {
+        const size_t shift = level * kSlotBits;
+        const uint64_t block = m_current >> shift;
+        if (best <= (block + 1) << shift) {
+            break;  // nothing at this level or above can come sooner
+        }
+        for (uint64_t next = block + 1; next <= block + kSlots; ++next) {
+            if (!slot_empty(static_cast<uint32_t>(level * kSlots + (next & kSlotMask)))) {
+                best = std::min(best, next << shift);
+                break;
+            }
+        }
+    }
+    return best;
+}
+
+size_t TimerWheel::advance(uint64_t now_ns) {
+    const uint64_t target = now_ns / m_tick_ns;
+    size_t fired = 0;
+    while (m_active > 0) {
+        uint64_t next = next_tick();
+        if (next > target) {
+            break;
+        }
+        m_current = next;
+        for (size_t level = kLevels - 1; level > 0; --level) {
+            if ((m_current & ((uint64_t{1} << (level * kSlotBits)) - 1)) == 0) {
+                cascade(level);
+            }
+        }
+        fired += fire_slot(static_cast<uint32_t>(m_current & kSlotMask), target);
+    }
+    if (m_current < target) {
+        m_current = target;
+    }
+    return fired;
+}
+
+uint64_t TimerWheel::ns_until_next(uint64_t now_ns) const {
+    uint64_t tick = next_tick();
+    if (tick == UINT64_MAX) {
+        return UINT64_MAX;
+    }
+    uint64_t due_ns = tick * m_tick_ns;
+    return due_ns > now_ns ? due_ns - now_ns : 0;
+}
+
+}
@@ -0,0 +1,55 @@
+#include "TopicSubscriptions.hpp"
+
+namespace TradingEngine {
+
+TopicSubscriptions::TopicSubscriptions()
+    : m_cache(new std::atomic<uint64_t>[static_cast<size_t>(TopicFamily::COUNT) * SymbolTable::kMaxSymbols]()) {}
+
+bool TopicSubscriptions::apply(std::string_view message) {
+    if (message.empty() || (message[0] != 0 && message[0] != 1)) {
+        return false;
+    }
+    const bool subscribe = message[0] == 1;
+    std::string prefix(message.substr(1));
+    int count = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_counts.find(prefix);
+        if (subscribe) {
+            count = ++m_counts[prefix];
+        } else if (it == m_counts.end()) {
+            return false;
+        } else if ((count = --it->second) == 0) {
+            m_counts.erase(it);
+        }
+        m_generation.fetch_add(1, std::memory_order_acq_rel);
+    }
+    if (m_listener) {
+        m_listener(prefix, count);
+    }
+    return true;
+}
+
+bool TopicSubscriptions::has_subscriber(std::string_view topic) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (size_t length = 0; length <= topic.size(); ++length) {
+        if (m_counts.find(topic.substr(0, length)) != m_counts.end()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+int TopicSubscriptions::subscriber_count(const std::string& prefix) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_counts.find(prefix);
+    return it != m_counts.end() ? it->second : 0;
+}
+
+bool TopicSubscriptions::lookup(TopicFamily family, std::string_view symbol) const {
+    std::string topic(topic_family_prefix(family));
+    topic.append(symbol.data(), symbol.size());
+    return has_subscriber(topic);
+}
+
+}
@@ -1,38 +1,109 @@
 #include "LogHandler.hpp"
-#include "TimeUtils.hpp"
+#include "BinaryLog.hpp"
+#include "FlightRecorder.hpp"
 #include "ConfigHandler.hpp"
+#include "ContractCache.hpp"
+#include "FixedPoint.hpp"
 #include "EngineCore.hpp"
 #include "OrderManager.hpp"
+#include "OrderJournal.hpp"
 #include "IBKRExecutionHandler.hpp"
 #include "IBKRGatewayClient.hpp"
 #include "MockMarketDataHandler.hpp"
 #include "I_MarketDataHandler.hpp"
+#include <algorithm>
+#include <array>
 #include <csignal>
 #include <memory>
+#include <vector>
 
 using namespace TradingEngine;
 
 std::unique_ptr<EngineCore> g_engine_core_ptr = nullptr;
 
 void signal_handler(int signal) {
+    FlightRecorder::dump_from_signal(signal);
     if (g_engine_core_ptr) {
         g_engine_core_ptr->stop();
     }
 }
 
 int main(int argc, char* argv[]) {
-    LogHandler::initialize();
     if (!ConfigHandler::initialize()) {
         return 1;
     }
+    LogHandler::initialize(ConfigHandler::get_log_file_path(), ConfigHandler::get_log_mode() == "async",
+                           static_cast<size_t>(ConfigHandler::get_log_queue_size()));
+    std::string binary_log_path = ConfigHandler::get_binary_log_path();
+    if (!binary_log_path.empty()) {
+        BinaryLog::open(binary_log_path);
+    }
+    std::string flight_recorder_directory = ConfigHandler::get_flight_recorder_directory();
+    if (!flight_recorder_directory.empty() &&
+        FlightRecorder::enable(flight_recorder_directory,
+                               static_cast<size_t>(ConfigHandler::get_flight_recorder_records_per_thread()))) {
+        FlightRecorder::install_crash_handlers();
+    }
     std::signal(SIGINT, signal_handler);
     spdlog::info("--- Trading Engine Starting ---");
     auto order_manager = std::make_unique<OrderManager>();
     g_engine_core_ptr = std::make_unique<EngineCore>(*order_manager, ConfigHandler::get_scripting_publish_endpoint(), ConfigHandler::get_scripting_subscribe_endpoint());
+    size_t worker_shards = static_cast<size_t>(std::max(1, ConfigHandler::get_worker_shards()));
+    g_engine_core_ptr->set_worker_count(worker_shards);
+    g_engine_core_ptr->set_lane_starvation_limit(static_cast<size_t>(std::max(0, ConfigHandler::get_lane_starvation_limit())));
+    std::array<LaneConfig, kEventLaneCount> queue_config;
+    const std::array<std::pair<int, const char*>, kEventLaneCount> queue_defaults{{
+        {16384, "block"}, {16384, "conflate"}, {4096, "block"}}};
+    for (size_t lane = 0; lane < kEventLaneCount; ++lane) {
+        std::string name = event_lane_to_string(static_cast<EventLane>(lane));
+        queue_config[lane].capacity = static_cast<size_t>(
+            std::max(1, ConfigHandler::get_event_queue_capacity(name, queue_defaults[lane].first)));
+        std::string policy = ConfigHandler::get_event_queue_policy(name, queue_defaults[lane].second);
+        if (!overflow_policy_from_string(policy, queue_config[lane].policy)) {
+            spdlog::error("Unknown overflow policy '{}' for the {} lane; using block.", policy, name);
+        }
+    }
+    g_engine_core_ptr->set_event_queue_config(queue_config);
+    SessionCalendar calendar;
+    if (!calendar.load(ConfigHandler::get_sessions())) {
+        spdlog::critical("Invalid sessions config.");
+        return 1;
+    }
+    g_engine_core_ptr->set_session_calendar(std::move(calendar));
+    // Recover before any event can touch the order managers. Each shard keeps
+    // its own journal, so the shard count must not change between runs.
+    std::vector<std::unique_ptr<OrderJournal>> order_journals;
+    std::string journal_directory = ConfigHandler::get_journal_directory();
+    for (size_t shard = 0; shard < worker_shards && !journal_directory.empty(); ++shard) {
+        OrderJournal::Config journal_config;
+        journal_config.directory = worker_shards > 1 ? journal_directory + "/shard-" + std::to_string(shard)
+                                                     : journal_directory;
+        journal_config.fsync = ConfigHandler::get_journal_fsync();
+        journal_config.snapshot_every_records = static_cast<uint64_t>(ConfigHandler::get_journal_snapshot_every_records());
+        auto journal = std::make_unique<OrderJournal>();
+        if (journal->open(journal_config, g_engine_core_ptr->shard_order_manager(shard))) {
+            g_engine_core_ptr->set_order_journal(journal.get(), shard);
+        }
+        order_journals.push_back(std::move(journal));
+    }
     auto execution_handler = std::make_unique<IBKRExecutionHandler>(g_engine_core_ptr.get());
     std::unique_ptr<I_MarketDataHandler> data_handler;
     std::string mode = ConfigHandler::get_engine_mode();
     g_engine_core_ptr->set_mode(mode);
+    for (const auto& [symbol, tick] : ConfigHandler::get_tick_sizes()) {
+        if (symbol == "default") {
+            TickSizeTable::instance().set_default(Price::from_double(tick));
+        } else {
+            TickSizeTable::instance().set(symbol, Price::from_double(tick));
+        }
+    }
+    LatencyStats::set_enabled(ConfigHandler::get_latency_stats_enabled());
+    g_engine_core_ptr->set_stats_publish_interval(std::chrono::milliseconds(ConfigHandler::get_stats_publish_interval_ms()));
+    std::string contract_cache_path = ConfigHandler::get_contract_cache_path();
+    if (mode != "mock" && !contract_cache_path.empty()) {
+        ContractCache::instance().open(contract_cache_path,
+                                       std::chrono::hours(ConfigHandler::get_contract_cache_max_age_hours()));
+    }
     if (mode == "mock") {
 	std::cout << g_engine_core_ptr.get() << std::endl;
         data_handler = std::make_unique<MockMarketDataHandler>(g_engine_core_ptr.get(), "data/ticks.csv");
@@ -44,30 +115,90 @@ int main(int argc, char* argv[]) {
     g_engine_core_ptr->set_execution_handler(execution_handler.get());
     g_engine_core_ptr->set_market_data_handler(data_handler.get());
     if (mode != "mock") {
-        g_engine_core_ptr->set_gateway_client(dynamic_cast<IBKRGatewayClient*>(data_handler.get()));
+        auto* gateway = dynamic_cast<IBKRGatewayClient*>(data_handler.get());
+        gateway->set_market_data_line_limit(static_cast<size_t>(ConfigHandler::get_market_data_line_limit()));
+        OutboundScheduler::Config pacing;
+        pacing.messages_per_second = ConfigHandler::get_outbound_messages_per_second();
+        pacing.burst = ConfigHandler::get_outbound_burst();
+        pacing.history_spacing = std::chrono::milliseconds(ConfigHandler::get_history_request_spacing_ms());
+        gateway->set_outbound_config(pacing);
+        ReconnectSupervisor::Config reconnect;
+        reconnect.initial_delay = std::chrono::milliseconds(ConfigHandler::get_reconnect_initial_delay_ms());
+        reconnect.max_delay = std::chrono::milliseconds(ConfigHandler::get_reconnect_max_delay_ms());
+        gateway->set_direct_reader(ConfigHandler::get_gateway_reader_mode() == "direct");
+        gateway->set_reconnect_config(reconnect, std::chrono::milliseconds(ConfigHandler::get_connect_timeout_ms()));
+        g_engine_core_ptr->set_gateway_client(gateway);
+        // The configured universe holds its own reference so strategies can come and go.
+        for (const auto& symbol : ConfigHandler::get_market_data_subscriptions()) {
+            Event sub_event;
+            sub_event.type = EventType::SUBSCRIBE_REQUEST;
+            sub_event.data = SubscriptionRequest{"TICK." + symbol, "config"};
+            g_engine_core_ptr->post_event(sub_event);
+        }
     }
+    // In-process strategies; each holds its own market data reference.
+    for (const auto& entry : ConfigHandler::get_strategy_plugins()) {
+        StrategyPluginConfig plugin;
+        plugin.id = entry.id;
+        plugin.library = entry.library;
+        plugin.symbols = entry.symbols;
+        plugin.params = entry.params.dump();
+        if (!g_engine_core_ptr->load_strategy_plugin(plugin)) {
+            spdlog::critical("Strategy plugin {} failed to load; not starting.", plugin.id);
+            return 1;
+        }
+        if (mode == "mock") {
+            continue;
+        }
+        for (const auto& symbol : plugin.symbols) {
+            Event sub_event;
+            sub_event.type = EventType::SUBSCRIBE_REQUEST;
+            sub_event.data = SubscriptionRequest{"TICK." + symbol, plugin.id};
+            g_engine_core_ptr->post_event(sub_event);
+        }
+    }
+    // Risk limits are read per order, so they apply as soon as a reload is
+    // published; subscription changes are applied here. Everything else is
+    // read once at startup.
+    const bool live = mode != "mock";
+    ConfigHandler::on_reload([live](const EngineConfig& previous, const EngineConfig& current) {
+        spdlog::info("Config version {}: max_order_size {}, max_position_value_usd {}.", current.version,
+                     current.max_order_size, current.max_position_value);
+        if (!live || !g_engine_core_ptr) {
+            return;
+        }
+        auto post = [](EventType type, const std::string& symbol) {
+            Event event;
+            event.type = type;
+            event.data = SubscriptionRequest{"TICK." + symbol, "config"};
+            g_engine_core_ptr->post_event(event);
+        };
+        const auto& before = previous.market_data_subscriptions;
+        const auto& after = current.market_data_subscriptions;
+        for (const auto& symbol : after) {
+            if (std::find(before.begin(), before.end(), symbol) == before.end()) {
+                post(EventType::SUBSCRIBE_REQUEST, symbol);
+            }
+        }
+        for (const auto& symbol : before) {
+            if (std::find(after.begin(), after.end(), symbol) == after.end()) {
+                post(EventType::UNSUBSCRIBE_REQUEST, symbol);
+            }
+        }
+    });
+    ConfigHandler::start_watching();
     g_engine_core_ptr->startup();
     data_handler->connect();
 
-    if (mode != "mock") {
-
-	spdlog::info("Waiting for market open...");
-	while (!is_market_open_now()) {
-   	// if (!g_engine_core_ptr->m_is_running) { 
-     	//   spdlog::warn("Shutdown requested");
-       	// data_handler->disconnect();
-      	//  return 0;
-   	// }
-    	spdlog::info("Market is closed. Waiting for 5 seconds");
-    	std::this_thread::sleep_for(std::chrono::seconds(5));
-
-    }
-    
-    spdlog::info("Market is open! Starting event loop.");
-}
-
     g_engine_core_ptr->run();
+    ConfigHandler::stop_watching();
     data_handler->disconnect();
+    for (auto& journal : order_journals) {
+        journal->close();
+    }
     spdlog::info("--- Trading Engine Shutdown Complete ---");
+    ContractCache::instance().close();
+    BinaryLog::close();
+    LogHandler::shutdown();
     return 0;
 }
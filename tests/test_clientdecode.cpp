@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+#include "MessageView.hpp"
+#include <nlohmann/json.hpp>
+
+using namespace TradingEngine::Client;
+
+TEST(ClientDecodeTest, DecodesTickInPlace) {
+    const std::string payload =
+        R"({"data":{"price":150.25,"size":100,"symbol":"AAPL"},"timestamp":"1792416600000312000"})";
+    TickView tick;
+    ASSERT_TRUE(TickView::decode(payload, tick));
+    EXPECT_EQ(tick.symbol, "AAPL");
+    EXPECT_DOUBLE_EQ(tick.price, 150.25);
+    EXPECT_DOUBLE_EQ(tick.size, 100.0);
+    EXPECT_EQ(tick.timestamp, 1792416600000312000LL);
+    // The view points into the payload rather than a copy of it.
+    EXPECT_GE(tick.symbol.data(), payload.data());
+    EXPECT_LT(tick.symbol.data(), payload.data() + payload.size());
+    EXPECT_FALSE(tick.snapshot);
+
+    ASSERT_TRUE(TickView::decode(R"({"data":{"price":1,"size":1,"symbol":"AAPL"},"snapshot":true,"timestamp":"1"})",
+                                 tick));
+    EXPECT_TRUE(tick.snapshot);
+}
+
+TEST(ClientDecodeTest, DecodesExecutionReportAndSkipsNestedValues) {
+    const std::string payload =
+        R"({"data":{"avg_fill_price":200.5,"correlation_id":"c-1","exec_id":"0000e0d5.01","fill_price":200.5,)"
+        R"("fill_quantity":10,"filled_quantity":10,"order_id":17,"quantity":25,"side":"BUY",)"
+        R"("status":"PARTIALLY_FILLED","strategy_id":"mean_reversion","strategy_position":10,)"
+        R"("strategy_realized_pnl":-1.5e2,"symbol":"TSLA"},"timestamp":"42"})";
+    ExecutionView report;
+    ASSERT_TRUE(ExecutionView::decode(payload, report));
+    EXPECT_EQ(report.order_id, 17u);
+    EXPECT_EQ(report.correlation_id, "c-1");
+    EXPECT_EQ(report.status, "PARTIALLY_FILLED");
+    EXPECT_TRUE(report.is_fill());
+    EXPECT_DOUBLE_EQ(report.fill_price, 200.5);
+    EXPECT_DOUBLE_EQ(report.strategy_realized_pnl, -150.0);
+    EXPECT_EQ(report.timestamp, 42);
+
+    JsonView json(R"({"a":{"b":"}","c":[1,{"d":2}]},"e" : "x\"y","f":true})");
+    EXPECT_EQ(json.raw("a"), R"({"b":"}","c":[1,{"d":2}]})");
+    EXPECT_EQ(json.string("e"), R"(x\"y)");
+    EXPECT_EQ(json.raw("f"), "true");
+    EXPECT_EQ(json.raw("b"), "");
+
+    TickView tick;
+    EXPECT_FALSE(TickView::decode("not json", tick));
+}
+
+TEST(ClientDecodeTest, EncodesOrdersTheEngineCanParse) {
+    OrderRequest limit;
+    limit.symbol = "TSLA";
+    limit.side = "SELL";
+    limit.order_type = "LIMIT";
+    limit.quantity = 25;
+    limit.limit_price = 200.5;
+    limit.strategy_id = "mr";
+    limit.correlation_id = "quote \"1\"";
+    OrderRequest market;
+    market.symbol = "AAPL";
+    market.quantity = 10;
+
+    auto single = nlohmann::json::parse(encode_order(limit));
+    EXPECT_EQ(single["symbol"], "TSLA");
+    EXPECT_EQ(single["order_type"], "LIMIT");
+    EXPECT_DOUBLE_EQ(single["limit_price"].get<double>(), 200.5);
+    EXPECT_EQ(single["correlation_id"], "quote \"1\"");
+
+    auto batch = nlohmann::json::parse(encode_order_batch({limit, market}));
+    ASSERT_EQ(batch["orders"].size(), 2u);
+    EXPECT_EQ(batch["orders"][1]["symbol"], "AAPL");
+    EXPECT_EQ(batch["orders"][1]["side"], "BUY");
+    EXPECT_FALSE(batch["orders"][1].contains("limit_price"));
+}
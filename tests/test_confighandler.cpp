@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+#include "ConfigHandler.hpp"
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <unistd.h>
+
+namespace {
+
+// ConfigHandler is process-wide, so every test works on one file.
+const std::filesystem::path& config_path() {
+    static const std::filesystem::path path = [] {
+        auto dir = std::filesystem::temp_directory_path() / ("config_handler_test_" + std::to_string(::getpid()));
+        std::filesystem::create_directories(dir);
+        return dir / "config.json";
+    }();
+    return path;
+}
+
+void write_config(int max_order_size, const std::string& extra = "") {
+    std::ofstream out(config_path(), std::ios::trunc);
+    out << R"({"scripting": {"publish_endpoint": "tcp://*:5556", "subscribe_endpoint": "tcp://*:5557"},)"
+        << R"("risk_management": {"max_order_size": )" << max_order_size
+        << R"(, "max_position_value_usd": 5000.0})" << extra << "}";
+}
+
+void initialize_once() {
+    static const bool initialized = [] {
+        write_config(100);
+        return ConfigHandler::initialize(config_path().string());
+    }();
+    ASSERT_TRUE(initialized);
+}
+
+}
+
+TEST(ConfigHandlerTest, ReloadPublishesNewVersion) {
+    initialize_once();
+    const EngineConfig& before = ConfigHandler::current();
+    write_config(before.max_order_size + 1);
+    ASSERT_TRUE(ConfigHandler::reload());
+    const EngineConfig& after = ConfigHandler::current();
+    EXPECT_EQ(after.version, before.version + 1);
+    EXPECT_EQ(after.max_order_size, before.max_order_size + 1);
+    EXPECT_EQ(ConfigHandler::get_max_order_size(), after.max_order_size);
+    // The old version is still readable.
+    EXPECT_EQ(before.max_position_value, 5000.0);
+}
+
+TEST(ConfigHandlerTest, InvalidFileKeepsCurrentVersion) {
+    initialize_once();
+    const EngineConfig& before = ConfigHandler::current();
+    write_config(-5);
+    EXPECT_FALSE(ConfigHandler::reload());
+    write_config(10, R"(, "event_queue": {"market_data": {"capacity": 16, "policy": "sideways"}})");
+    EXPECT_FALSE(ConfigHandler::reload());
+    EXPECT_EQ(&ConfigHandler::current(), &before);
+}
+
+TEST(ConfigHandlerTest, WatcherReloadsOnWrite) {
+    initialize_once();
+    // Listeners stay registered, so nothing here may go out of scope.
+    static uint64_t seen = 0;
+    static std::mutex mutex;
+    ConfigHandler::on_reload([](const EngineConfig&, const EngineConfig& current) {
+        std::lock_guard<std::mutex> lock(mutex);
+        seen = current.version;
+    });
+    ASSERT_TRUE(ConfigHandler::start_watching());
+    const uint64_t version = ConfigHandler::current().version;
+    write_config(42);
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (ConfigHandler::current().version == version && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    ConfigHandler::stop_watching();
+    EXPECT_EQ(ConfigHandler::current().max_order_size, 42);
+    std::lock_guard<std::mutex> lock(mutex);
+    EXPECT_EQ(seen, ConfigHandler::current().version);
+}
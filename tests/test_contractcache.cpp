@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+#include "ContractCache.hpp"
+#include <cstdio>
+#include <filesystem>
+
+using namespace TradingEngine;
+
+TEST(SymbolTableTest, InternsDenseStableIds) {
+    SymbolTable table;
+    SymbolId aapl = table.intern("AAPL");
+    SymbolId msft = table.intern("MSFT");
+    EXPECT_EQ(aapl, 1u);
+    EXPECT_EQ(msft, 2u);
+    EXPECT_EQ(table.intern("AAPL"), aapl);
+    EXPECT_EQ(table.find("MSFT"), msft);
+    EXPECT_EQ(table.find("GOOG"), kInvalidSymbolId);
+    EXPECT_EQ(table.name(msft), "MSFT");
+    EXPECT_EQ(table.name(kInvalidSymbolId), "");
+}
+
+class ContractCacheTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        m_path = (std::filesystem::temp_directory_path() / "test_contracts.cache").string();
+        std::remove(m_path.c_str());
+    }
+    void TearDown() override {
+        std::remove(m_path.c_str());
+    }
+
+    static ContractInfo make_info(const std::string& symbol, long con_id, int64_t resolved_at) {
+        ContractInfo info;
+        info.symbol = symbol;
+        info.symbol_id = SymbolTable::instance().intern(symbol);
+        info.con_id = con_id;
+        info.sec_type = "STK";
+        info.exchange = "SMART";
+        info.primary_exchange = "NASDAQ";
+        info.currency = "USD";
+        info.min_tick = Price::from_double(0.01);
+        info.time_zone = "US/Eastern";
+        info.trading_hours = "20240102:0400-20240102:2000";
+        info.resolved_at = resolved_at;
+        return info;
+    }
+
+    static int64_t now_s() {
+        return std::chrono::duration_cast<std::chrono::seconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+
+    std::string m_path;
+};
+
+TEST_F(ContractCacheTest, LookupIsEmptyUntilStored) {
+    ContractCache cache;
+    ContractInfo info = make_info("AAPL", 265598, now_s());
+    EXPECT_EQ(cache.lookup(info.symbol_id), nullptr);
+    cache.store(info);
+    const ContractInfo* found = cache.lookup(info.symbol_id);
+    ASSERT_NE(found, nullptr);
+    EXPECT_EQ(found->con_id, 265598);
+}
+
+TEST_F(ContractCacheTest, PersistsAcrossRestarts) {
+    ContractInfo fresh = make_info("AAPL", 265598, now_s());
+    ContractInfo stale = make_info("MSFT", 272093, now_s() - 48 * 3600);
+    {
+        ContractCache cache;
+        ASSERT_TRUE(cache.open(m_path));
+        cache.store(fresh);
+        cache.store(stale);
+        // Re-resolving overwrites the existing record instead of appending.
+        fresh.con_id = 265599;
+        cache.store(fresh);
+    }
+
+    ContractCache reloaded;
+    ASSERT_TRUE(reloaded.open(m_path, std::chrono::hours(24)));
+    const ContractInfo* aapl = reloaded.lookup(fresh.symbol_id);
+    ASSERT_NE(aapl, nullptr);
+    EXPECT_EQ(aapl->con_id, 265599);
+    EXPECT_EQ(aapl->primary_exchange, "NASDAQ");
+    EXPECT_EQ(aapl->min_tick, Price::from_double(0.01));
+    EXPECT_EQ(aapl->trading_hours, fresh.trading_hours);
+    EXPECT_EQ(reloaded.lookup(stale.symbol_id), nullptr);
+    EXPECT_EQ(reloaded.size(), 1u);
+}
@@ -0,0 +1,52 @@
+#include <gtest/gtest.h>
+#include "EFieldParse.h"
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+namespace {
+
+double parse_double(const std::string& field) {
+    return EFieldParse::parseDouble(field.data(), field.data() + field.size());
+}
+
+template <typename T>
+T parse_integer(const std::string& field) {
+    return EFieldParse::parseInteger<T>(field.data(), field.data() + field.size());
+}
+
+bool same_bits(double a, double b) {
+    return std::memcmp(&a, &b, sizeof(double)) == 0;
+}
+
+}
+
+TEST(FieldParseTest, DoublesMatchStrtod) {
+    const char* fields[] = {"150.01", "0.0001", "-0.5", "-0", "4512.25", "5.", ".25", "300",
+                            "9007199254740993", "0.1234567890123456789012345", "1.5E-7",
+                            "1.7976931348623157E308", "123456789.123456789"};
+    for (const char* field : fields) {
+        EXPECT_TRUE(same_bits(parse_double(field), std::strtod(field, nullptr))) << field;
+    }
+}
+
+TEST(FieldParseTest, DoubleEdgeCases) {
+    EXPECT_EQ(parse_double(""), 0.0);
+    EXPECT_EQ(parse_double("-"), 0.0);
+    EXPECT_EQ(parse_double("abc"), 0.0);
+    EXPECT_EQ(parse_double("Infinity"), INFINITY);
+    EXPECT_EQ(parse_double("+2.5"), 2.5);
+}
+
+TEST(FieldParseTest, IntegersMatchAtoi) {
+    EXPECT_EQ(parse_integer<int>("2001"), 2001);
+    EXPECT_EQ(parse_integer<int>("-1"), -1);
+    EXPECT_EQ(parse_integer<int>("+7"), 7);
+    EXPECT_EQ(parse_integer<int>(""), 0);
+    EXPECT_EQ(parse_integer<int>("12abc"), 12);
+    EXPECT_EQ(parse_integer<int>("2147483647"), INT_MAX);
+    EXPECT_EQ(parse_integer<int>("2147483648"), std::atoi("2147483648"));
+    EXPECT_EQ(parse_integer<long long>("9223372036854775807"), LLONG_MAX);
+    EXPECT_EQ(parse_integer<long long>("1700000000123"), 1700000000123LL);
+}
@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+#include "FixedPoint.hpp"
+
+using namespace TradingEngine;
+
+TEST(FixedPointTest, ParsesDecimalStringsExactly) {
+    Price price;
+    ASSERT_TRUE(Price::parse("150.01", price));
+    EXPECT_EQ(price.raw(), 15001000000);
+    ASSERT_TRUE(Price::parse("-0.5", price));
+    EXPECT_EQ(price, -Price::from_raw(Price::kScale / 2));
+
+    Quantity qty;
+    ASSERT_TRUE(Quantity::parse("100", qty));
+    EXPECT_EQ(qty, Quantity::from_int(100));
+    // Digits beyond the scale round half away from zero.
+    ASSERT_TRUE(Quantity::parse("1.00005", qty));
+    EXPECT_EQ(qty.raw(), 10001);
+
+    EXPECT_FALSE(Price::parse("", price));
+    EXPECT_FALSE(Price::parse("1.2.3", price));
+    EXPECT_FALSE(Price::parse("12abc", price));
+}
+
+TEST(FixedPointTest, FormatsWithoutTrailingZeros) {
+    EXPECT_EQ(Price::from_double(149.95).to_string(), "149.95");
+    EXPECT_EQ(Quantity::from_int(200).to_string(), "200");
+    EXPECT_EQ(Price::from_raw(-1).to_string(), "-0.00000001");
+}
+
+TEST(FixedPointTest, AveragePriceIsExactWhenRepresentable) {
+    Notional total = notional(Price::from_int(300), Quantity::from_int(50)) +
+                     notional(Price::from_int(301), Quantity::from_int(150));
+    EXPECT_EQ(average_price(total, Quantity::from_int(200)), Price::from_double(300.75));
+    EXPECT_EQ(average_price(total, Quantity{}), Price{});
+}
+
+TEST(FixedPointTest, Bid64RoundTrip) {
+    // 100 shares = coefficient 1000000, exponent -4 in the small-coefficient layout.
+    uint64_t bits = Quantity::from_int(100).to_bid64();
+    EXPECT_EQ(bits, (uint64_t{398 - 4} << 53) | 1000000);
+
+    Quantity decoded;
+    ASSERT_TRUE(Quantity::from_bid64(bits, decoded));
+    EXPECT_EQ(decoded, Quantity::from_int(100));
+
+    // Same value with exponent 0, as the gateway usually encodes whole sizes.
+    ASSERT_TRUE(Quantity::from_bid64((uint64_t{398} << 53) | 100, decoded));
+    EXPECT_EQ(decoded, Quantity::from_int(100));
+
+    ASSERT_TRUE(Quantity::from_bid64((-Quantity::from_raw(12345)).to_bid64(), decoded));
+    EXPECT_EQ(decoded.raw(), -12345);
+
+    // IB's UNSET_DECIMAL is all ones, which is a NaN.
+    EXPECT_FALSE(Quantity::from_bid64(~uint64_t{0}, decoded));
+}
+
+TEST(FixedPointTest, TickSizeTable) {
+    TickSizeTable table;
+    table.set("BRK.A", Price::from_int(1));
+    EXPECT_EQ(table.tick_size("AAPL"), Price::from_double(0.01));
+    EXPECT_TRUE(table.is_on_tick("AAPL", Price::from_double(150.25)));
+    EXPECT_FALSE(table.is_on_tick("AAPL", Price::from_double(150.255)));
+    EXPECT_EQ(table.round_to_tick("BRK.A", Price::from_double(612345.5)), Price::from_int(612346));
+}
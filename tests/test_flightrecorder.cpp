@@ -0,0 +1,139 @@
+#include <gtest/gtest.h>
+#include "FlightRecorder.hpp"
+#include "SymbolTable.hpp"
+#include <atomic>
+#include <csignal>
+#include <filesystem>
+#include <pthread.h>
+#include <thread>
+#include <unistd.h>
+
+using namespace TradingEngine;
+
+namespace {
+
+constexpr size_t kRecordsPerThread = 8;
+
+// The recorder is process-wide, so every test shares one directory.
+void enable_once() {
+    static const bool enabled = [] {
+        auto dir = std::filesystem::temp_directory_path() / ("flight_recorder_test_" + std::to_string(::getpid()));
+        return FlightRecorder::enable(dir.string(), kRecordsPerThread);
+    }();
+    ASSERT_TRUE(enabled);
+}
+
+FlightDump dump_and_read() {
+    std::string path = FlightRecorder::dump();
+    EXPECT_FALSE(path.empty());
+    FlightDump dump;
+    EXPECT_TRUE(read_flight_dump(path, dump));
+    std::filesystem::remove(path);
+    return dump;
+}
+
+const FlightDump::Thread* find_thread(const FlightDump& dump, const std::string& name) {
+    for (const auto& thread : dump.threads) {
+        if (thread.name == name) {
+            return &thread;
+        }
+    }
+    return nullptr;
+}
+
+void record_on_thread(const char* name, uint64_t first, uint64_t count) {
+    std::thread([=] {
+        pthread_setname_np(pthread_self(), name);
+        for (uint64_t i = 0; i < count; ++i) {
+            FlightRecorder::record(FlightKind::GATEWAY_IN, 0, 0, first + i);
+        }
+    }).join();
+}
+
+}
+
+TEST(FlightRecorderTest, KeepsTheLastRecordsInOrder) {
+    enable_once();
+    SymbolId aapl = SymbolTable::instance().intern("AAPL");
+    FlightRecorder::record(FlightKind::EVENT, 0, aapl, 7);
+    record_on_thread("fr_ring", 0, 20);
+
+    FlightDump dump = dump_and_read();
+    EXPECT_EQ(dump.header.signal, 0);
+    EXPECT_EQ(dump.symbol(aapl), "AAPL");
+    const FlightDump::Thread* thread = find_thread(dump, "fr_ring");
+    ASSERT_NE(thread, nullptr);
+    ASSERT_EQ(thread->records.size(), kRecordsPerThread);
+    EXPECT_EQ(thread->first_sequence, 20 - kRecordsPerThread);
+    for (size_t i = 0; i < kRecordsPerThread; ++i) {
+        EXPECT_EQ(thread->records[i].a, 20 - kRecordsPerThread + i);
+        EXPECT_LE(dump.wall_ns(thread->records[i]), dump.header.wall_ns);
+    }
+}
+
+TEST(FlightRecorderTest, ExitedThreadsRingIsReused) {
+    enable_once();
+    record_on_thread("fr_first", 100, 3);
+    size_t rings = dump_and_read().threads.size();
+    record_on_thread("fr_second", 200, 2);
+
+    FlightDump dump = dump_and_read();
+    EXPECT_EQ(dump.threads.size(), rings);
+    EXPECT_EQ(find_thread(dump, "fr_first"), nullptr);
+    const FlightDump::Thread* thread = find_thread(dump, "fr_second");
+    ASSERT_NE(thread, nullptr);
+    ASSERT_EQ(thread->records.size(), 2u);
+    EXPECT_EQ(thread->records[0].a, 200u);
+}
+
+TEST(FlightRecorderTest, CommandTextIsTruncatedTo16Bytes) {
+    enable_once();
+    std::thread([] {
+        pthread_setname_np(pthread_self(), "fr_command");
+        FlightRecorder::record_text(FlightKind::COMMAND, "DUMP_FLIGHT_RECORDER");
+    }).join();
+
+    FlightDump dump = dump_and_read();
+    const FlightDump::Thread* thread = find_thread(dump, "fr_command");
+    ASSERT_NE(thread, nullptr);
+    ASSERT_EQ(thread->records.size(), 1u);
+    char text[17] = {};
+    std::memcpy(text, &thread->records[0].a, 8);
+    std::memcpy(text + 8, &thread->records[0].b, 8);
+    EXPECT_STREQ(text, "DUMP_FLIGHT_RECO");
+}
+
+namespace {
+
+// 1: alt stack installed while recording; 2: removed again once the thread's
+// recorder state was destroyed.
+std::atomic<int> g_alt_stack_state{0};
+
+bool alt_stack_installed() {
+    stack_t current{};
+    return sigaltstack(nullptr, &current) == 0 && !(current.ss_flags & SS_DISABLE);
+}
+
+// Constructed before the recorder's per-thread state, so destroyed after it.
+struct AltStackProbe {
+    ~AltStackProbe() {
+        if (g_alt_stack_state.load() == 1 && !alt_stack_installed()) {
+            g_alt_stack_state.store(2);
+        }
+    }
+};
+
+}
+
+TEST(FlightRecorderTest, ThreadExitRemovesItsAltStack) {
+    enable_once();
+    std::thread([] {
+        static thread_local AltStackProbe probe;
+        (void)probe;
+        FlightRecorder::record(FlightKind::GATEWAY_IN, 0, 0, 1);
+        if (alt_stack_installed()) {
+            g_alt_stack_state.store(1);
+        }
+    }).join();
+    EXPECT_EQ(g_alt_stack_state.load(), 2);
+}
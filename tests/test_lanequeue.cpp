@@ -0,0 +1,148 @@
+#include <gtest/gtest.h>
+#include "LaneQueue.hpp"
+#include "Event.hpp"
+#include <thread>
+
+using namespace TradingEngine;
+
+TEST(LaneQueueTest, HigherLanesDrainFirstAndEachLaneStaysFifo) {
+    LaneQueue<int, 3> queue(0);
+    queue.push(2, 20);
+    queue.push(1, 10);
+    queue.push(1, 11);
+    queue.push(0, 1);
+    queue.push(2, 21);
+    queue.push(0, 2);
+    EXPECT_EQ(queue.size(), 6u);
+    EXPECT_EQ(queue.size(1), 2u);
+
+    std::vector<int> order;
+    int value = 0;
+    while (queue.try_pop(value)) {
+        order.push_back(value);
+    }
+    EXPECT_EQ(order, (std::vector<int>{1, 2, 10, 11, 20, 21}));
+    EXPECT_EQ(queue.size(), 0u);
+}
+
+TEST(LaneQueueTest, StarvedLaneIsServedAfterLimit) {
+    LaneQueue<int, 2> queue(3);
+    queue.push(1, 100);
+    for (int i = 0; i < 10; ++i) {
+        queue.push(0, i);
+    }
+    std::vector<int> order;
+    int value = 0;
+    while (queue.try_pop(value)) {
+        order.push_back(value);
+    }
+    // Passed over three times, then served ahead of the rest of lane 0.
+    EXPECT_EQ(order, (std::vector<int>{0, 1, 2, 100, 3, 4, 5, 6, 7, 8, 9}));
+}
+
+TEST(LaneQueueTest, WaitAndPopWakesOnPush) {
+    LaneQueue<int, 2> queue;
+    int value = 0;
+    EXPECT_FALSE(queue.wait_and_pop_for(value, std::chrono::milliseconds(1)));
+    std::thread producer([&queue] { queue.push(1, 7); });
+    EXPECT_TRUE(queue.wait_and_pop_for(value, std::chrono::seconds(5)));
+    EXPECT_EQ(value, 7);
+    producer.join();
+}
+
+TEST(LaneQueueTest, OrdersAndFillsRideTheControlLane) {
+    EXPECT_EQ(event_lane(EventType::ORDER_REQUEST), EventLane::CONTROL);
+    EXPECT_EQ(event_lane(EventType::EXECUTION_REPORT), EventLane::CONTROL);
+    EXPECT_EQ(event_lane(EventType::CANCEL_ORDER_REQUEST), EventLane::CONTROL);
+    EXPECT_EQ(event_lane(EventType::TICK), EventLane::MARKET_DATA);
+    EXPECT_EQ(event_lane(EventType::HISTORICAL_DATA), EventLane::BULK);
+    EXPECT_EQ(event_lane(EventType::SYSTEM_SHUTDOWN), EventLane::BULK);
+}
+
+namespace {
+uint32_t int_key(const int& value) {
+    return static_cast<uint32_t>(value / 100);  // 1xx -> key 1, 2xx -> key 2
+}
+
+std::vector<int> drain(LaneQueue<int, 1>& queue) {
+    std::vector<int> items;
+    int value = 0;
+    while (queue.try_pop(value)) {
+        items.push_back(value);
+    }
+    return items;
+}
+}
+
+TEST(LaneQueueTest, RingWrapsWithoutLosingOrder) {
+    LaneQueue<int, 1> queue;
+    queue.configure({LaneConfig{4, OverflowPolicy::REJECT}});
+    int value = 0;
+    for (int i = 0; i < 10; ++i) {
+        ASSERT_TRUE(queue.push(0, i));
+        ASSERT_TRUE(queue.try_pop(value));
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_EQ(queue.capacity(0), 4u);
+}
+
+TEST(LaneQueueTest, DropOldestAndRejectAreCounted) {
+    LaneQueue<int, 1> queue;
+    queue.configure({LaneConfig{2, OverflowPolicy::DROP_OLDEST}});
+    queue.push(0, 1);
+    queue.push(0, 2);
+    EXPECT_TRUE(queue.push(0, 3));
+    EXPECT_EQ(drain(queue), (std::vector<int>{2, 3}));
+    EXPECT_EQ(queue.overload(0).dropped, 1u);
+
+    queue.configure({LaneConfig{2, OverflowPolicy::REJECT}});
+    queue.push(0, 1);
+    queue.push(0, 2);
+    EXPECT_FALSE(queue.push(0, 3));
+    EXPECT_EQ(drain(queue), (std::vector<int>{1, 2}));
+    EXPECT_EQ(queue.overload(0).rejected, 1u);
+}
+
+TEST(LaneQueueTest, ConflateReplacesQueuedItemWithSameKey) {
+    LaneQueue<int, 1> queue;
+    queue.configure({LaneConfig{4, OverflowPolicy::CONFLATE}}, &int_key, 8);
+    queue.push(0, 100);
+    queue.push(0, 200);
+    queue.push(0, 101);
+    queue.push(0, 5);    // key 0: never conflated
+    queue.push(0, 102);  // full: replaces 101 in place
+    queue.push(0, 201);  // full: replaces 200 in place
+    EXPECT_EQ(queue.overload(0).conflated, 2u);
+    EXPECT_EQ(drain(queue), (std::vector<int>{100, 201, 102, 5}));
+
+    // No queued item shares the key: falls back to dropping the oldest.
+    for (int value : {100, 101, 102, 103, 300}) {
+        queue.push(0, value);
+    }
+    EXPECT_EQ(queue.overload(0).dropped, 1u);
+    EXPECT_EQ(drain(queue), (std::vector<int>{101, 102, 103, 300}));
+}
+
+TEST(LaneQueueTest, BlockWaitsForRoomUnlessTheProducerMayNot) {
+    LaneQueue<int, 1> queue;
+    queue.configure({LaneConfig{1, OverflowPolicy::BLOCK}});
+    queue.push(0, 1);
+    EXPECT_FALSE(queue.push(0, 2, false));
+    EXPECT_EQ(queue.overload(0).rejected, 1u);
+
+    std::thread producer([&queue] { EXPECT_TRUE(queue.push(0, 3)); });
+    int value = 0;
+    while (queue.overload(0).blocked == 0) {
+        std::this_thread::yield();
+    }
+    ASSERT_TRUE(queue.wait_and_pop_for(value, std::chrono::seconds(5)));
+    EXPECT_EQ(value, 1);
+    ASSERT_TRUE(queue.wait_and_pop_for(value, std::chrono::seconds(5)));
+    EXPECT_EQ(value, 3);
+    producer.join();
+
+    // Once closed, a full queue rejects instead of blocking forever.
+    queue.push(0, 4);
+    queue.close();
+    EXPECT_FALSE(queue.push(0, 5));
+}
@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+#include "LastValueCache.hpp"
+#include <vector>
+
+using namespace TradingEngine;
+
+TEST(LastValueCacheTest, KeepsTheLatestTickPerSymbol) {
+    LastValueCache cache;
+    SymbolId aapl = SymbolTable::instance().intern("AAPL");
+    SymbolId msft = SymbolTable::instance().intern("MSFT");
+    Tick out;
+    EXPECT_FALSE(cache.last_tick(aapl, out));
+
+    Tick tick;
+    tick.symbol = "AAPL";
+    tick.symbol_id = aapl;
+    tick.price = Price::from_double(150.25);
+    tick.size = Quantity::from_int(100);
+    tick.timestamp = std::chrono::system_clock::time_point(std::chrono::system_clock::duration(42));
+    cache.record_tick(tick);
+    tick.price = Price::from_double(150.50);
+    tick.symbol_id = kInvalidSymbolId;  // looked up by name instead
+    cache.record_tick(tick);
+
+    ASSERT_TRUE(cache.last_tick(aapl, out));
+    EXPECT_EQ(out.symbol, "AAPL");
+    EXPECT_EQ(out.symbol_id, aapl);
+    EXPECT_EQ(out.price, Price::from_double(150.50));
+    EXPECT_EQ(out.size, Quantity::from_int(100));
+    EXPECT_EQ(out.timestamp.time_since_epoch().count(), 42);
+    EXPECT_FALSE(cache.last_tick(msft, out));
+    EXPECT_FALSE(cache.last_tick(kInvalidSymbolId, out));
+}
+
+TEST(LastValueCacheTest, KeepsLatestBarsAndOnlyWorkingOrders) {
+    LastValueCache cache;
+    Bar bar;
+    bar.symbol = "AAPL";
+    bar.time = "20261016";
+    cache.record_bar(bar);
+    bar.time = "20261017";
+    cache.record_bar(bar);
+    std::vector<std::string> times;
+    cache.for_each_bar([&](const Bar& b) { times.push_back(b.time); });
+    EXPECT_EQ(times, std::vector<std::string>{"20261017"});
+
+    cache.record_order(2, "EXECUTION.s.2", "new", true);
+    cache.record_order(1, "EXECUTION.s.1", "new", true);
+    cache.record_order(2, "EXECUTION.s.2", "partial", true);
+    cache.record_order(1, "EXECUTION.s.1", "", false);
+    std::vector<std::pair<std::string, std::string>> orders;
+    cache.for_each_open_order([&](const std::string& topic, const std::string& payload) {
+        orders.emplace_back(topic, payload);
+    });
+    std::vector<std::pair<std::string, std::string>> expected = {{"EXECUTION.s.2", "partial"}};
+    EXPECT_EQ(orders, expected);
+}
@@ -0,0 +1,302 @@
+#include <gtest/gtest.h>
+#include "OrderJournal.hpp"
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <mutex>
+#include <csignal>
+#include <sys/resource.h>
+
+using namespace TradingEngine;
+
+class OrderJournalTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        dir = std::filesystem::temp_directory_path() /
+              ("order_journal_test_" + std::to_string(::getpid()) + "_" +
+               ::testing::UnitTest::GetInstance()->current_test_info()->name());
+        std::filesystem::remove_all(dir);
+        config.directory = dir.string();
+        config.fsync = false;
+        config.snapshot_every_records = 0;
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(dir);
+    }
+
+    static Order make_order(const std::string& symbol, int quantity, int price) {
+        Order order;
+        order.symbol = symbol;
+        order.side = Side::BUY;
+        order.order_type = OrderType::LIMIT;
+        order.quantity = Quantity::from_int(quantity);
+        order.price = Price::from_int(price);
+        order.strategy_id = "alpha";
+        return order;
+    }
+
+    static ExecutionReport fill(uint64_t order_id, const std::string& symbol, int quantity, int price,
+                                const std::string& exec_id, OrderStatus status) {
+        ExecutionReport report;
+        report.order_id = order_id;
+        report.symbol = symbol;
+        report.type = ReportType::FILL;
+        report.new_status = status;
+        report.fill_quantity = Quantity::from_int(quantity);
+        report.fill_price = Price::from_int(price);
+        report.exec_id = exec_id;
+        return report;
+    }
+
+    std::filesystem::path dir;
+    OrderJournal::Config config;
+};
+
+TEST_F(OrderJournalTest, ReplaysLogIntoFreshOrderManager) {
+    uint64_t first_id = 0;
+    uint64_t second_id = 0;
+    {
+        OrderManager om;
+        OrderJournal journal;
+        ASSERT_TRUE(journal.open(config, om));
+        Order first = make_order("AAPL", 100, 150);
+        first_id = om.add_new_order(first);
+        journal.append_order(first);
+        Order second = make_order("MSFT", 50, 300);
+        second_id = om.add_new_order(second);
+        journal.append_order(second);
+
+        ExecutionReport report = fill(first_id, "AAPL", 40, 150, "E1", OrderStatus::PARTIALLY_FILLED);
+        om.update_order_status(report);
+        journal.append_report(report);
+        om.request_cancel(second_id);
+        journal.append_cancel(second_id);
+        journal.close();
+    }
+
+    OrderManager recovered;
+    OrderJournal journal;
+    ASSERT_TRUE(journal.open(config, recovered));
+    EXPECT_EQ(journal.last_sequence(), 4u);
+    EXPECT_EQ(recovered.get_order(first_id).filled_quantity, Quantity::from_int(40));
+    EXPECT_EQ(recovered.get_order(second_id).status, OrderStatus::PENDING_CANCEL);
+    EXPECT_EQ(recovered.get_position("AAPL"), Quantity::from_int(40));
+
+    // The same execution seen again after restart is not double counted.
+    recovered.update_order_status(fill(first_id, "AAPL", 40, 150, "E1", OrderStatus::PARTIALLY_FILLED));
+    EXPECT_EQ(recovered.get_position("AAPL"), Quantity::from_int(40));
+
+    // New ids continue after the recovered ones.
+    Order third = make_order("AAPL", 10, 151);
+    EXPECT_GT(recovered.add_new_order(third), second_id);
+}
+
+TEST_F(OrderJournalTest, RecoversFromSnapshotPlusTail) {
+    uint64_t order_id = 0;
+    {
+        OrderManager om;
+        OrderJournal journal;
+        ASSERT_TRUE(journal.open(config, om));
+        Order order = make_order("AAPL", 100, 150);
+        order_id = om.add_new_order(order);
+        journal.append_order(order);
+        ExecutionReport first = fill(order_id, "AAPL", 60, 150, "E1", OrderStatus::PARTIALLY_FILLED);
+        om.update_order_status(first);
+        journal.append_report(first);
+        journal.snapshot(om);
+
+        ExecutionReport second = fill(order_id, "AAPL", 40, 152, "E2", OrderStatus::FILLED);
+        om.update_order_status(second);
+        journal.append_report(second);
+        journal.close();
+    }
+
+    OrderManager recovered;
+    OrderJournal journal;
+    ASSERT_TRUE(journal.open(config, recovered));
+    const Order order = recovered.get_order(order_id);
+    EXPECT_EQ(order.status, OrderStatus::FILLED);
+    EXPECT_EQ(order.filled_quantity, Quantity::from_int(100));
+    EXPECT_EQ(recovered.get_position("AAPL"), Quantity::from_int(100));
+    EXPECT_EQ(recovered.get_strategy_position("alpha", "AAPL").position, Quantity::from_int(100));
+    EXPECT_EQ(journal.last_sequence(), 3u);
+}
+
+TEST_F(OrderJournalTest, DiscardsTornTailAndKeepsAppending) {
+    {
+        OrderManager om;
+        OrderJournal journal;
+        ASSERT_TRUE(journal.open(config, om));
+        Order order = make_order("AAPL", 100, 150);
+        om.add_new_order(order);
+        journal.append_order(order);
+        journal.close();
+    }
+    {
+        // Half of a record header, as left by a crash mid-write.
+        std::ofstream wal(dir / "orders.wal", std::ios::binary | std::ios::app);
+        wal.write("\x30\x00\x00", 3);
+    }
+
+    {
+        OrderManager om;
+        OrderJournal journal;
+        ASSERT_TRUE(journal.open(config, om));
+        EXPECT_EQ(om.open_order_count(), 1u);
+        Order order = make_order("MSFT", 10, 300);
+        om.add_new_order(order);
+        journal.append_order(order);
+        journal.close();
+    }
+
+    OrderManager recovered;
+    OrderJournal journal;
+    ASSERT_TRUE(journal.open(config, recovered));
+    EXPECT_EQ(recovered.open_order_count(), 2u);
+}
+
+TEST_F(OrderJournalTest, DurableCallbackRunsAfterCommit) {
+    OrderManager om;
+    OrderJournal journal;
+    ASSERT_TRUE(journal.open(config, om));
+    std::atomic<int> durable{0};
+    for (int i = 0; i < 100; ++i) {
+        Order order = make_order("AAPL", 1, 150);
+        om.add_new_order(order);
+        journal.append_order(order, [&durable](bool ok) { durable.fetch_add(ok ? 1 : 0); });
+    }
+    journal.sync();
+    journal.close();
+    EXPECT_EQ(durable.load(), 100);
+}
+
+TEST_F(OrderJournalTest, CancelIsHeldUntilItsOrderIsReleased) {
+    OrderManager om;
+    OrderJournal journal;
+    ASSERT_TRUE(journal.open(config, om));
+    std::mutex mutex;
+    std::vector<std::string> sent;
+    std::promise<void> placing;
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+
+    Order order = make_order("AAPL", 100, 150);
+    om.add_new_order(order);
+    journal.append_order(order, [&](bool) {
+        placing.set_value();
+        released.wait();
+        std::lock_guard<std::mutex> lock(mutex);
+        sent.push_back("place");
+    });
+    // The order's callback has started but not finished: it is not released yet.
+    placing.get_future().wait();
+    journal.append_cancel(order.order_id, [&](bool) {
+        std::lock_guard<std::mutex> lock(mutex);
+        sent.push_back("cancel");
+    });
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        EXPECT_TRUE(sent.empty());
+    }
+    release.set_value();
+    journal.close();
+    EXPECT_EQ(sent, (std::vector<std::string>{"place", "cancel"}));
+
+    // Once released, the cancel is sent straight away.
+    OrderJournal reopened;
+    OrderManager recovered;
+    ASSERT_TRUE(reopened.open(config, recovered));
+    bool cancelled = false;
+    reopened.append_cancel(order.order_id, [&](bool sent) { cancelled = sent; });
+    EXPECT_TRUE(cancelled);
+}
+
+TEST_F(OrderJournalTest, FailedWriteLeavesNoTornRecordAndFailsTheJournal) {
+    OrderManager om;
+    OrderJournal journal;
+    ASSERT_TRUE(journal.open(config, om));
+    Order kept = make_order("AAPL", 100, 150);
+    om.add_new_order(kept);
+    journal.append_order(kept);
+    journal.sync();
+    const auto good_size = std::filesystem::file_size(dir / "orders.wal");
+
+    // A file size limit a few bytes past the end: the next record is written
+    // in part, then the write fails.
+    auto previous = std::signal(SIGXFSZ, SIG_IGN);
+    rlimit saved{};
+    ASSERT_EQ(::getrlimit(RLIMIT_FSIZE, &saved), 0);
+    rlimit limited = saved;
+    limited.rlim_cur = good_size + 10;
+    ASSERT_EQ(::setrlimit(RLIMIT_FSIZE, &limited), 0);
+
+    Order lost = make_order("MSFT", 50, 300);
+    om.add_new_order(lost);
+    std::promise<void> cancel_appended;
+    std::shared_future<void> appended = cancel_appended.get_future().share();
+    bool durable = true;
+    journal.append_order(lost, [&](bool ok) {
+        appended.wait();
+        durable = ok;
+    });
+    std::promise<bool> cancel_outcome;
+    journal.append_cancel(lost.order_id, [&](bool sent) { cancel_outcome.set_value(sent); });
+    cancel_appended.set_value();
+    const bool cancel_sent = cancel_outcome.get_future().get();
+
+    ::setrlimit(RLIMIT_FSIZE, &saved);
+    std::signal(SIGXFSZ, previous);
+
+    EXPECT_FALSE(durable);
+    EXPECT_FALSE(cancel_sent);
+    EXPECT_TRUE(journal.failed());
+    EXPECT_EQ(std::filesystem::file_size(dir / "orders.wal"), good_size);
+    journal.close();
+
+    OrderManager recovered;
+    OrderJournal reopened;
+    ASSERT_TRUE(reopened.open(config, recovered));
+    EXPECT_FALSE(reopened.failed());
+    EXPECT_EQ(recovered.get_order(kept.order_id).order_id, kept.order_id);
+    EXPECT_EQ(recovered.get_order(lost.order_id).order_id, 0u);
+}
+
+TEST_F(OrderJournalTest, ModifyReplaysAsPendingUntilTheBrokerAcceptsIt) {
+    uint64_t accepted_id = 0;
+    uint64_t pending_id = 0;
+    {
+        OrderManager om;
+        OrderJournal journal;
+        ASSERT_TRUE(journal.open(config, om));
+        Order accepted = make_order("AAPL", 100, 150);
+        om.add_new_order(accepted);
+        journal.append_order(accepted);
+        Order pending = make_order("MSFT", 10, 300);
+        om.add_new_order(pending);
+        journal.append_order(pending);
+        accepted_id = accepted.order_id;
+        pending_id = pending.order_id;
+
+        ASSERT_TRUE(om.request_modify(accepted_id, Quantity::from_int(200), std::nullopt));
+        journal.append_modify(accepted_id, Quantity::from_int(200), std::nullopt);
+        ExecutionReport modified;
+        modified.type = ReportType::MODIFIED;
+        modified.order_id = accepted_id;
+        modified.order_quantity = Quantity::from_int(200);
+        modified.order_price = Price::from_int(150);
+        ASSERT_TRUE(om.update_order_status(modified));
+        journal.append_report(modified);
+
+        ASSERT_TRUE(om.request_modify(pending_id, std::nullopt, Price::from_int(290)));
+        journal.append_modify(pending_id, std::nullopt, Price::from_int(290));
+        journal.close();
+    }
+    OrderManager recovered;
+    OrderJournal journal;
+    ASSERT_TRUE(journal.open(config, recovered));
+    EXPECT_EQ(recovered.get_order(accepted_id).quantity, Quantity::from_int(200));
+    EXPECT_FALSE(recovered.get_order(accepted_id).pending_quantity);
+    EXPECT_EQ(recovered.get_order(pending_id).price, Price::from_int(300));
+    EXPECT_EQ(recovered.get_order(pending_id).pending_price, Price::from_int(290));
+}
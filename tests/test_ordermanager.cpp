@@ -1,5 +1,7 @@
 #include <gtest/gtest.h>
 #include "OrderManager.hpp"
+#include "OrderLifecycle.hpp"
+#include <algorithm>
 
 // Use the namespace to avoid typing TradingEngine:: everywhere
 using namespace TradingEngine;
@@ -16,8 +18,8 @@ TEST_F(OrderManagerTest, HandlesSingleFullBuyOrder) {
     Order buy_order;
     buy_order.symbol = "AAPL";
     buy_order.side = Side::BUY;
-    buy_order.quantity = 100;
-    buy_order.price = 150.0;
+    buy_order.quantity = Quantity::from_int(100);
+    buy_order.price = Price::from_int(150);
     buy_order.order_type = OrderType::LIMIT;
 
     // 2. Add it to the OrderManager
@@ -29,19 +31,19 @@ TEST_F(OrderManagerTest, HandlesSingleFullBuyOrder) {
     report.order_id = order_id;
     report.symbol = "AAPL";
     report.new_status = OrderStatus::FILLED;
-    report.fill_quantity = 100;
-    report.fill_price = 149.95;
+    report.fill_quantity = Quantity::from_int(100);
+    report.fill_price = Price::from_double(149.95);
 
     // 4. Update the OrderManager with the report
     om.update_order_status(report);
 
     // 5. Assert the final state is correct
-    ASSERT_EQ(om.get_position("AAPL"), 100.0);
+    ASSERT_EQ(om.get_position("AAPL"), Quantity::from_int(100));
     
     Order final_order_state = om.get_order(order_id);
     ASSERT_EQ(final_order_state.status, OrderStatus::FILLED);
-    ASSERT_EQ(final_order_state.filled_quantity, 100.0);
-    ASSERT_DOUBLE_EQ(final_order_state.avg_fill_price, 149.95);
+    ASSERT_EQ(final_order_state.filled_quantity, Quantity::from_int(100));
+    ASSERT_EQ(final_order_state.avg_fill_price, Price::from_double(149.95));
 }
 
 // Test case for partial fills
@@ -49,37 +51,348 @@ TEST_F(OrderManagerTest, HandlesPartialFills) {
     Order buy_order;
     buy_order.symbol = "MSFT";
     buy_order.side = Side::BUY;
-    buy_order.quantity = 200;
+    buy_order.quantity = Quantity::from_int(200);
     uint64_t order_id = om.add_new_order(buy_order);
 
     // First partial fill
     ExecutionReport report1;
     report1.order_id = order_id;
     report1.new_status = OrderStatus::PARTIALLY_FILLED;
-    report1.fill_quantity = 50;
-    report1.fill_price = 300.0;
+    report1.fill_quantity = Quantity::from_int(50);
+    report1.fill_price = Price::from_int(300);
     om.update_order_status(report1);
 
     // Assert state after first fill
-    ASSERT_EQ(om.get_position("MSFT"), 50.0);
+    ASSERT_EQ(om.get_position("MSFT"), Quantity::from_int(50));
     Order order_state1 = om.get_order(order_id);
     ASSERT_EQ(order_state1.status, OrderStatus::PARTIALLY_FILLED);
-    ASSERT_EQ(order_state1.filled_quantity, 50.0);
-    ASSERT_DOUBLE_EQ(order_state1.avg_fill_price, 300.0);
+    ASSERT_EQ(order_state1.filled_quantity, Quantity::from_int(50));
+    ASSERT_EQ(order_state1.avg_fill_price, Price::from_int(300));
 
     // Second partial fill
     ExecutionReport report2;
     report2.order_id = order_id;
     report2.new_status = OrderStatus::FILLED; // Now it's fully filled
-    report2.fill_quantity = 150;
-    report2.fill_price = 301.0;
+    report2.fill_quantity = Quantity::from_int(150);
+    report2.fill_price = Price::from_int(301);
     om.update_order_status(report2);
 
     // Assert final state
-    ASSERT_EQ(om.get_position("MSFT"), 200.0);
+    ASSERT_EQ(om.get_position("MSFT"), Quantity::from_int(200));
     Order final_order_state = om.get_order(order_id);
     ASSERT_EQ(final_order_state.status, OrderStatus::FILLED);
-    ASSERT_EQ(final_order_state.filled_quantity, 200.0);
+    ASSERT_EQ(final_order_state.filled_quantity, Quantity::from_int(200));
     // Expected avg price: (50 * 300 + 150 * 301) / 200 = 300.75
-    ASSERT_DOUBLE_EQ(final_order_state.avg_fill_price, 300.75);
+    ASSERT_EQ(final_order_state.avg_fill_price, Price::from_double(300.75));
+}
+
+// Reconciliation after a reconnect: fills and cancels missed while disconnected
+TEST_F(OrderManagerTest, ReconcilesAgainstBrokerSnapshot) {
+    Order filled_while_down;
+    filled_while_down.symbol = "AAPL";
+    filled_while_down.side = Side::BUY;
+    filled_while_down.quantity = Quantity::from_int(100);
+    uint64_t filled_id = om.add_new_order(filled_while_down);
+
+    Order still_working;
+    still_working.symbol = "MSFT";
+    still_working.side = Side::SELL;
+    still_working.quantity = Quantity::from_int(10);
+    uint64_t working_id = om.add_new_order(still_working);
+
+    Order never_arrived;
+    never_arrived.symbol = "GOOG";
+    never_arrived.quantity = Quantity::from_int(5);
+    uint64_t lost_id = om.add_new_order(never_arrived);
+
+    BrokerSnapshot snapshot;
+    BrokerExecution execution;
+    execution.exec_id = "0001";
+    execution.order_id = filled_id;
+    execution.symbol = "AAPL";
+    execution.quantity = Quantity::from_int(100);
+    execution.price = Price::from_double(150.25);
+    snapshot.executions.push_back(execution);
+    BrokerOrder working;
+    working.order_id = working_id;
+    working.symbol = "MSFT";
+    working.quantity = Quantity::from_int(10);
+    snapshot.open_orders.push_back(working);
+    snapshot.positions["AAPL"] = Quantity::from_int(100);
+    // Its placeOrder was dropped while the gateway was down.
+    snapshot.unsent_orders.push_back(lost_id);
+
+    std::vector<uint64_t> closed;
+    EXPECT_EQ(om.reconcile(snapshot, &closed), 4u);
+    std::sort(closed.begin(), closed.end());
+    EXPECT_EQ(closed, (std::vector<uint64_t>{filled_id, lost_id}));
+
+    Order filled = om.get_order(filled_id);
+    EXPECT_EQ(filled.status, OrderStatus::FILLED);
+    EXPECT_EQ(filled.filled_quantity, Quantity::from_int(100));
+    EXPECT_EQ(filled.avg_fill_price, Price::from_double(150.25));
+    EXPECT_EQ(om.get_order(working_id).status, OrderStatus::CONFIRMED);
+    EXPECT_EQ(om.get_order(lost_id).status, OrderStatus::CANCELED);
+    EXPECT_EQ(om.get_position("AAPL"), Quantity::from_int(100));
+
+    // Applying the same snapshot again changes nothing.
+    EXPECT_EQ(om.reconcile(snapshot), 0u);
+}
+
+// Only orders the broker knew before the snapshot was requested can be missing from it
+TEST_F(OrderManagerTest, ReconcileKeepsOrdersNewerThanTheSnapshot) {
+    auto confirm = [this](uint64_t order_id, std::chrono::system_clock::time_point at) {
+        ExecutionReport report;
+        report.order_id = order_id;
+        report.new_status = OrderStatus::CONFIRMED;
+        report.execution_timestamp = at;
+        om.update_order_status(report);
+    };
+    const auto requested_at = std::chrono::system_clock::now();
+
+    Order acknowledged_before;
+    acknowledged_before.symbol = "AAPL";
+    acknowledged_before.quantity = Quantity::from_int(10);
+    uint64_t gone_id = om.add_new_order(acknowledged_before);
+    confirm(gone_id, requested_at - std::chrono::seconds(1));
+
+    Order acknowledged_after;
+    acknowledged_after.symbol = "AAPL";
+    acknowledged_after.quantity = Quantity::from_int(10);
+    uint64_t late_id = om.add_new_order(acknowledged_after);
+    confirm(late_id, requested_at + std::chrono::seconds(1));
+
+    // Still waiting on the journal or the outbound queue.
+    Order not_yet_sent;
+    not_yet_sent.symbol = "AAPL";
+    not_yet_sent.quantity = Quantity::from_int(10);
+    uint64_t queued_id = om.add_new_order(not_yet_sent);
+
+    BrokerSnapshot snapshot;
+    snapshot.requested_at = requested_at;
+    EXPECT_EQ(om.reconcile(snapshot), 1u);
+    EXPECT_EQ(om.get_order(gone_id).status, OrderStatus::CANCELED);
+    EXPECT_EQ(om.get_order(late_id).status, OrderStatus::CONFIRMED);
+    EXPECT_EQ(om.get_order(queued_id).status, OrderStatus::NEW);
+}
+
+// A cancel in flight is not undone just because the order is still working
+TEST_F(OrderManagerTest, ReconcileKeepsPendingCancel) {
+    Order order;
+    order.symbol = "MSFT";
+    order.quantity = Quantity::from_int(10);
+    uint64_t order_id = om.add_new_order(order);
+    ExecutionReport confirmed;
+    confirmed.order_id = order_id;
+    confirmed.new_status = OrderStatus::CONFIRMED;
+    om.update_order_status(confirmed);
+    ASSERT_TRUE(om.request_cancel(order_id));
+
+    BrokerSnapshot snapshot;
+    snapshot.requested_at = std::chrono::system_clock::now();
+    BrokerOrder working;
+    working.order_id = order_id;
+    working.symbol = "MSFT";
+    working.quantity = Quantity::from_int(10);
+    snapshot.open_orders.push_back(working);
+    EXPECT_EQ(om.reconcile(snapshot), 0u);
+    EXPECT_EQ(om.get_order(order_id).status, OrderStatus::PENDING_CANCEL);
+}
+
+// Fills come from executions; a replayed execution ID must not move the position twice
+TEST_F(OrderManagerTest, DeduplicatesFillsByExecutionId) {
+    Order sell_order;
+    sell_order.symbol = "AAPL";
+    sell_order.side = Side::SELL;
+    sell_order.quantity = Quantity::from_int(100);
+    uint64_t order_id = om.add_new_order(sell_order);
+
+    ExecutionReport fill;
+    fill.type = ReportType::FILL;
+    fill.order_id = order_id;
+    fill.exec_id = "0000e0d5.01";
+    fill.fill_quantity = Quantity::from_int(40);
+    fill.fill_price = Price::from_int(150);
+    om.update_order_status(fill);
+    om.update_order_status(fill);
+
+    EXPECT_EQ(om.get_position("AAPL"), Quantity::from_int(-40));
+    EXPECT_EQ(om.get_order(order_id).status, OrderStatus::PARTIALLY_FILLED);
+
+    // A late "Submitted" must not move a partially filled order backwards.
+    ExecutionReport submitted;
+    submitted.order_id = order_id;
+    ASSERT_TRUE(order_status_from_ibkr("Submitted", submitted.new_status));
+    om.update_order_status(submitted);
+    EXPECT_EQ(om.get_order(order_id).status, OrderStatus::PARTIALLY_FILLED);
+
+    fill.exec_id = "0000e0d5.02";
+    fill.fill_quantity = Quantity::from_int(60);
+    om.update_order_status(fill);
+    EXPECT_EQ(om.get_order(order_id).status, OrderStatus::FILLED);
+    EXPECT_EQ(om.get_position("AAPL"), Quantity::from_int(-100));
+    EXPECT_EQ(om.open_order_count(), 0u);
+}
+
+TEST_F(OrderManagerTest, CancelAndModifyFollowTheLifecycle) {
+    Order order;
+    order.symbol = "MSFT";
+    order.order_type = OrderType::LIMIT;
+    order.quantity = Quantity::from_int(10);
+    order.price = Price::from_int(300);
+    uint64_t order_id = om.add_new_order(order);
+
+    EXPECT_TRUE(om.request_modify(order_id, Quantity::from_int(20), Price::from_double(299.5)));
+    // Pending until the broker takes it.
+    EXPECT_EQ(om.get_order(order_id).quantity, Quantity::from_int(10));
+    EXPECT_EQ(om.get_order(order_id).pending_quantity, Quantity::from_int(20));
+    ExecutionReport modified;
+    modified.type = ReportType::MODIFIED;
+    modified.order_id = order_id;
+    modified.order_quantity = Quantity::from_int(20);
+    modified.order_price = Price::from_double(299.5);
+    EXPECT_TRUE(om.update_order_status(modified));
+    EXPECT_EQ(om.get_order(order_id).quantity, Quantity::from_int(20));
+    EXPECT_EQ(om.get_order(order_id).price, Price::from_double(299.5));
+    EXPECT_FALSE(om.get_order(order_id).pending_quantity);
+    EXPECT_FALSE(om.get_order(order_id).pending_price);
+
+    EXPECT_TRUE(om.request_cancel(order_id));
+    EXPECT_FALSE(om.request_cancel(order_id));
+    EXPECT_FALSE(om.request_modify(order_id, Quantity::from_int(30), std::nullopt));
+    EXPECT_EQ(om.get_order(order_id).status, OrderStatus::PENDING_CANCEL);
+
+    ExecutionReport rejected;
+    rejected.type = ReportType::CANCEL_REJECTED;
+    rejected.order_id = order_id;
+    om.update_order_status(rejected);
+    EXPECT_EQ(om.get_order(order_id).status, OrderStatus::CONFIRMED);
+
+    EXPECT_TRUE(om.request_cancel(order_id));
+    ExecutionReport cancelled;
+    cancelled.order_id = order_id;
+    cancelled.new_status = OrderStatus::CANCELED;
+    om.update_order_status(cancelled);
+    EXPECT_EQ(om.get_order(order_id).status, OrderStatus::CANCELED);
+    EXPECT_FALSE(om.request_cancel(order_id));
+    EXPECT_EQ(om.open_order_count("MSFT"), 0u);
+}
+
+TEST_F(OrderManagerTest, MassCancelsBySymbolAndStrategy) {
+    auto add = [this](const std::string& symbol, const std::string& strategy) {
+        Order order;
+        order.symbol = symbol;
+        order.strategy_id = strategy;
+        order.quantity = Quantity::from_int(1);
+        return om.add_new_order(order);
+    };
+    uint64_t aapl_a = add("AAPL", "alpha");
+    uint64_t aapl_b = add("AAPL", "beta");
+    uint64_t msft_a = add("MSFT", "alpha");
+    uint64_t goog = add("GOOG", "");
+
+    EXPECT_EQ(om.request_mass_cancel("AAPL", "alpha"), std::vector<uint64_t>{aapl_a});
+    EXPECT_EQ(om.request_mass_cancel("", "alpha"), std::vector<uint64_t>{msft_a});
+    EXPECT_TRUE(om.request_mass_cancel("TSLA", "").empty());
+    EXPECT_EQ(om.request_mass_cancel("", ""), (std::vector<uint64_t>{aapl_b, goog}));
+    EXPECT_TRUE(om.request_mass_cancel("", "").empty());
+    EXPECT_EQ(om.open_order_count(), 4u);
+}
+
+// Two strategies trading the same symbol keep separate positions and P&L
+TEST_F(OrderManagerTest, TracksPositionsAndPnlPerStrategy) {
+    auto fill = [this](const std::string& strategy, Side side, int quantity, double price) {
+        Order order;
+        order.symbol = "AAPL";
+        order.strategy_id = strategy;
+        order.side = side;
+        order.quantity = Quantity::from_int(quantity);
+        uint64_t order_id = om.add_new_order(order);
+        ExecutionReport report;
+        report.type = ReportType::FILL;
+        report.order_id = order_id;
+        report.exec_id = "exec." + std::to_string(order_id);
+        report.fill_quantity = Quantity::from_int(quantity);
+        report.fill_price = Price::from_double(price);
+        EXPECT_TRUE(om.update_order_status(report));
+        return order_id;
+    };
+    fill("alpha", Side::BUY, 100, 150.0);
+    fill("beta", Side::SELL, 40, 151.0);
+    fill("alpha", Side::SELL, 60, 152.5);
+    // Flip beta from short 40 to long 10.
+    fill("beta", Side::BUY, 50, 150.0);
+
+    StrategyPosition alpha = om.get_strategy_position("alpha", "AAPL");
+    EXPECT_EQ(alpha.position, Quantity::from_int(40));
+    EXPECT_EQ(alpha.avg_price, Price::from_int(150));
+    EXPECT_DOUBLE_EQ(notional_to_double(om.get_strategy_realized_pnl("alpha")), 150.0);
+
+    StrategyPosition beta = om.get_strategy_position("beta", "AAPL");
+    EXPECT_EQ(beta.position, Quantity::from_int(10));
+    EXPECT_EQ(beta.avg_price, Price::from_int(150));
+    EXPECT_DOUBLE_EQ(notional_to_double(beta.realized_pnl), 40.0);
+
+    EXPECT_EQ(om.get_position("AAPL"), Quantity::from_int(50));
+}
+
+TEST_F(OrderManagerTest, RejectedModifyKeepsTheOldTerms) {
+    Order order;
+    order.symbol = "MSFT";
+    order.order_type = OrderType::LIMIT;
+    order.quantity = Quantity::from_int(10);
+    order.price = Price::from_int(300);
+    uint64_t order_id = om.add_new_order(order);
+
+    EXPECT_TRUE(om.request_modify(order_id, Quantity::from_int(5), Price::from_int(310)));
+    ExecutionReport rejected;
+    rejected.type = ReportType::MODIFY_REJECTED;
+    rejected.order_id = order_id;
+    EXPECT_TRUE(om.update_order_status(rejected));
+
+    Order after = om.get_order(order_id);
+    EXPECT_EQ(after.quantity, Quantity::from_int(10));
+    EXPECT_EQ(after.price, Price::from_int(300));
+    EXPECT_FALSE(after.pending_quantity);
+    EXPECT_FALSE(after.pending_price);
+    EXPECT_FALSE(om.update_order_status(rejected));
+}
+
+TEST_F(OrderManagerTest, OnlyTheOwningStrategyMayCancel) {
+    Order order;
+    order.symbol = "MSFT";
+    order.strategy_id = "alpha";
+    order.quantity = Quantity::from_int(5);
+    uint64_t order_id = om.add_new_order(order);
+
+    EXPECT_FALSE(om.request_cancel(order_id, "beta"));
+    EXPECT_FALSE(om.request_modify(order_id, Quantity::from_int(10), std::nullopt, "beta"));
+    EXPECT_TRUE(om.request_cancel(order_id, "alpha"));
+
+    Order unowned;
+    unowned.symbol = "MSFT";
+    EXPECT_EQ(om.get_order(om.add_new_order(unowned)).strategy_id, kDefaultStrategyId);
+}
+
+TEST_F(OrderManagerTest, ShardsShareOneIdCounter) {
+    OrderManager shard;
+    shard.share_order_ids(om);
+    om.set_next_order_id(100);
+
+    Order first;
+    first.symbol = "AAPL";
+    Order second;
+    second.symbol = "MSFT";
+    EXPECT_EQ(om.add_new_order(first), 100u);
+    EXPECT_EQ(shard.add_new_order(second), 101u);
+
+    // Each shard only knows its own orders.
+    EXPECT_EQ(om.open_order_count(), 1u);
+    EXPECT_EQ(shard.get_order(100).order_id, 0u);
+
+    // The gateway's next valid id never moves the shared counter backwards.
+    om.set_next_order_id(50);
+    Order third;
+    third.symbol = "AAPL";
+    EXPECT_EQ(shard.add_new_order(third), 102u);
 }
@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+#include "OutboundScheduler.hpp"
+#include <string>
+#include <vector>
+
+using namespace TradingEngine;
+
+namespace {
+
+constexpr uint64_t kStart = 1'000'000'000;  // TokenBucket treats 0 as "no clock yet"
+constexpr uint64_t kSecond = 1'000'000'000;
+
+OutboundScheduler::Config small_config() {
+    OutboundScheduler::Config config;
+    config.messages_per_second = 10.0;
+    config.burst = 4.0;
+    config.low_priority_reserve = 2.0;
+    config.history_spacing = std::chrono::milliseconds(500);
+    return config;
+}
+
+}
+
+TEST(TokenBucketTest, RefillsAtConfiguredRate) {
+    TokenBucket bucket(10.0, 2.0);
+    EXPECT_TRUE(bucket.try_consume(kStart));
+    EXPECT_TRUE(bucket.try_consume(kStart));
+    EXPECT_FALSE(bucket.try_consume(kStart));
+    EXPECT_NEAR(static_cast<double>(bucket.wait_ns(kStart)), 100e6, 1e3);
+    EXPECT_TRUE(bucket.try_consume(kStart + kSecond / 10));
+}
+
+TEST(TokenBucketTest, ReserveHoldsBackTokens) {
+    TokenBucket bucket(10.0, 3.0);
+    EXPECT_TRUE(bucket.try_consume(kStart, 1.0));
+    EXPECT_TRUE(bucket.try_consume(kStart, 1.0));
+    EXPECT_FALSE(bucket.try_consume(kStart, 1.0));
+    EXPECT_TRUE(bucket.try_consume(kStart));
+}
+
+TEST(OutboundSchedulerTest, SendsHighestPriorityFirst) {
+    OutboundScheduler scheduler(small_config());
+    std::vector<std::string> sent;
+    scheduler.submit(OutboundPriority::SUBSCRIPTION, [&] { sent.push_back("sub"); });
+    scheduler.submit(OutboundPriority::NEW_ORDER, [&] { sent.push_back("order"); });
+    scheduler.submit(OutboundPriority::CANCEL, [&] { sent.push_back("cancel"); });
+
+    scheduler.dispatch_ready(kStart);
+    // The subscription would dip into the reserve, so it waits for a refill.
+    ASSERT_EQ(sent.size(), 2u);
+    scheduler.dispatch_ready(kStart + kSecond);
+    ASSERT_EQ(sent.size(), 3u);
+    EXPECT_EQ(sent[0], "cancel");
+    EXPECT_EQ(sent[1], "order");
+    EXPECT_EQ(sent[2], "sub");
+}
+
+TEST(OutboundSchedulerTest, LowPriorityLeavesReserveForOrders) {
+    OutboundScheduler scheduler(small_config());
+    int subscriptions = 0;
+    int orders = 0;
+    for (int i = 0; i < 4; ++i) {
+        scheduler.submit(OutboundPriority::SUBSCRIPTION, [&] { ++subscriptions; });
+    }
+    uint64_t wait = scheduler.dispatch_ready(kStart);
+    // Burst of 4 with 2 reserved: only two subscriptions go out.
+    EXPECT_EQ(subscriptions, 2);
+    EXPECT_GT(wait, 0u);
+    EXPECT_EQ(scheduler.pending(OutboundPriority::SUBSCRIPTION), 2u);
+
+    scheduler.submit(OutboundPriority::NEW_ORDER, [&] { ++orders; });
+    scheduler.submit(OutboundPriority::NEW_ORDER, [&] { ++orders; });
+    scheduler.dispatch_ready(kStart);
+    EXPECT_EQ(orders, 2);
+    EXPECT_EQ(subscriptions, 2);
+
+    // Refilled after a second; the remaining subscriptions drain.
+    EXPECT_EQ(scheduler.dispatch_ready(kStart + kSecond), 0u);
+    EXPECT_EQ(subscriptions, 4);
+    EXPECT_EQ(scheduler.pending(), 0u);
+}
+
+TEST(OutboundSchedulerTest, SpacesHistoryRequests) {
+    OutboundScheduler scheduler(small_config());
+    int history = 0;
+    scheduler.submit(OutboundPriority::HISTORY, [&] { ++history; });
+    scheduler.submit(OutboundPriority::HISTORY, [&] { ++history; });
+
+    uint64_t wait = scheduler.dispatch_ready(kStart);
+    EXPECT_EQ(history, 1);
+    EXPECT_EQ(wait, 500'000'000u);
+
+    scheduler.dispatch_ready(kStart + kSecond / 4);
+    EXPECT_EQ(history, 1);
+    scheduler.dispatch_ready(kStart + kSecond / 2);
+    EXPECT_EQ(history, 2);
+}
+
+TEST(OutboundSchedulerTest, RejectsSubmissionsWhileStopped) {
+    OutboundScheduler scheduler(small_config());
+    int sent = 0;
+    scheduler.start();
+    scheduler.stop();
+    EXPECT_FALSE(scheduler.submit(OutboundPriority::NEW_ORDER, [&] { ++sent; }));
+    EXPECT_EQ(scheduler.pending(), 0u);
+}
@@ -0,0 +1,62 @@
+#include <gtest/gtest.h>
+#include "ReconnectSupervisor.hpp"
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace TradingEngine;
+using namespace std::chrono_literals;
+
+TEST(ReconnectBackoffTest, DoublesUpToTheCap) {
+    ReconnectBackoff backoff(100ms, 350ms);
+    EXPECT_EQ(backoff.next_delay(), 100ms);
+    EXPECT_EQ(backoff.next_delay(), 200ms);
+    EXPECT_EQ(backoff.next_delay(), 350ms);
+    EXPECT_EQ(backoff.next_delay(), 350ms);
+    backoff.reset();
+    EXPECT_EQ(backoff.next_delay(), 100ms);
+}
+
+TEST(ReconnectSupervisorTest, RetriesUntilReconnected) {
+    std::mutex mutex;
+    std::vector<ConnectionState> states;
+    int teardowns = 0;
+    int attempts = 0;
+
+    ReconnectSupervisor::Config config;
+    config.initial_delay = 1ms;
+    config.max_delay = 4ms;
+    ReconnectSupervisor::Callbacks callbacks;
+    callbacks.teardown = [&] { std::lock_guard<std::mutex> lock(mutex); ++teardowns; };
+    callbacks.reconnect = [&](int attempt) {
+        std::lock_guard<std::mutex> lock(mutex);
+        attempts = attempt;
+        return attempt == 3;
+    };
+    callbacks.on_state = [&](const ConnectionStatus& status) {
+        std::lock_guard<std::mutex> lock(mutex);
+        states.push_back(status.state);
+    };
+
+    ReconnectSupervisor supervisor(config, std::move(callbacks));
+    supervisor.start();
+    supervisor.notify_connection_lost("test");
+    for (int i = 0; i < 200; ++i) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!states.empty() && states.back() == ConnectionState::CONNECTED) break;
+        }
+        std::this_thread::sleep_for(5ms);
+    }
+    supervisor.stop();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    EXPECT_EQ(attempts, 3);
+    // Once for the lost session, once after each failed attempt.
+    EXPECT_EQ(teardowns, 3);
+    ASSERT_EQ(states.size(), 5u);
+    EXPECT_EQ(states.front(), ConnectionState::DISCONNECTED);
+    EXPECT_EQ(states[1], ConnectionState::RECONNECTING);
+    EXPECT_EQ(states.back(), ConnectionState::CONNECTED);
+}
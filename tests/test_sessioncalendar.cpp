@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+#include "SessionCalendar.hpp"
+
+using namespace TradingEngine;
+
+namespace {
+
+constexpr int64_t kNsPerMinute = 60'000'000'000;
+
+// UTC wall time to nanoseconds since the epoch.
+int64_t utc(int year, unsigned month, unsigned day, int hour, int minute) {
+    return (static_cast<int64_t>(SessionCalendar::days_from_civil(year, month, day)) * 1440 + hour * 60 + minute) *
+           kNsPerMinute;
+}
+
+SessionCalendar nyse_calendar() {
+    SessionCalendar calendar;
+    EXPECT_TRUE(calendar.load(nlohmann::json::parse(R"({
+        "NYSE": {
+            "utc_offset_minutes": -300, "dst": "us", "open": "09:30", "close": "16:00",
+            "holidays": ["2026-11-26"],
+            "early_closes": {"2026-11-27": "13:00"},
+            "auctions": [{"name": "CLOSING_AUCTION_CUTOFF", "relative_to": "close", "offset_minutes": -10}]
+        }
+    })")));
+    return calendar;
+}
+
+}
+
+TEST(SessionCalendarTest, CivilDates) {
+    EXPECT_EQ(SessionCalendar::days_from_civil(1970, 1, 1), 0);
+    EXPECT_EQ(SessionCalendar::days_from_civil(2000, 3, 1), 11017);
+    int32_t day = 0;
+    ASSERT_TRUE(SessionCalendar::parse_date("2026-10-19", day));
+    EXPECT_EQ(day, SessionCalendar::days_from_civil(2026, 10, 19));
+    EXPECT_FALSE(SessionCalendar::parse_date("2026-13-01", day));
+    int minute = 0;
+    EXPECT_FALSE(SessionCalendar::parse_time("9:30", minute));
+}
+
+TEST(SessionCalendarTest, OpenMovesWithUsDaylightSaving) {
+    SessionCalendar calendar = nyse_calendar();
+    // DST starts Sunday 2026-03-08: the 09:30 open moves from 14:30 to 13:30 UTC.
+    auto friday = calendar.next_event("NYSE", utc(2026, 3, 6, 12, 0));
+    ASSERT_TRUE(friday);
+    EXPECT_EQ(friday->name, "OPEN");
+    EXPECT_EQ(friday->time_ns, utc(2026, 3, 6, 14, 30));
+    auto monday = calendar.next_event("NYSE", utc(2026, 3, 7, 0, 0));
+    ASSERT_TRUE(monday);
+    EXPECT_EQ(monday->time_ns, utc(2026, 3, 9, 13, 30));
+    // And back on Sunday 2026-11-01.
+    EXPECT_EQ(calendar.next_event("NYSE", utc(2026, 11, 1, 0, 0))->time_ns, utc(2026, 11, 2, 14, 30));
+
+    EXPECT_TRUE(calendar.is_open("NYSE", utc(2026, 3, 9, 13, 30)));
+    EXPECT_FALSE(calendar.is_open("NYSE", utc(2026, 3, 6, 14, 0)));
+    EXPECT_FALSE(calendar.is_open("NYSE", utc(2026, 3, 7, 15, 0)));  // Saturday
+    EXPECT_FALSE(calendar.is_open("LSE", utc(2026, 3, 9, 15, 0)));
+}
+
+TEST(SessionCalendarTest, HolidaysEarlyClosesAndAuctions) {
+    SessionCalendar calendar = nyse_calendar();
+    // Wednesday's close, then Thanksgiving is skipped.
+    auto event = calendar.next_event("NYSE", utc(2026, 11, 25, 20, 55));
+    ASSERT_TRUE(event);
+    EXPECT_EQ(event->type, SessionEventType::CLOSE);
+    EXPECT_EQ(event->time_ns, utc(2026, 11, 25, 21, 0));
+    event = calendar.next_event("NYSE", event->time_ns);
+    EXPECT_EQ(event->time_ns, utc(2026, 11, 27, 14, 30));
+
+    // Friday closes at 13:00 and the auction cutoff follows it.
+    auto friday = calendar.day_events("NYSE", SessionCalendar::days_from_civil(2026, 11, 27));
+    ASSERT_EQ(friday.size(), 3u);
+    EXPECT_EQ(friday[1].type, SessionEventType::AUCTION);
+    EXPECT_EQ(friday[1].name, "CLOSING_AUCTION_CUTOFF");
+    EXPECT_EQ(friday[1].time_ns, utc(2026, 11, 27, 17, 50));
+    EXPECT_EQ(friday[2].time_ns, utc(2026, 11, 27, 18, 0));
+    EXPECT_TRUE(calendar.day_events("NYSE", SessionCalendar::days_from_civil(2026, 11, 26)).empty());
+}
+
+TEST(SessionCalendarTest, EuRuleSwitchesOnLastSundays) {
+    ExchangeSession lse;
+    lse.name = "LSE";
+    lse.dst = DstRule::EU;
+    lse.open_minute = 8 * 60;
+    lse.close_minute = 16 * 60 + 30;
+    // Last Sundays: 2026-03-29 and 2026-10-25.
+    EXPECT_EQ(SessionCalendar::utc_offset_minutes(lse, SessionCalendar::days_from_civil(2026, 3, 27)), 0);
+    EXPECT_EQ(SessionCalendar::utc_offset_minutes(lse, SessionCalendar::days_from_civil(2026, 3, 30)), 60);
+    EXPECT_EQ(SessionCalendar::utc_offset_minutes(lse, SessionCalendar::days_from_civil(2026, 10, 23)), 60);
+    EXPECT_EQ(SessionCalendar::utc_offset_minutes(lse, SessionCalendar::days_from_civil(2026, 10, 26)), 0);
+    SessionCalendar calendar;
+    calendar.add_exchange(lse);
+    EXPECT_EQ(calendar.next_event("LSE", utc(2026, 3, 29, 12, 0))->time_ns, utc(2026, 3, 30, 7, 0));
+}
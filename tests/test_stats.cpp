@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+#include "Stats.hpp"
+
+using namespace TradingEngine;
+
+TEST(LatencyHistogramTest, SmallValuesAreExact) {
+    for (uint64_t v = 0; v < LatencyHistogram::kSubBuckets; ++v) {
+        int idx = LatencyHistogram::bucket_index(v);
+        ASSERT_EQ(LatencyHistogram::bucket_upper_bound(idx), v);
+    }
+}
+
+TEST(LatencyHistogramTest, BucketsAreMonotonicAndBounded) {
+    int last = -1;
+    for (uint64_t v = 1; v < (uint64_t{1} << 40); v = v * 3 / 2 + 1) {
+        int idx = LatencyHistogram::bucket_index(v);
+        ASSERT_GE(idx, last);
+        ASSERT_LT(idx, LatencyHistogram::kBucketCount);
+        uint64_t upper = LatencyHistogram::bucket_upper_bound(idx);
+        ASSERT_GE(upper, v);
+        // Relative error stays within one sub-bucket (1/16).
+        ASSERT_LE(static_cast<double>(upper - v), v / 16.0 + 1);
+        last = idx;
+    }
+    ASSERT_LT(LatencyHistogram::bucket_index(UINT64_MAX), LatencyHistogram::kBucketCount);
+}
+
+TEST(LatencyHistogramTest, PercentilesOfUniformDistribution) {
+    LatencyHistogram hist;
+    for (uint64_t v = 1; v <= 10000; ++v) {
+        hist.record(v * 100);
+    }
+    auto snap = hist.snapshot();
+    ASSERT_EQ(snap.count, 10000u);
+    ASSERT_EQ(snap.min, 100u);
+    ASSERT_EQ(snap.max, 1000000u);
+    ASSERT_NEAR(static_cast<double>(snap.percentile(50.0)), 500000.0, 500000.0 * 0.07);
+    ASSERT_NEAR(static_cast<double>(snap.percentile(99.0)), 990000.0, 990000.0 * 0.07);
+    ASSERT_EQ(snap.percentile(100.0), 1000000u);
+}
+
+TEST(LatencyHistogramTest, SnapshotsMerge) {
+    LatencyHistogram a, b;
+    a.record(10);
+    b.record(1000);
+    auto merged = a.snapshot();
+    merged.merge(b.snapshot());
+    ASSERT_EQ(merged.count, 2u);
+    ASSERT_EQ(merged.min, 10u);
+    ASSERT_EQ(merged.max, 1000u);
+}
+
+TEST(StatsRegistryTest, TraceIsFoldedIntoSegments) {
+    LatencyStats::set_enabled(true);
+    LatencyTrace trace;
+    for (size_t i = 0; i < kLatencyStageCount; ++i) {
+        trace.stamps[i] = 1000 + i * 100;
+    }
+    StatsRegistry::instance().record_trace(LatencyPath::TICK, trace);
+    auto snap = StatsRegistry::instance().snapshot();
+    ASSERT_EQ(snap["latency_ns"]["tick"]["total"]["count"].get<uint64_t>(), 1u);
+    ASSERT_EQ(snap["latency_ns"]["tick"]["total"]["max"].get<uint64_t>(), 500u);
+    ASSERT_EQ(snap["latency_ns"]["tick"]["enqueue_to_dequeue"]["max"].get<uint64_t>(), 100u);
+}
@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+#include "StrategyHost.hpp"
+#include <vector>
+
+using namespace TradingEngine;
+
+namespace {
+
+// Stands in for the engine: accepts every order and fills it on request.
+class FakeContext : public StrategyContext {
+public:
+    explicit FakeContext(std::string id) : m_id(std::move(id)) {}
+    const std::string& strategy_id() const override { return m_id; }
+    uint64_t submit_order(Order order) override {
+        order.strategy_id = m_id;
+        order.order_id = next_id++;
+        orders.push_back(order);
+        return order.order_id;
+    }
+    bool cancel_order(uint64_t) override { return true; }
+    Quantity position(const std::string&) const override { return held; }
+
+    std::vector<Order> orders;
+    Quantity held;
+    uint64_t next_id = 1;
+
+private:
+    std::string m_id;
+};
+
+StrategyPluginConfig momentum(const std::string& id) {
+    StrategyPluginConfig config;
+    config.id = id;
+    config.library = EXAMPLE_PLUGIN_PATH;
+    config.symbols = {"PLUG"};
+    config.params = R"({"window": 2, "quantity": 10, "threshold_bps": 0})";
+    return config;
+}
+
+Tick tick(double price) {
+    Tick t;
+    t.symbol = "PLUG";
+    t.price = Price::from_double(price);
+    return t;
+}
+
+}
+
+TEST(StrategyHostTest, RoutesTicksAndFillsToThePlugin) {
+    StrategyHost host;
+    auto context = std::make_unique<FakeContext>("momentum");
+    FakeContext& engine = *context;
+    ASSERT_TRUE(host.load(momentum("momentum"), std::move(context)));
+    host.start();
+
+    host.on_tick(tick(100.0));
+    host.on_tick(tick(100.0));
+    host.on_tick(tick(101.0));  // above the 2-tick average: buy
+    ASSERT_EQ(engine.orders.size(), 1u);
+    EXPECT_EQ(engine.orders[0].side, Side::BUY);
+    EXPECT_EQ(engine.orders[0].quantity, Quantity::from_int(10));
+    EXPECT_EQ(engine.orders[0].strategy_id, "momentum");
+
+    host.on_tick(tick(102.0));  // still working: no second order
+    EXPECT_EQ(engine.orders.size(), 1u);
+
+    Order filled = engine.orders[0];
+    filled.status = OrderStatus::FILLED;
+    host.on_order_update(filled, ExecutionReport{});
+    engine.held = Quantity::from_int(10);
+    host.on_tick(tick(99.0));  // below the average while long: flatten
+    ASSERT_EQ(engine.orders.size(), 2u);
+    EXPECT_EQ(engine.orders[1].side, Side::SELL);
+
+    Tick other = tick(150.0);
+    other.symbol = "OTHER";
+    host.on_tick(other);
+    EXPECT_EQ(engine.orders.size(), 2u);
+    host.stop();
+}
+
+TEST(StrategyHostTest, RefusesBadPlugins) {
+    StrategyHost host;
+    StrategyPluginConfig missing = momentum("missing");
+    missing.library = "/nonexistent/libnothing.so";
+    EXPECT_FALSE(host.load(missing, std::make_unique<FakeContext>("missing")));
+    EXPECT_FALSE(host.load(momentum("bad.id"), std::make_unique<FakeContext>("bad.id")));
+
+    ASSERT_TRUE(host.load(momentum("first"), std::make_unique<FakeContext>("first")));
+    EXPECT_FALSE(host.load(momentum("first"), std::make_unique<FakeContext>("first")));
+    EXPECT_EQ(host.size(), 1u);
+    EXPECT_EQ(host.symbols(), std::vector<std::string>{"PLUG"});
+}
+
+TEST(StrategyHostTest, DisablesAPluginThatThrows) {
+    StrategyHost host;
+    StrategyPluginConfig throwing;
+    throwing.id = "throwing";
+    throwing.library = THROWING_PLUGIN_PATH;
+    throwing.symbols = {"PLUG"};
+    auto throwing_context = std::make_unique<FakeContext>("throwing");
+    FakeContext& throwing_engine = *throwing_context;
+    ASSERT_TRUE(host.load(throwing, std::move(throwing_context)));
+    auto context = std::make_unique<FakeContext>("momentum");
+    FakeContext& engine = *context;
+    ASSERT_TRUE(host.load(momentum("momentum"), std::move(context)));
+    host.start();
+
+    host.on_tick(tick(50.0));
+    EXPECT_EQ(throwing_engine.orders.size(), 1u);
+    EXPECT_TRUE(host.enabled("throwing"));
+
+    host.on_tick(tick(100.0));  // throws: caught, and the plugin is switched off
+    EXPECT_EQ(throwing_engine.orders.size(), 2u);
+    EXPECT_FALSE(host.enabled("throwing"));
+
+    host.on_tick(tick(101.0));
+    EXPECT_EQ(throwing_engine.orders.size(), 2u);
+    // The other plugin on the same symbol still gets every tick.
+    EXPECT_TRUE(host.enabled("momentum"));
+    ASSERT_EQ(engine.orders.size(), 1u);
+    EXPECT_EQ(engine.orders[0].side, Side::BUY);
+    host.stop();
+}
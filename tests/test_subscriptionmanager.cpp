@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+#include "SubscriptionManager.hpp"
+#include <algorithm>
+
+using namespace TradingEngine;
+using Change = SubscriptionManager::Change;
+
+TEST(SubscriptionManagerTest, SharesOneStreamBetweenSubscribers) {
+    SubscriptionManager subs;
+    EXPECT_EQ(subs.subscribe("AAPL", "TICK", "alpha"), Change::FIRST_SUBSCRIBER);
+    EXPECT_EQ(subs.subscribe("AAPL", "TICK", "beta"), Change::NONE);
+    // A named subscriber holds one reference no matter how often it asks.
+    EXPECT_EQ(subs.subscribe("AAPL", "TICK", "alpha"), Change::NONE);
+    EXPECT_EQ(subs.subscriber_count("AAPL", "TICK"), 2u);
+    EXPECT_EQ(subs.lines_in_use(), 1u);
+
+    subs.bind_request("AAPL", "TICK", 2001);
+    EXPECT_EQ(subs.request_id("AAPL", "TICK"), 2001);
+
+    EXPECT_EQ(subs.unsubscribe("AAPL", "TICK", "alpha"), Change::NONE);
+    EXPECT_EQ(subs.unsubscribe("AAPL", "TICK", "alpha"), Change::NOT_SUBSCRIBED);
+    EXPECT_EQ(subs.unsubscribe("AAPL", "TICK", "beta"), Change::LAST_UNSUBSCRIBED);
+    EXPECT_EQ(subs.lines_in_use(), 0u);
+    EXPECT_EQ(subs.request_id("AAPL", "TICK"), SubscriptionManager::kNoRequest);
+}
+
+TEST(SubscriptionManagerTest, AnonymousSubscribersCountEachRequest) {
+    SubscriptionManager subs;
+    EXPECT_EQ(subs.subscribe("MSFT", "TICK", ""), Change::FIRST_SUBSCRIBER);
+    EXPECT_EQ(subs.subscribe("MSFT", "TICK", ""), Change::NONE);
+    EXPECT_EQ(subs.unsubscribe("MSFT", "TICK", ""), Change::NONE);
+    EXPECT_EQ(subs.unsubscribe("MSFT", "TICK", ""), Change::LAST_UNSUBSCRIBED);
+}
+
+TEST(SubscriptionManagerTest, EnforcesLineLimitPerStream) {
+    SubscriptionManager subs(2);
+    EXPECT_EQ(subs.subscribe("AAPL", "TICK", "a"), Change::FIRST_SUBSCRIBER);
+    EXPECT_EQ(subs.subscribe("MSFT", "TICK", "a"), Change::FIRST_SUBSCRIBER);
+    EXPECT_EQ(subs.subscribe("GOOG", "TICK", "a"), Change::LINE_LIMIT_REACHED);
+    // Joining an existing stream does not need a new line.
+    EXPECT_EQ(subs.subscribe("AAPL", "TICK", "b"), Change::NONE);
+    EXPECT_EQ(subs.unsubscribe("MSFT", "TICK", "a"), Change::LAST_UNSUBSCRIBED);
+    EXPECT_EQ(subs.subscribe("GOOG", "TICK", "a"), Change::FIRST_SUBSCRIBER);
+    EXPECT_EQ(subs.active_streams().size(), 2u);
+}
+
+TEST(SubscriptionManagerTest, DroppedStreamFreesItsLineForTheNextSubscribe) {
+    SubscriptionManager subs(1);
+    EXPECT_EQ(subs.subscribe("XYZ", "TICK", "alpha"), Change::FIRST_SUBSCRIBER);
+    EXPECT_EQ(subs.subscribe("XYZ", "TICK", "beta"), Change::NONE);
+
+    // The contract lookup failed before the stream was opened.
+    auto subscribers = subs.drop_stream("XYZ", "TICK");
+    std::sort(subscribers.begin(), subscribers.end());
+    EXPECT_EQ(subscribers, (std::vector<std::string>{"alpha", "beta"}));
+    EXPECT_EQ(subs.lines_in_use(), 0u);
+    EXPECT_EQ(subs.subscriber_count("XYZ", "TICK"), 0u);
+    EXPECT_TRUE(subs.drop_stream("XYZ", "TICK").empty());
+
+    // Subscribing again opens the stream rather than joining a dead one.
+    EXPECT_EQ(subs.subscribe("XYZ", "TICK", "alpha"), Change::FIRST_SUBSCRIBER);
+    EXPECT_EQ(subs.unsubscribe("XYZ", "TICK", "beta"), Change::NOT_SUBSCRIBED);
+    EXPECT_EQ(subs.unsubscribe("XYZ", "TICK", "alpha"), Change::LAST_UNSUBSCRIBED);
+}
@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+#include "TimerWheel.hpp"
+#include <vector>
+
+using namespace TradingEngine;
+
+namespace {
+
+constexpr uint64_t kMs = 1'000'000;
+constexpr uint64_t kStart = 1'700'000'000'000 * kMs;  // an arbitrary epoch-ms
+
+}
+
+TEST(TimerWheelTest, FiresInDeadlineOrderAndNeverEarly) {
+    TimerWheel wheel(kStart);
+    std::vector<int> fired;
+    wheel.schedule_at(kStart + 30 * kMs, [&fired](TimerId) { fired.push_back(30); });
+    wheel.schedule_at(kStart + 5 * kMs + 1, [&fired](TimerId) { fired.push_back(5); });
+    wheel.schedule_at(kStart + 300 * kMs, [&fired](TimerId) { fired.push_back(300); });
+
+    EXPECT_EQ(wheel.advance(kStart + 5 * kMs), 0u);  // 5 ms + 1 ns is not due yet
+    EXPECT_EQ(wheel.advance(kStart + 6 * kMs), 1u);
+    EXPECT_EQ(wheel.advance(kStart + 299 * kMs), 1u);
+    EXPECT_EQ(wheel.advance(kStart + 300 * kMs), 1u);
+    EXPECT_EQ(fired, (std::vector<int>{5, 30, 300}));
+    EXPECT_EQ(wheel.size(), 0u);
+}
+
+TEST(TimerWheelTest, CancelAndStaleIds) {
+    TimerWheel wheel(kStart);
+    int fired = 0;
+    TimerId a = wheel.schedule_at(kStart + 10 * kMs, [&fired](TimerId) { ++fired; });
+    TimerId b = wheel.schedule_at(kStart + 10 * kMs, [&fired](TimerId) { ++fired; });
+    EXPECT_TRUE(wheel.cancel(a));
+    EXPECT_FALSE(wheel.cancel(a));
+    wheel.advance(kStart + 10 * kMs);
+    EXPECT_EQ(fired, 1);
+    EXPECT_FALSE(wheel.cancel(b));  // already fired
+
+    // A reused node does not answer to the old id.
+    TimerId c = wheel.schedule_at(kStart + 20 * kMs, [](TimerId) {});
+    EXPECT_NE(c, a);
+    EXPECT_FALSE(wheel.cancel(a));
+    EXPECT_TRUE(wheel.cancel(c));
+}
+
+TEST(TimerWheelTest, PeriodicTimerRepeatsUntilCancelledFromItsCallback) {
+    TimerWheel wheel(kStart);
+    int fired = 0;
+    TimerId id = wheel.schedule_at(kStart + 10 * kMs, [&](TimerId self) {
+        if (++fired == 3) {
+            wheel.cancel(self);
+        }
+    }, 10 * kMs);
+    EXPECT_NE(id, kInvalidTimerId);
+    for (uint64_t ms = 1; ms <= 100; ++ms) {
+        wheel.advance(kStart + ms * kMs);
+        if (ms == 20) {
+            EXPECT_EQ(fired, 2);
+        }
+    }
+    EXPECT_EQ(fired, 3);
+    EXPECT_EQ(wheel.size(), 0u);
+}
+
+TEST(TimerWheelTest, FarTimersCascadeToTheExactTick) {
+    TimerWheel wheel(kStart);
+    std::vector<uint64_t> fired_at;
+    uint64_t now = kStart;
+    const std::vector<uint64_t> delays_ms = {255, 256, 257, 65'535, 65'536, 70'000, 20'000'000};
+    for (uint64_t delay : delays_ms) {
+        wheel.schedule_at(kStart + delay * kMs, [&fired_at, &now](TimerId) { fired_at.push_back(now); });
+    }
+    // Beyond the top level (~49 days): parked and re-cascaded.
+    wheel.schedule_at(kStart + 60ull * 86'400'000 * kMs, [&fired_at, &now](TimerId) { fired_at.push_back(now); });
+    for (uint64_t delay : delays_ms) {
+        now = kStart + delay * kMs - 1;
+        wheel.advance(now);
+        now = kStart + delay * kMs;
+        wheel.advance(now);
+    }
+    std::vector<uint64_t> expected;
+    for (uint64_t delay : delays_ms) {
+        expected.push_back(kStart + delay * kMs);
+    }
+    EXPECT_EQ(fired_at, expected);
+
+    now = kStart + 60ull * 86'400'000 * kMs - 1;
+    wheel.advance(now);
+    EXPECT_EQ(fired_at.size(), delays_ms.size());
+    now += 1;
+    wheel.advance(now);
+    EXPECT_EQ(fired_at.size(), delays_ms.size() + 1);
+}
+
+TEST(TimerWheelTest, NsUntilNextBoundsTheWait) {
+    TimerWheel wheel(kStart);
+    EXPECT_EQ(wheel.ns_until_next(kStart), UINT64_MAX);
+    wheel.schedule_at(kStart + 7 * kMs, [](TimerId) {});
+    EXPECT_EQ(wheel.ns_until_next(kStart), 7 * kMs);
+    TimerWheel far(kStart);
+    far.schedule_at(kStart + 10'000 * kMs, [](TimerId) {});
+    // At most the timer itself; possibly an earlier cascade that refiles it.
+    uint64_t wait = far.ns_until_next(kStart);
+    EXPECT_GT(wait, 0u);
+    EXPECT_LE(wait, 10'000 * kMs);
+}
+
+TEST(TimerWheelTest, PeriodicTimerCatchesUpOnceAfterAStall) {
+    TimerWheel wheel(kStart);
+    int fired = 0;
+    wheel.schedule_at(kStart + 1 * kMs, [&fired](TimerId) { ++fired; }, 1 * kMs);
+    EXPECT_EQ(wheel.advance(kStart + 1 * kMs), 1u);
+
+    // The loop stalls for 10 s: one catch-up firing, not 10000.
+    EXPECT_EQ(wheel.advance(kStart + 10'001 * kMs), 1u);
+    EXPECT_EQ(fired, 2);
+    // Then back on the 1 ms schedule.
+    EXPECT_EQ(wheel.advance(kStart + 10'001 * kMs), 0u);
+    EXPECT_EQ(wheel.advance(kStart + 10'002 * kMs), 1u);
+    EXPECT_EQ(fired, 3);
+}
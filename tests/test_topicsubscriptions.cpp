@@ -0,0 +1,55 @@
+#include <gtest/gtest.h>
+#include "TopicSubscriptions.hpp"
+#include <vector>
+
+using namespace TradingEngine;
+
+namespace {
+
+std::string subscribe(const std::string& prefix) { return std::string(1, '\x01') + prefix; }
+std::string unsubscribe(const std::string& prefix) { return std::string(1, '\x00') + prefix; }
+
+}
+
+TEST(TopicSubscriptionsTest, CountsSubscribersPerPrefix) {
+    TopicSubscriptions subscriptions;
+    std::vector<std::pair<std::string, int>> changes;
+    subscriptions.on_change([&](const std::string& prefix, int count) { changes.emplace_back(prefix, count); });
+
+    EXPECT_TRUE(subscriptions.apply(subscribe("TICK.AAPL")));
+    EXPECT_TRUE(subscriptions.apply(subscribe("TICK.AAPL")));
+    EXPECT_EQ(subscriptions.subscriber_count("TICK.AAPL"), 2);
+    EXPECT_TRUE(subscriptions.apply(unsubscribe("TICK.AAPL")));
+    EXPECT_EQ(subscriptions.subscriber_count("TICK.AAPL"), 1);
+    EXPECT_TRUE(subscriptions.apply(unsubscribe("TICK.AAPL")));
+    EXPECT_EQ(subscriptions.subscriber_count("TICK.AAPL"), 0);
+
+    EXPECT_FALSE(subscriptions.apply(unsubscribe("TICK.AAPL")));
+    EXPECT_FALSE(subscriptions.apply(""));
+    EXPECT_FALSE(subscriptions.apply("\x02TICK."));
+    std::vector<std::pair<std::string, int>> expected = {
+        {"TICK.AAPL", 1}, {"TICK.AAPL", 2}, {"TICK.AAPL", 1}, {"TICK.AAPL", 0}};
+    EXPECT_EQ(changes, expected);
+}
+
+TEST(TopicSubscriptionsTest, MatchesByPrefixAndRefreshesTheCache) {
+    TopicSubscriptions subscriptions;
+    SymbolId aapl = SymbolTable::instance().intern("AAPL");
+    SymbolId msft = SymbolTable::instance().intern("MSFT");
+    EXPECT_FALSE(subscriptions.has_subscriber(TopicFamily::TICK, aapl, "AAPL"));
+
+    subscriptions.apply(subscribe("TICK.AA"));
+    EXPECT_TRUE(subscriptions.has_subscriber(TopicFamily::TICK, aapl, "AAPL"));
+    EXPECT_TRUE(subscriptions.has_subscriber(TopicFamily::TICK, aapl, "AAPL"));  // cached
+    EXPECT_FALSE(subscriptions.has_subscriber(TopicFamily::TICK, msft, "MSFT"));
+    EXPECT_FALSE(subscriptions.has_subscriber(TopicFamily::HISTORY, aapl, "AAPL"));
+
+    subscriptions.apply(unsubscribe("TICK.AA"));
+    EXPECT_FALSE(subscriptions.has_subscriber(TopicFamily::TICK, aapl, "AAPL"));
+
+    // The empty prefix is a subscription to everything.
+    subscriptions.apply(subscribe(""));
+    EXPECT_TRUE(subscriptions.has_subscriber(TopicFamily::HISTORY, msft, "MSFT"));
+    EXPECT_TRUE(subscriptions.has_subscriber(TopicFamily::TICK, kInvalidSymbolId, "NEW"));
+    EXPECT_TRUE(subscriptions.has_subscriber("ALERT"));
+}
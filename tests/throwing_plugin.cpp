@@ -0,0 +1,35 @@
+// Test plugin for StrategyHost: sends an order for every tick, then throws
+// (std::out_of_range, as std::deque::at would) once the price reaches 100.
+
+#include "StrategyPlugin.hpp"
+#include <stdexcept>
+
+namespace {
+
+using namespace TradingEngine;
+
+class ThrowingStrategy : public Strategy {
+public:
+    explicit ThrowingStrategy(const char*) {}
+
+    void on_start(StrategyContext& context) override { m_context = &context; }
+
+    void on_tick(const Tick& tick) override {
+        Order order;
+        order.symbol = tick.symbol;
+        order.quantity = Quantity::from_int(1);
+        m_context->submit_order(order);
+        if (tick.price >= Price::from_int(100)) {
+            throw std::out_of_range("price window is empty");
+        }
+    }
+
+    void on_stop() override { throw std::logic_error("on_stop called after the plugin was disabled"); }
+
+private:
+    StrategyContext* m_context = nullptr;
+};
+
+}
+
+TE_STRATEGY_PLUGIN(ThrowingStrategy)
@@ -0,0 +1,174 @@
+// Offline formatter for the binary hot-path log written by BinaryLog.
+//
+// Usage: binlog_decode <engine.binlog>
+//
+// Prints one line per record in the same shape spdlog would have produced:
+//   [2024-05-01 14:30:00.123456789] [info] Tick Posted. Symbol: AAPL, Price: 189.5  (MockMarketDataHandler.cpp:85)
+
+#include "BinaryLog.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace TradingEngine;
+
+namespace {
+
+struct Site {
+    uint8_t level = 0;
+    uint8_t arg_count = 0;
+    std::array<BinaryArgKind, BinaryLogRecord::kMaxArgs> kinds{};
+    std::string format;
+    std::string file;
+    uint32_t line = 0;
+};
+
+template<typename T>
+bool get(std::istream& in, T& value) {
+    return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+bool get_string(std::istream& in, std::string& s) {
+    uint16_t len = 0;
+    if (!get(in, len)) return false;
+    s.resize(len);
+    return static_cast<bool>(in.read(s.data(), len));
+}
+
+std::string format_arg(BinaryArgKind kind, const BinaryLogRecord::Arg& arg) {
+    switch (kind) {
+        case BinaryArgKind::I64:
+            return std::to_string(arg.i64);
+        case BinaryArgKind::U64:
+            return std::to_string(arg.u64);
+        case BinaryArgKind::F64: {
+            char buf[32];
+            std::snprintf(buf, sizeof(buf), "%.10g", arg.f64);
+            return buf;
+        }
+        case BinaryArgKind::STR:
+            return std::string(arg.str, strnlen(arg.str, sizeof(arg.str)));
+        default:
+            return "";
+    }
+}
+
+// Replaces each "{}" with the next argument; "{{" and "}}" are literal braces.
+std::string render(const Site& site, const BinaryLogRecord& record) {
+    std::string out;
+    size_t next = 0;
+    const std::string& f = site.format;
+    for (size_t i = 0; i < f.size(); ++i) {
+        if (f[i] == '{' && i + 1 < f.size() && f[i + 1] == '{') {
+            out += '{';
+            ++i;
+        } else if (f[i] == '}' && i + 1 < f.size() && f[i + 1] == '}') {
+            out += '}';
+            ++i;
+        } else if (f[i] == '{') {
+            size_t close = f.find('}', i);
+            if (close == std::string::npos) {
+                out += f.substr(i);
+                break;
+            }
+            if (next < record.arg_count && next < BinaryLogRecord::kMaxArgs) {
+                out += format_arg(site.kinds[next], record.args[next]);
+            }
+            ++next;
+            i = close;
+        } else {
+            out += f[i];
+        }
+    }
+    return out;
+}
+
+std::string format_timestamp(uint64_t ns) {
+    std::time_t secs = static_cast<std::time_t>(ns / 1000000000ULL);
+    std::tm tm{};
+    gmtime_r(&secs, &tm);
+    char buf[64];
+    size_t n = std::strftime(buf, sizeof(buf), "%Y-%m-%d %H:%M:%S", &tm);
+    std::snprintf(buf + n, sizeof(buf) - n, ".%09llu", static_cast<unsigned long long>(ns % 1000000000ULL));
+    return buf;
+}
+
+std::string base_name(const std::string& path) {
+    size_t slash = path.find_last_of('/');
+    return slash == std::string::npos ? path : path.substr(slash + 1);
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    if (argc != 2) {
+        std::cerr << "Usage: " << argv[0] << " <binary log file>" << std::endl;
+        return 2;
+    }
+    std::ifstream in(argv[1], std::ios::binary);
+    if (!in) {
+        std::cerr << "Cannot open " << argv[1] << std::endl;
+        return 1;
+    }
+    char magic[sizeof(kBinaryLogMagic)];
+    if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, kBinaryLogMagic, sizeof(magic)) != 0) {
+        std::cerr << argv[1] << " is not a binary engine log" << std::endl;
+        return 1;
+    }
+
+    // Site definitions are flushed at most one drain after the first record that
+    // uses them, so read the whole file before formatting.
+    std::unordered_map<uint16_t, Site> sites;
+    std::vector<BinaryLogRecord> records;
+    uint64_t dropped = 0;
+    char tag = 0;
+    while (in.get(tag)) {
+        if (tag == 'S') {
+            uint16_t id = 0;
+            Site site;
+            bool ok = get(in, id) && get(in, site.level) && get(in, site.arg_count) &&
+                      static_cast<bool>(in.read(reinterpret_cast<char*>(site.kinds.data()), site.kinds.size())) &&
+                      get_string(in, site.format) && get_string(in, site.file) && get(in, site.line);
+            if (!ok) break;
+            sites[id] = std::move(site);
+        } else if (tag == 'R') {
+            BinaryLogRecord record;
+            if (!get(in, record)) break;
+            records.push_back(record);
+        } else if (tag == 'D') {
+            uint64_t n = 0;
+            if (!get(in, n)) break;
+            dropped += n;
+        } else {
+            std::cerr << "Corrupt entry tag at offset " << static_cast<long long>(in.tellg()) - 1 << std::endl;
+            return 1;
+        }
+    }
+
+    // Records from different threads are interleaved by drain order, not time.
+    std::stable_sort(records.begin(), records.end(), [](const BinaryLogRecord& a, const BinaryLogRecord& b) {
+        return a.timestamp_ns < b.timestamp_ns;
+    });
+
+    for (const auto& record : records) {
+        auto it = sites.find(record.site_id);
+        if (it == sites.end()) {
+            std::cout << "[" << format_timestamp(record.timestamp_ns) << "] <unknown site " << record.site_id << ">\n";
+            continue;
+        }
+        const Site& site = it->second;
+        auto level = spdlog::level::to_string_view(static_cast<spdlog::level::level_enum>(site.level));
+        std::cout << "[" << format_timestamp(record.timestamp_ns) << "] ["
+                  << std::string(level.data(), level.size()) << "] " << render(site, record)
+                  << "  (" << base_name(site.file) << ":" << site.line << ")\n";
+    }
+    if (dropped > 0) {
+        std::cerr << dropped << " records were dropped because a ring buffer was full" << std::endl;
+    }
+    return 0;
+}